@@ -1,174 +1,358 @@
 #include <ESP8266WiFi.h>
-#include <WiFiManager.h>
 #include <ESP8266WebServer.h>
 #include <WiFiUdp.h>
-#include <NTPClient.h>
-#include <EEPROM.h>
 #include <time.h>
 
 #include "config.h"
 #include "timezone.h"
 #include "display.h"
 #include "webserver.h"
+#include "timeformat.h"
+#include "scheduler.h"
+#include "trace.h"
+#include "metrics.h"
+#include "ntpclock.h"
+#include "wifiportal.h"
+#include "eventstream.h"
+#include "jsonwriter.h"
+#include "settingsstore.h"
+#include "settingsexchange.h"
+#include "debuglog.h"
+#include "fleetsync.h"
+#include "formparser.h"
 
 // Global objects
 WiFiUDP ntpUDP;
-NTPClient timeClient(ntpUDP, "pool.ntp.org");
+NtpClock ntpClock(ntpUDP, NTP_SERVER);
+FleetSync fleet(ntpClock);
 ESP8266WebServer server(80);
 
 TimezoneManager tzManager;
 DisplayManager displayManager;
-Settings settings;
-WebServerManager webManager(&server, &tzManager, &settings, &displayManager);
+Settings settings;         // Saved settings, edited by the web handlers
+Settings displaySettings;  // Snapshot the display loop runs on
+SettingsStore settingsStore;
+SettingsExchange settingsExchange;
+WifiPortal wifiPortal;
+EventStream events;
+Scheduler scheduler;
+WebServerManager webManager(&server, &tzManager, &settings, &settingsStore, &settingsExchange, &displayManager, &wifiPortal, &ntpClock, &fleet, &events, &scheduler);
 
-void saveSettings() {
-  settings.magic = EEPROM_MAGIC;
+// millis() at which the displayed minute rolls over
+unsigned long minuteRollover = 0;
+
+// micros() at the start of the current loop() iteration
+unsigned long loopStartMicros = 0;
+
+void loadSettings() {
+  // Defaults; the store replays whatever was saved over them
+  settings.intensity = 5;
+  settings.use12Hour = 0;
+  settings.debugEnabled = 0;
+  settings.timeDisplayDuration = 10; // Default 10 seconds
+  settings.layout = LAYOUT_ROTATE;
+  settings.fleetRole = FLEET_OFF;
   for (int i = 0; i < TZ_COUNT; i++) {
-    settings.enabled[i] = tzManager.tzEnabled[i] ? 1 : 0;
+    settings.enabled[i] = tzManager.isEnabled(i) ? 1 : 0;
+    settings.order[i] = i;
+    settings.dwell[i] = 0;
+  }
+  bool stored = settingsStore.begin(settings);
+  
+  if (settings.layout != LAYOUT_ZONED) {
+    settings.layout = LAYOUT_ROTATE;
+  }
+  if (settings.fleetRole > FLEET_FOLLOWER) {
+    settings.fleetRole = FLEET_OFF;
   }
-  EEPROM.put(0, settings);
-  EEPROM.commit();
+  // Merging with an empty form repairs a damaged rotation order
+  SettingsForm noChanges;
+  beginSettingsForm(noChanges);
+  mergeRotationOrder(noChanges, settings.order);
+  for (int i = 0; i < TZ_COUNT; i++) {
+    if (settings.dwell[i] > 60) settings.dwell[i] = 0;
+  }
+  if (settingsStore.getMode() == STORE_EEPROM) {
+    logEvent(LOG_STORE_FALLBACK);
+  } else if (!stored) {
+    logEvent(LOG_STORE_UNAVAILABLE);
+  }
+  settingsExchange.publish(settings);
 }
 
-void loadSettings() {
-  EEPROM.get(0, settings);
-  if (settings.magic != EEPROM_MAGIC) {
-    // Default settings
-    settings.intensity = 5;
-    settings.use12Hour = 0;
-    settings.debugEnabled = 0;
-    settings.timeDisplayDuration = 10; // Default 10 seconds
-    for (int i = 0; i < TZ_COUNT; i++) {
-      settings.enabled[i] = tzManager.tzEnabled[i] ? 1 : 0;
-    }
-    saveSettings();
-  } else {
-    // Load enabled timezones from EEPROM
-    for (int i = 0; i < TZ_COUNT; i++) {
-      tzManager.tzEnabled[i] = settings.enabled[i] != 0;
-    }
-    // Initialize defaults for new fields if they're 0 (first time loading after update)
-    if (settings.timeDisplayDuration == 0) {
-      settings.timeDisplayDuration = 10;
-    }
+// Switches the display loop to the newest saved settings. Only called where
+// no scroll is in flight, so a rotation never runs on half of a save.
+bool pickUpSettings() {
+  if (!settingsExchange.acquire(displaySettings)) return false;
+  
+  tzManager.setRotation(displaySettings);
+  displayManager.setIntensity(displaySettings.intensity);
+  displayManager.setTimeDisplayDuration(displaySettings.timeDisplayDuration * 1000UL); // Convert to milliseconds
+  fleet.setRole(displaySettings.fleetRole);
+  
+  // A format or zone change has to show before the next minute
+  minuteRollover = millis();
+  return true;
+}
+
+// Formats the current time of a timezone into buf
+void getZoneTime(int tz, char* buf, size_t size) {
+  uint64_t utcMillis = ntpClock.nowMillis();
+  time_t utc = utcMillis / 1000;
+  long offset = tzManager.getOffsetAt(tz, utc);
+  formatTime(buf, size, utc, offset, displaySettings.use12Hour ? TIME_FORMAT_12H : 0);
+  displayManager.setSecondStart(millis() - (unsigned long)(utcMillis % 1000));
+  minuteRollover = millis() + (60000 - (unsigned long)(utcMillis % 60000));
+}
+
+// Formats the current time of the displayed timezone into buf
+void getShortTime(char* buf, size_t size) {
+  getZoneTime(displayManager.getCurrentTZ(), buf, size);
+}
+
+// Refreshes the labels and times of the side-by-side layout
+void updateZones() {
+  char timeStr[TIME_FORMAT_MAX];
+  displayManager.clearZones();
+  int tz = -1;
+  int enabledCount = tzManager.getEnabledCount();
+  for (int i = 0; i < enabledCount && i < MAX_ZONE_REGIONS; i++) {
+    tz = tzManager.nextEnabledTZ(tz);
+    getZoneTime(tz, timeStr, sizeof(timeStr));
+    displayManager.addZone(tzManager.getTimezoneName(tz), timeStr);
   }
-  // Update display manager with time display duration
-  displayManager.setTimeDisplayDuration(settings.timeDisplayDuration * 1000); // Convert to milliseconds
 }
 
-String getShortTime() {
-  String full = timeClient.getFormattedTime(); // HH:MM:SS
-  String hh = full.substring(0, 2);
-  String mm = full.substring(3, 5);
-  int hour = hh.toInt();
-  int minute = mm.toInt();
-  
-  if (settings.use12Hour) {
-    bool isPM = hour >= 12;
-    hour = hour % 12;
-    if (hour == 0) hour = 12;
-    // Format with zero padding
-    String hourStr = hour < 10 ? "0" + String(hour) : String(hour);
-    String minuteStr = minute < 10 ? "0" + String(minute) : String(minute);
-    return hourStr + ":" + minuteStr + (isPM ? " PM" : " AM");
+// Queues the displayed state for /events subscribers
+void publishDisplayEvent() {
+  int tz = displayManager.getCurrentTZ();
+  char data[SSE_EVENT_SIZE];
+  JsonWriter json(data, sizeof(data));
+  json.beginObject();
+  json.field("state", displayStateName(displayManager.getState()));
+  json.field("tz", (long)tz);
+  json.field("tzName", tzManager.getTimezoneName(tz));
+  json.field("time", displayManager.getTimeString());
+  json.endObject();
+  if (!json.overflowed()) events.publish("display", data);
+}
+
+// Starts the configured layout from the first enabled timezone; timeFirst
+// skips the opening name scroll and shows that zone's time straight away
+void startDisplay(bool timeFirst) {
+  int firstTZ = tzManager.nextEnabledTZ(-1);
+  if (firstTZ >= 0) {
+    displayManager.setCurrentTZ(firstTZ);
+  }
+  
+  if (displaySettings.layout == LAYOUT_ZONED) {
+    displayManager.setState(SHOW_ZONES);
+    updateZones();
+    displayManager.renderZones();
+    return;
+  }
+  
+  int enabledCount = tzManager.getEnabledCount();
+  displayManager.setShowTimezone(enabledCount > 1);
+  if (enabledCount > 1 && !timeFirst) {
+    displayManager.setState(SHOW_TZ_SCROLL);
+    displayManager.setTimezoneName(tzManager.getTimezoneName(firstTZ)); // This will start the scroll
+  } else if (enabledCount >= 1) {
+    // Single timezone mode or fast boot - go straight to time (drawn as soon as the string is set)
+    char timeStr[TIME_FORMAT_MAX];
+    getShortTime(timeStr, sizeof(timeStr));
+    displayManager.setState(SHOW_TIME_STATIC);
+    displayManager.setTimeString(timeStr);
   } else {
-    // Already padded from getFormattedTime, but ensure it's correct
-    return hh + ":" + mm;
+    displayManager.setState(SHOW_TZ_SCROLL);
+    displayManager.setTimezoneName("");
   }
 }
 
 void setup() {
   Serial.begin(115200);
-  delay(1000);
-  
-  // Initialize EEPROM
-  EEPROM.begin(EEPROM_SIZE);
   
   // Initialize timezone manager
   tzManager.init();
   
-  // Load settings from EEPROM (this will initialize debug flag)
+  // Load settings from flash (this will initialize debug flag)
   loadSettings();
   
-  // Only log if debug is enabled
-  if (settings.debugEnabled) {
-    Serial.println("Multi-Zone Matrix Clock Starting...");
-  }
+  // Logged to RAM; written to Serial from loop() if debug is enabled
+  logEvent(LOG_BOOT);
   
   // Initialize display
   displayManager.begin(settings.intensity);
+  pickUpSettings();
   displayManager.setShowTimezone(tzManager.getEnabledCount() > 1);
+  displayManager.setListener(publishDisplayEvent);
   
-  // Connect to WiFi
-  WiFiManager wm;
-  wm.autoConnect("MultiZoneClock");
+  // Initialize NTP clock (kept on UTC, zone offsets are applied when formatting).
+  // After a reset it picks up where it left off and NTP corrects it in place.
+  ntpClock.begin();
+  bool restored = ntpClock.restore();
   
-  if (settings.debugEnabled) {
-    Serial.print("Connected! IP address: ");
-    Serial.println(WiFi.localIP());
-  }
+  // Show the time at once if it survived the reset, else start with the first timezone name
+  startDisplay(restored);
   
-  // Initialize NTP client
-  timeClient.begin();
+  // Connect to WiFi in the background; the portal comes up from loop() if needed
+  wifiPortal.begin();
   
-  // Find first enabled timezone
-  int firstTZ = tzManager.nextEnabledTZ(-1);
-  if (firstTZ >= 0) {
-    displayManager.setCurrentTZ(firstTZ);
-    long offset = tzManager.getCurrentOffset(firstTZ);
-    timeClient.setTimeOffset(offset);
-  }
+  // Poll the network and NTP clock right away
+  scheduler.setDeadline(TASK_WIFI, millis());
+  scheduler.setDeadline(TASK_NTP, millis());
+  scheduler.setDeadline(TASK_SNAPSHOT, millis() + RTC_SNAPSHOT_INTERVAL);
   
-  // Initialize web server
-  webManager.begin();
+  logEvent(restored ? LOG_RESTORED : LOG_FIRST_FRAME, displayManager.getFrameBuffer().getFirstPushMillis());
+  logEvent(LOG_SETUP_COMPLETE);
+}
+
+// Registers the display deadlines and sleeps until the earliest one
+void scheduleAndSleep() {
+  scheduler.setDeadline(TASK_DISPLAY, displayManager.getNextDeadline());
   
-  // Start with first timezone display
-  int enabledCount = tzManager.getEnabledCount();
-  if (enabledCount > 0) {
-    if (enabledCount > 1 && displayManager.shouldShowTimezone()) {
-      displayManager.setState(SHOW_TZ_SCROLL);
-      String tzName = String(tzManager.getTimezoneName(firstTZ));
-      displayManager.setTimezoneName(tzName); // This will start the scroll
-    } else {
-      // Single timezone mode - go straight to time
-      String timeStr = getShortTime();
-      displayManager.setTimeString(timeStr);
-      displayManager.setState(SHOW_TIME_STATIC);
+  // Displayed times are only reformatted when the minute rolls over
+  DisplayState state = displayManager.getState();
+  if (state == SHOW_TIME_STATIC || state == SHOW_ZONES) {
+    scheduler.setDeadline(TASK_MINUTE, minuteRollover);
+  } else {
+    scheduler.cancel(TASK_MINUTE);
+  }
+  
+  if (state == SHOW_TIME_STATIC && tzManager.getEnabledCount() > 1) {
+    // Zones without a dwell time of their own use the global one
+    unsigned long dwellSeconds = tzManager.getDwell(displayManager.getCurrentTZ());
+    if (dwellSeconds == 0) dwellSeconds = displaySettings.timeDisplayDuration;
+    unsigned long dwellEnd = displayManager.getWaitStart() + dwellSeconds * 1000;
+    // A follower moves on when the leader does; the leader tells it when
+    unsigned long leaderStep;
+    if (fleet.getLeaderStep(leaderStep)) {
+      dwellEnd = leaderStep;
     }
+    fleet.setNextStep(dwellEnd);
+    scheduler.setDeadline(TASK_DWELL, dwellEnd);
+  } else {
+    fleet.clearNextStep();
+    scheduler.cancel(TASK_DWELL);
   }
   
+  if (fleet.getRole() != FLEET_OFF) {
+    scheduler.setDeadline(TASK_FLEET, fleet.getNextDeadline());
+  } else {
+    scheduler.cancel(TASK_FLEET);
+  }
+  
+  // Debug output goes out in idle time, never more than the TX FIFO takes
   if (settings.debugEnabled) {
-    Serial.println("Setup complete!");
+    logDrain();
   }
+  
+  metricsDisplayState(displayManager.getState());
+  unsigned long busyMicros = micros() - loopStartMicros;
+  traceLoopCost(busyMicros);
+  metricsLoopCost(busyMicros);
+  scheduler.sleepUntilNextDeadline();
 }
 
 void loop() {
-  server.handleClient();
+  loopStartMicros = micros();
+  unsigned long now = millis();
   
-  // Update NTP client periodically (it's smart enough to only sync when needed)
-  static unsigned long lastNTPUpdate = 0;
-  if (millis() - lastNTPUpdate >= NTP_UPDATE_INTERVAL) {
-    timeClient.update();
-    lastNTPUpdate = millis();
+  if (scheduler.isDue(TASK_WIFI, now)) {
+    wifiPortal.process();
+    settingsStore.process();
+    // The portal needs frequent service; a connected station does not
+    scheduler.setDeadline(TASK_WIFI, now + (wifiPortal.getState() == WIFI_CONNECTED ? WIFI_IDLE_POLL_INTERVAL : WIFI_POLL_INTERVAL));
   }
   
-  // Update time offset only when timezone changes (for DST and timezone switching)
-  static int lastTZ = -1;
-  int currentTZ = displayManager.getCurrentTZ();
-  if (currentTZ != lastTZ) {
-    long currentOffset = tzManager.getCurrentOffset(currentTZ);
-    timeClient.setTimeOffset(currentOffset);
-    lastTZ = currentTZ;
+  // Web server starts once connected; the setup portal owns port 80 until then
+  static bool webStarted = false;
+  if (!webStarted && wifiPortal.getState() == WIFI_CONNECTED) {
+    webManager.begin();
+    webStarted = true;
+    scheduler.setDeadline(TASK_WEB, now);
+    IPAddress ip = WiFi.localIP();
+    logEvent(LOG_CONNECTED, ip[0], ip[1], ip[2], ip[3]);
+  }
+  
+  if (scheduler.isDue(TASK_WEB, now)) {
+    unsigned long handleStart = micros();
+    bool served = webManager.handleClient();
+    if (served) metricsHandleClient(micros() - handleStart);
+    events.process();
+    // Another request may be queued behind this one: look again on the next
+    // loop(), after the display has had its turn
+    scheduler.setDeadline(TASK_WEB, served ? now : now + WEB_POLL_INTERVAL);
+  }
+  
+  // Send NTP requests and pick up replies without blocking the display
+  if (scheduler.isDue(TASK_NTP, now)) {
+    ntpClock.poll();
+    scheduler.setDeadline(TASK_NTP, ntpClock.getNextDeadline());
+    
+    // A stepped clock invalidates the displayed minute
+    static unsigned long lastStepCount = 0;
+    if (ntpClock.getStepCount() != lastStepCount) {
+      lastStepCount = ntpClock.getStepCount();
+      minuteRollover = millis();
+      logEvent(LOG_NTP_STEP, lastStepCount);
+    }
+  }
+  
+  // Leader beacons out, or follower beacons in
+  if (scheduler.isDue(TASK_FLEET, now)) {
+    fleet.process();
   }
   
+  if (scheduler.isDue(TASK_SNAPSHOT, now)) {
+    ntpClock.save();
+    scheduler.setDeadline(TASK_SNAPSHOT, now + RTC_SNAPSHOT_INTERVAL);
+  }
+  
+  // A save is taken right away while a time is standing on the matrix;
+  // scrolls pick it up when they hand over to the next zone
   DisplayState state = displayManager.getState();
+  if ((state == SHOW_TIME_STATIC || state == SHOW_ZONES) && pickUpSettings()) {
+    if (state == SHOW_TIME_STATIC && !tzManager.isEnabled(displayManager.getCurrentTZ())) {
+      // The zone on screen was switched off
+      startDisplay(false);
+    }
+  }
+  
+  int currentTZ = displayManager.getCurrentTZ();
+  
+  bool displayDue = scheduler.isDue(TASK_DISPLAY, now);
+  bool minuteDue = scheduler.isDue(TASK_MINUTE, now);
+  bool dwellDue = scheduler.isDue(TASK_DWELL, now);
+  
+  // Nothing for the display state machine to do on this wakeup
+  state = displayManager.getState();
+  if (!displayDue && !minuteDue && !dwellDue) {
+    scheduleAndSleep();
+    return;
+  }
+  
+  // Switch layouts after a settings change
+  if ((displaySettings.layout == LAYOUT_ZONED) != (state == SHOW_ZONES)) {
+    startDisplay(false);
+    scheduleAndSleep();
+    return;
+  }
   
   switch (state) {
+    case SHOW_ZONES:
+      if (minuteDue) {
+        updateZones();
+      }
+      displayManager.update();
+      break;
+      
     case SHOW_TZ_SCROLL:
       displayManager.update();
       if (displayManager.getState() == SHOW_TZ_WAIT) {
         // Prepare time string
-        String timeStr = getShortTime();
+        char timeStr[TIME_FORMAT_MAX];
+        getShortTime(timeStr, sizeof(timeStr));
         displayManager.setTimeString(timeStr);
       }
       break;
@@ -184,6 +368,9 @@ void loop() {
     case SHOW_TIME_RTL:
       displayManager.update();
       if (displayManager.getState() == SHOW_TZ_SCROLL) {
+        // Between two zones, where a scrolling rotation takes a pending save
+        pickUpSettings();
+        
         // Move to next timezone
         int nextTZ = tzManager.nextEnabledTZ(currentTZ);
         displayManager.setCurrentTZ(nextTZ);
@@ -193,12 +380,12 @@ void loop() {
         displayManager.setShowTimezone(enabledCount > 1);
         
         if (displayManager.shouldShowTimezone()) {
-          String tzName = String(tzManager.getTimezoneName(nextTZ));
-          displayManager.setTimezoneName(tzName);
+          displayManager.setTimezoneName(tzManager.getTimezoneName(nextTZ));
         } else {
           // Single timezone mode - skip timezone name, go straight to time
           displayManager.setTimezoneName("");
-          String timeStr = getShortTime();
+          char timeStr[TIME_FORMAT_MAX];
+          getShortTime(timeStr, sizeof(timeStr));
           displayManager.setTimeString(timeStr);
           displayManager.setState(SHOW_TZ_WAIT);
         }
@@ -207,30 +394,23 @@ void loop() {
       
     case SHOW_TIME_STATIC: {
       displayManager.update();
-      // Update time string periodically for single timezone mode
-      int enabledCount = tzManager.getEnabledCount();
-      if (enabledCount == 1) {
-        // Single timezone mode - just update time every second
-        static unsigned long lastTimeUpdate = 0;
-        if (millis() - lastTimeUpdate >= 1000) {
-          String timeStr = getShortTime();
-          displayManager.setTimeString(timeStr);
-          displayManager.setState(SHOW_TIME_STATIC); // Reset the state to update display
-          lastTimeUpdate = millis();
-        }
-      } else if (millis() - displayManager.getWaitStart() >= (unsigned long)settings.timeDisplayDuration * 1000) {
+      if (minuteDue) {
+        // The display only redraws if the string actually changed
+        char timeStr[TIME_FORMAT_MAX];
+        getShortTime(timeStr, sizeof(timeStr));
+        displayManager.setTimeString(timeStr);
+      }
+      if (dwellDue && tzManager.getEnabledCount() > 1) {
         // Multiple timezones - move to next timezone
         int nextTZ = tzManager.nextEnabledTZ(currentTZ);
         displayManager.setCurrentTZ(nextTZ);
         
         displayManager.setState(SHOW_TZ_SCROLL);
-        String tzName = String(tzManager.getTimezoneName(nextTZ));
-        displayManager.setTimezoneName(tzName); // This will start the scroll
+        displayManager.setTimezoneName(tzManager.getTimezoneName(nextTZ)); // This will start the scroll
       }
       break;
     }
   }
   
-  // Small delay to prevent overwhelming the system
-  delay(10);
+  scheduleAndSleep();
 }
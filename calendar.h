@@ -0,0 +1,45 @@
+#ifndef CALENDAR_H
+#define CALENDAR_H
+
+#include <stdint.h>
+
+// Integer proleptic Gregorian calendar helpers (no gmtime/localtime).
+// Days are counted from 1970-01-01; based on Howard Hinnant's algorithms.
+
+inline int32_t daysFromCivil(int32_t y, uint8_t m, uint8_t d) {
+  y -= m <= 2;
+  const int32_t era = (y >= 0 ? y : y - 399) / 400;
+  const uint32_t yoe = (uint32_t)(y - era * 400);                   // [0, 399]
+  const uint32_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1; // [0, 365]
+  const uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;        // [0, 146096]
+  return era * 146097 + (int32_t)doe - 719468;
+}
+
+inline void civilFromDays(int32_t z, int32_t& y, uint8_t& m, uint8_t& d) {
+  z += 719468;
+  const int32_t era = (z >= 0 ? z : z - 146096) / 146097;
+  const uint32_t doe = (uint32_t)(z - era * 146097);
+  const uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const uint32_t mp = (5 * doy + 2) / 153;
+  d = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);
+  m = (uint8_t)(mp < 10 ? mp + 3 : mp - 9);
+  y = (int32_t)yoe + era * 400 + (m <= 2);
+}
+
+// 0 = Sunday ... 6 = Saturday
+inline uint8_t weekdayFromDays(int32_t z) {
+  return (uint8_t)(z >= -4 ? (z + 4) % 7 : (z + 5) % 7 + 6);
+}
+
+// Day of month of the n-th (1-based) given weekday in a month
+inline uint8_t nthWeekdayOfMonth(int32_t y, uint8_t m, uint8_t wday, uint8_t n) {
+  uint8_t first = weekdayFromDays(daysFromCivil(y, m, 1));
+  return (uint8_t)(1 + (wday + 7 - first) % 7 + (n - 1) * 7);
+}
+
+inline int32_t floorDiv(int64_t a, int32_t b) {
+  return (int32_t)(a >= 0 ? a / b : -((-a + b - 1) / b));
+}
+
+#endif
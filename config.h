@@ -2,35 +2,121 @@
 #define CONFIG_H
 
 #include <stdint.h>
+#include "tzdb.h"
 
 // Hardware configuration
 #define HARDWARE_TYPE MD_MAX72XX::FC16_HW
-#define MAX_DEVICES 4
+#ifndef MAX_DEVICES
+#define MAX_DEVICES 4   // Chained 8x8 modules, 4 to 32
+#endif
 #define CLK_PIN   D5
 #define DATA_PIN  D7
 #define CS_PIN    D8
 
-// EEPROM configuration
+// Frame and loop-cost trace hooks for the host simulator (see trace.h)
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 0
+#endif
+
+// Loop, HTTP and display-state counters served on /metrics (see metrics.h)
+#ifndef METRICS_ENABLED
+#define METRICS_ENABLED 1
+#endif
+
+// Legacy EEPROM image, only read once to migrate into the settings store
 #define EEPROM_SIZE 64
-#define EEPROM_MAGIC 0x42
+#define EEPROM_MAGIC 0x42  // Released firmware's image; never bump, the store has its own schema
+
+// Settings journal (settingsstore.h), kept at the start of the FS flash area
+#define SETTINGS_SCHEMA_VERSION 1  // Bumped when a stored field changes meaning
+const uint8_t SETTINGS_STORE_SECTORS = 4;        // Sectors rotated for wear leveling
+const uint16_t SETTINGS_COMPACT_THRESHOLD = 3072; // Bytes used before background compaction
 
 // Display timing
 const unsigned long WAIT_DURATION = 2000;
 const unsigned long STATIC_TIME_DURATION_DEFAULT = 10000; // Default 10 seconds in ms
 const unsigned long BLINK_INTERVAL = 500; // Colon blink interval in ms
-const unsigned long NTP_UPDATE_INTERVAL = 1000; // Update NTP client every second
+const uint16_t TZ_SCROLL_INTERVAL = 50; // Frame interval of the timezone name scroll in ms
+const uint16_t TIME_SCROLL_INTERVAL = 90; // Frame interval of the time scroll in ms
+const unsigned long WEB_POLL_INTERVAL = 50; // Max latency before an HTTP request is picked up
+
+// WiFi connection and configuration portal
+#define WIFI_SETUP_AP_NAME "MultiZoneClock"   // Portal when no saved network can be joined
+#define WIFI_CONFIG_AP_NAME "ESP8266-Config"  // Portal started from the web interface
+const uint16_t WIFI_CONFIG_PORTAL_PORT = 8080;  // Keeps port 80 for the clock's own page
+const unsigned long WIFI_CONNECT_TIMEOUT = 20000; // ms before falling back to the portal
+const unsigned long WIFI_PORTAL_TIMEOUT = 180;    // Portal lifetime in seconds
+const unsigned long WIFI_POLL_INTERVAL = 20;      // ms between polls while connecting or in the portal
+const unsigned long WIFI_IDLE_POLL_INTERVAL = 1000; // ms between polls once connected
+
+// NTP synchronization (intervals in ms)
+#define NTP_SERVER "pool.ntp.org"
+const uint16_t NTP_LOCAL_PORT = 1337;
+const unsigned long NTP_MIN_POLL = 64000;        // Poll interval while the drift estimate settles
+const unsigned long NTP_MAX_POLL = 2048000;      // Poll interval once it has converged
+const unsigned long NTP_RETRY_INTERVAL = 10000;  // Retry after a failed or skipped request
+const unsigned long NTP_REPLY_TIMEOUT = 2000;    // Give up on a reply after this long
+const unsigned long NTP_REPLY_POLL = 5;          // Check for the reply this often
+const uint32_t NTP_DNS_TIMEOUT = 1000;           // Give up on a DNS answer after this long
+
+// Fast boot: the disciplined clock is snapshotted into RTC user memory, which
+// survives resets but not power loss. The first 128 bytes belong to OTA.
+const uint8_t RTC_SNAPSHOT_OFFSET = 32;             // In 4-byte blocks
+const unsigned long RTC_SNAPSHOT_INTERVAL = 1000;   // ms between snapshots
+
+// Server-Sent Events (/events)
+const uint8_t SSE_MAX_CLIENTS = 4;               // Concurrent subscribers
+const uint8_t SSE_QUEUE_SIZE = 16;               // Events kept for slow subscribers
+const size_t SSE_EVENT_SIZE = 128;               // Largest event payload
+const unsigned long SSE_KEEPALIVE_INTERVAL = 15000; // Comment line on an idle stream
+
+// Fleet time distribution (fleetsync.h): a leader clock multicasts its time
+// and rotation schedule on the LAN, followers lock to it instead of NTP
+#define FLEET_MULTICAST_GROUP IPAddress(239, 255, 77, 90)
+const uint16_t FLEET_PORT = 4677;
+const unsigned long FLEET_BEACON_INTERVAL = 2000;  // ms between leader beacons
+const unsigned long FLEET_LEADER_TIMEOUT = 10000;  // Followers fall back to NTP after this long without one
+const unsigned long FLEET_RECEIVE_GUARD = 10;      // Followers start polling this long before a beacon is due
+const unsigned long FLEET_RECEIVE_POLL = 1;        // ...and poll this often until it arrives
+const uint8_t FLEET_FILTER_SIZE = 16;               // Beacons per clock correction (least delayed wins)
+
+// Shared secret of the fleet. Beacons carry an HMAC-SHA256 over it, and
+// followers drop any beacon that fails it, so set the same key on every
+// clock of a fleet. Fleet sync stays off while the key is empty.
+#ifndef FLEET_KEY
+#define FLEET_KEY ""
+#endif
+
+// Debug log ring (debuglog.h), drained to Serial and served on /log
+const uint8_t LOG_QUEUE_SIZE = 32;               // Records kept, 24 bytes each
+const size_t LOG_LINE_SIZE = 96;                 // Longest line written to Serial
+
+// Side-by-side layout: most zones shown at once
+const uint8_t MAX_ZONE_REGIONS = 8;
+
+// Display layouts
+const uint8_t LAYOUT_ROTATE = 0; // One timezone at a time with animations
+const uint8_t LAYOUT_ZONED = 1;  // Every enabled timezone in its own column region
+
+// Fleet roles (fleetsync.h)
+const uint8_t FLEET_OFF = 0;      // Own NTP sync, own rotation
+const uint8_t FLEET_LEADER = 1;   // Serves its time and rotation schedule to the LAN
+const uint8_t FLEET_FOLLOWER = 2; // Takes time and rotation steps from the leader
 
-// Timezone count
-const int TZ_COUNT = 6; // UTC, CST, EST, PST, IRST, and one extra slot
+// Timezone count (zones compiled in by tools/gen_tzdb.py)
+const int TZ_COUNT = TZDB_ZONE_COUNT;
 
 // Settings structure
 struct Settings {
-  uint8_t magic;
   uint8_t enabled[TZ_COUNT];
   uint8_t intensity;
   uint8_t use12Hour;
   uint8_t debugEnabled;
   uint16_t timeDisplayDuration; // Duration in seconds (default 10)
+  uint8_t layout;               // LAYOUT_ROTATE or LAYOUT_ZONED
+  uint8_t fleetRole;            // FLEET_OFF, FLEET_LEADER or FLEET_FOLLOWER
+  uint8_t order[TZ_COUNT];      // Rotation order: zone indexes, enabled ones first
+  uint8_t dwell[TZ_COUNT];      // Per-zone display seconds, 0 for timeDisplayDuration
 };
 
 #endif
@@ -0,0 +1,92 @@
+#include "debuglog.h"
+
+static_assert(sizeof(LogRecord) == 24, "LogRecord layout is read by tools/decode_log.py");
+
+#define LOG_FORMAT(name, format) static const char name##_FORMAT[] PROGMEM = format;
+LOG_MESSAGES(LOG_FORMAT)
+#undef LOG_FORMAT
+
+#define LOG_FORMAT_ENTRY(name, format) name##_FORMAT,
+static const char* const LOG_FORMATS[] PROGMEM = { LOG_MESSAGES(LOG_FORMAT_ENTRY) };
+#undef LOG_FORMAT_ENTRY
+
+static LogRecord records[LOG_QUEUE_SIZE];
+static uint32_t nextSeq = 0;
+
+// Serial drain state: the next record to format and the unsent rest of
+// the line currently being written
+static uint32_t drainSeq = 0;
+static uint32_t dropped = 0;
+static char line[LOG_LINE_SIZE];
+static size_t lineLength = 0;
+static size_t lineSent = 0;
+
+void logEvent(LogMessage id, uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+  LogRecord& record = records[nextSeq % LOG_QUEUE_SIZE];
+  record.millis = millis();
+  record.id = id;
+  record.args[0] = a;
+  record.args[1] = b;
+  record.args[2] = c;
+  record.args[3] = d;
+  nextSeq++;
+}
+
+static void formatRecord(const LogRecord& record) {
+  const char* format = (const char*)pgm_read_ptr(&LOG_FORMATS[record.id]);
+  int len = snprintf(line, sizeof(line), "[%lu] ", (unsigned long)record.millis);
+  // Formats take at most LOG_MAX_ARGS arguments; extra ones are ignored
+  len += snprintf_P(line + len, sizeof(line) - len - 2, format,
+                    record.args[0], record.args[1], record.args[2], record.args[3]);
+  if (len > (int)sizeof(line) - 3) len = sizeof(line) - 3;
+  line[len++] = '\r';
+  line[len++] = '\n';
+  lineLength = len;
+  lineSent = 0;
+}
+
+void logDrain() {
+  while (true) {
+    if (lineSent == lineLength) {
+      if (drainSeq == nextSeq) return;
+      
+      // Records overwritten before they were written out are skipped
+      if (nextSeq - drainSeq > LOG_QUEUE_SIZE) {
+        dropped += nextSeq - drainSeq - LOG_QUEUE_SIZE;
+        drainSeq = nextSeq - LOG_QUEUE_SIZE;
+      }
+      formatRecord(records[drainSeq % LOG_QUEUE_SIZE]);
+      drainSeq++;
+    }
+    
+    int room = Serial.availableForWrite();
+    if (room <= 0) return;
+    size_t chunk = lineLength - lineSent;
+    if (chunk > (size_t)room) chunk = room;
+    Serial.write((const uint8_t*)line + lineSent, chunk);
+    lineSent += chunk;
+  }
+}
+
+size_t logDump(char* buf, size_t size) {
+  uint32_t first = nextSeq > LOG_QUEUE_SIZE ? nextSeq - LOG_QUEUE_SIZE : 0;
+  size_t needed = 8 + (nextSeq - first) * sizeof(LogRecord);
+  if (needed > size) return 0;
+  
+  memcpy(buf, "MZLG", 4);
+  memcpy(buf + 4, &first, 4);
+  size_t offset = 8;
+  for (uint32_t seq = first; seq != nextSeq; seq++) {
+    memcpy(buf + offset, &records[seq % LOG_QUEUE_SIZE], sizeof(LogRecord));
+    offset += sizeof(LogRecord);
+  }
+  return offset;
+}
+
+uint32_t logGetRecorded() {
+  return nextSeq;
+}
+
+uint32_t logGetDropped() {
+  return dropped;
+}
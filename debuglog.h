@@ -0,0 +1,52 @@
+#ifndef DEBUGLOG_H
+#define DEBUGLOG_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Deferred debug log. logEvent() only stores a message ID, up to four
+// arguments and millis() in a fixed RAM ring, so it costs the same on the
+// display path whether debug output is on or not. logDrain() turns records
+// into text in idle time and writes no more than the Serial TX FIFO can
+// take, so a line never stalls an animation frame. /log serves the raw
+// ring; tools/decode_log.py turns it back into text with the formats below.
+//
+// Message IDs are their position in this list: append new messages at the
+// end and never reorder, or older dumps decode with the wrong text.
+#define LOG_MESSAGES(X) \
+  X(LOG_BOOT,              "Multi-Zone Matrix Clock Starting...") \
+  X(LOG_STORE_UNAVAILABLE, "Settings store unavailable, changes will not persist") \
+  X(LOG_FIRST_FRAME,       "First frame at %lu ms") \
+  X(LOG_RESTORED,          "Clock restored from RTC memory, first frame at %lu ms") \
+  X(LOG_SETUP_COMPLETE,    "Setup complete!") \
+  X(LOG_CONNECTED,         "Connected! IP address: %u.%u.%u.%u") \
+  X(LOG_FORM_REJECTED,     "Ignored invalid settings fields: %u") \
+  X(LOG_NTP_STEP,          "Clock stepped, %lu steps so far"      ) \
+  X(LOG_FLEET_FOLLOWING,   "Following the fleet leader, NTP paused") \
+  X(LOG_FLEET_LOST,        "Fleet leader lost, back to NTP") \
+  X(LOG_STORE_FALLBACK,    "No FS flash area, settings go to EEPROM with an erase per save") \
+  X(LOG_STORE_SAVE_FAILED, "Settings save failed, %lu failures so far") \
+  X(LOG_FLEET_NO_KEY,      "Fleet sync needs FLEET_KEY in config.h, staying off")
+
+#define LOG_ENUM(name, format) name,
+enum LogMessage { LOG_MESSAGES(LOG_ENUM) LOG_MESSAGE_COUNT };
+#undef LOG_ENUM
+
+const uint8_t LOG_MAX_ARGS = 4;
+
+// Record layout as served on /log, little-endian, after an 8-byte header
+// of "MZLG" and the sequence number of the first record
+struct LogRecord {
+  uint32_t millis;
+  uint8_t id;
+  uint8_t reserved[3];
+  uint32_t args[LOG_MAX_ARGS];
+};
+
+void logEvent(LogMessage id, uint32_t a = 0, uint32_t b = 0, uint32_t c = 0, uint32_t d = 0);
+void logDrain();
+size_t logDump(char* buf, size_t size);
+uint32_t logGetRecorded();
+uint32_t logGetDropped();
+
+#endif
@@ -1,5 +1,13 @@
 #include "display.h"
 #include "config.h"
+#include "metrics.h"
+
+const char* displayStateName(DisplayState state) {
+  static const char* const STATE_NAMES[] = {
+    "tz_scroll", "tz_wait", "time_ltr", "time_rtl", "time_static", "zones"
+  };
+  return STATE_NAMES[state];
+}
 
 DisplayManager::DisplayManager() : 
   display(HARDWARE_TYPE, CS_PIN, MAX_DEVICES),
@@ -7,131 +15,231 @@ DisplayManager::DisplayManager() :
   currentTZ(0),
   waitStart(0),
   lastBlinkTime(0),
+  secondStart(0),
+  nextFrameTime(0),
+  animationInterval(TZ_SCROLL_INTERVAL),
   colonVisible(true),
   showTimezone(true),
-  timeDisplayDuration(STATIC_TIME_DURATION_DEFAULT) {
+  timeDisplayDuration(STATIC_TIME_DURATION_DEFAULT),
+  intensity(0),
+  staticStale(true),
+  zoneCount(0),
+  listener(NULL),
+  lastFrameMicros(0),
+  maxFrameMicros(0),
+  animationFrames(0),
+  lateFrames(0),
+  droppedFrames(0) {
   scrollBuffer[0] = '\0';
+  currentTimeString[0] = '\0';
 }
 
-void DisplayManager::begin(uint8_t intensity) {
+void DisplayManager::begin(uint8_t level) {
+  intensity = level;
   display.begin();
   display.setIntensity(intensity);
   display.setTextAlignment(PA_CENTER);
   display.displayClear();
+  frame.begin(display.getGraphicObject());
 }
 
-void DisplayManager::setIntensity(uint8_t intensity) {
+void DisplayManager::setIntensity(uint8_t level) {
+  if (level == intensity) return;
+  intensity = level;
   display.setIntensity(intensity);
 }
 
-String DisplayManager::formatTimeWithBlinkingColon(String timeStr) {
-  // Find the colon position and replace with space or colon based on blink state
-  int colonPos = timeStr.indexOf(':');
-  if (colonPos >= 0) {
-    String result = timeStr;
-    result.setCharAt(colonPos, colonVisible ? ':' : ' ');
-    return result;
-  }
-  return timeStr;
+void DisplayManager::pushFrame() {
+  frame.push();
+  metricsFramePush(frame.getLastRows(), frame.getLastBytes());
+}
+
+void DisplayManager::renderStaticTime() {
+  // Only the device rows that differ from the latched frame go out over SPI,
+  // so a colon blink costs a couple of rows instead of a full redraw
+  frame.drawText(currentTimeString, !colonVisible);
+  pushFrame();
+  staticStale = false;
+}
+
+void DisplayManager::syncBlink(unsigned long now) {
+  // Blinks are counted from the start of a UTC second, not from whenever the
+  // state began, so clocks that share a time source blink together
+  unsigned long sinceSecond = now - secondStart;
+  lastBlinkTime = now - sinceSecond % BLINK_INTERVAL;
+  colonVisible = sinceSecond / BLINK_INTERVAL % 2 == 0;
 }
 
 void DisplayManager::updateBlinkingColon() {
   unsigned long now = millis();
   if (now - lastBlinkTime >= BLINK_INTERVAL) {
-    colonVisible = !colonVisible;
-    lastBlinkTime = now;
+    syncBlink(now);
     
     // Update display if we're in static time mode
-    if (state == SHOW_TIME_STATIC && currentTimeString.length() > 0) {
-      String formatted = formatTimeWithBlinkingColon(currentTimeString);
-      formatted.toCharArray(scrollBuffer, sizeof(scrollBuffer));
-      display.displayClear();
-      display.print(scrollBuffer);
+    if (state == SHOW_TIME_STATIC && currentTimeString[0] != '\0') {
+      renderStaticTime();
+    } else if (state == SHOW_ZONES) {
+      renderZones();
     }
   }
 }
 
-void DisplayManager::setTimeString(String timeStr) {
-  currentTimeString = timeStr;
-  timeStr.toCharArray(scrollBuffer, sizeof(scrollBuffer));
+void DisplayManager::setCurrentTZ(int tz) {
+  if (tz == currentTZ) return;
+  currentTZ = tz;
+  notify();
+}
+
+void DisplayManager::setTimeString(const char* timeStr) {
+  bool changed = strcmp(currentTimeString, timeStr) != 0;
+  strlcpy(currentTimeString, timeStr, sizeof(currentTimeString));
+  strlcpy(scrollBuffer, timeStr, sizeof(scrollBuffer));
   
-  // If we're in static mode, update the display immediately
-  if (state == SHOW_TIME_STATIC) {
-    String formatted = formatTimeWithBlinkingColon(timeStr);
-    formatted.toCharArray(scrollBuffer, sizeof(scrollBuffer));
-    display.displayClear();
-    display.print(scrollBuffer);
-    lastBlinkTime = millis(); // Reset blink timer
+  // In static mode, draw right away if the text differs from what is shown
+  if (state == SHOW_TIME_STATIC && (changed || staticStale)) {
+    syncBlink(millis());
+    renderStaticTime();
   }
+  if (changed) notify();
 }
 
-void DisplayManager::setTimezoneName(String tzName) {
-  tzName.toCharArray(scrollBuffer, sizeof(scrollBuffer));
+void DisplayManager::setTimezoneName(const char* tzName) {
+  strlcpy(scrollBuffer, tzName, sizeof(scrollBuffer));
   // If we're in scroll state, start the vertical scroll animation
   if (state == SHOW_TZ_SCROLL) {
-    display.displayClear();
-    display.displayScroll(scrollBuffer, PA_CENTER, PA_SCROLL_UP, 50);
+    startScroll(SCROLL_UP, TZ_SCROLL_INTERVAL);
   }
 }
 
+void DisplayManager::addZone(const char* label, const char* timeStr) {
+  if (zoneCount >= MAX_ZONE_REGIONS) return;
+  strlcpy(zones[zoneCount].label, label, sizeof(zones[zoneCount].label));
+  strlcpy(zones[zoneCount].time, timeStr, sizeof(zones[zoneCount].time));
+  zoneCount++;
+}
+
+void DisplayManager::renderZones() {
+  // All regions are drawn into one frame and go out in a single diff push
+  frame.clear();
+  
+  // Regions too narrow for "label time" alternate between the two: the
+  // label for WAIT_DURATION, then the time for the rest of the period, which
+  // never leaves the time less than WAIT_DURATION either
+  unsigned long period = timeDisplayDuration > 2 * WAIT_DURATION ? timeDisplayDuration : 2 * WAIT_DURATION;
+  bool showLabel = millis() % period < WAIT_DURATION;
+  char text[TZDB_LABEL_SIZE + TIME_FORMAT_MAX];
+  for (uint8_t i = 0; i < zoneCount; i++) {
+    int16_t left = (uint32_t)MATRIX_COLUMNS * i / zoneCount;
+    uint16_t width = (uint32_t)MATRIX_COLUMNS * (i + 1) / zoneCount - left;
+    snprintf(text, sizeof(text), "%s %s", zones[i].label, zones[i].time);
+    if (frame.textWidth(text) <= width) {
+      frame.drawText(left, width, text, !colonVisible);
+    } else {
+      frame.drawText(left, width, showLabel ? zones[i].label : zones[i].time, !colonVisible);
+    }
+  }
+  pushFrame();
+}
+
 void DisplayManager::setState(DisplayState newState) {
   // Only reset waitStart if we're transitioning to a new state
   if (state != newState) {
-    state = newState;
+    enterState(newState);
+    // Whatever is on the matrix belongs to the previous state
+    staticStale = true;
     if (state == SHOW_TZ_WAIT || state == SHOW_TIME_STATIC) {
       waitStart = millis();
     }
   }
 }
 
+void DisplayManager::enterState(DisplayState newState) {
+  state = newState;
+  notify();
+}
+
+void DisplayManager::startScroll(ScrollEffect effect, uint16_t frameInterval) {
+  frame.startScroll(scrollBuffer, effect);
+  animationInterval = frameInterval;
+  nextFrameTime = millis();
+}
+
+bool DisplayManager::animate() {
+  // One scroll step per frame interval
+  unsigned long now = millis();
+  long late = (long)(now - nextFrameTime);
+  if (late < 0) return false;
+  nextFrameTime = now + animationInterval;
+  
+  // Frame slots that passed entirely are skipped, not caught up
+  if (late > (long)animationInterval / 2) lateFrames++;
+  droppedFrames += late / animationInterval;
+  animationFrames++;
+  metricsFrameLateness(late * 1000UL);
+  
+  unsigned long start = micros();
+  bool done = frame.stepScroll();
+  pushFrame();
+  lastFrameMicros = micros() - start;
+  if (lastFrameMicros > maxFrameMicros) maxFrameMicros = lastFrameMicros;
+  return done;
+}
+
+unsigned long DisplayManager::getNextDeadline() {
+  switch (state) {
+    case SHOW_TZ_WAIT:
+      return waitStart + WAIT_DURATION;
+    case SHOW_TIME_STATIC:
+    case SHOW_ZONES:
+      return lastBlinkTime + BLINK_INTERVAL;
+    default:
+      return nextFrameTime;
+  }
+}
+
 void DisplayManager::update() {
   // Update blinking colon
-  if (state == SHOW_TIME_STATIC) {
+  if (state == SHOW_TIME_STATIC || state == SHOW_ZONES) {
     updateBlinkingColon();
   }
   
   switch (state) {
     case SHOW_TZ_SCROLL:
       // Check if animation is complete (displayAnimate returns true when done)
-      if (display.displayAnimate()) {
+      if (animate()) {
         // Animation complete, transition to wait state
         waitStart = millis();
-        state = SHOW_TZ_WAIT;
+        enterState(SHOW_TZ_WAIT);
       }
       break;
 
     case SHOW_TZ_WAIT:
       if (millis() - waitStart >= WAIT_DURATION) {
-        String timeStr = currentTimeString;
-        timeStr.toCharArray(scrollBuffer, sizeof(scrollBuffer));
+        strlcpy(scrollBuffer, currentTimeString, sizeof(scrollBuffer));
 
         if (strlen(scrollBuffer) > 5) {
-          display.displayScroll(scrollBuffer, PA_CENTER, PA_SCROLL_LEFT, 90);
-          state = SHOW_TIME_LTR;
+          startScroll(SCROLL_LEFT, TIME_SCROLL_INTERVAL);
+          enterState(SHOW_TIME_LTR);
         } else {
-          display.displayClear();
           // Format with blinking colon
-          String formatted = formatTimeWithBlinkingColon(timeStr);
-          formatted.toCharArray(scrollBuffer, sizeof(scrollBuffer));
-          display.print(scrollBuffer);
+          syncBlink(millis());
+          renderStaticTime();
           waitStart = millis();
-          lastBlinkTime = millis();
-          colonVisible = true;
-          state = SHOW_TIME_STATIC;
+          enterState(SHOW_TIME_STATIC);
         }
       }
       break;
 
     case SHOW_TIME_LTR:
-      if (display.displayAnimate()) {
-        display.displayScroll(scrollBuffer, PA_CENTER, PA_SCROLL_RIGHT, 90);
-        state = SHOW_TIME_RTL;
+      if (animate()) {
+        startScroll(SCROLL_RIGHT, TIME_SCROLL_INTERVAL);
+        enterState(SHOW_TIME_RTL);
       }
       break;
 
     case SHOW_TIME_RTL:
-      if (display.displayAnimate()) {
-        state = SHOW_TZ_SCROLL;
+      if (animate()) {
+        enterState(SHOW_TZ_SCROLL);
       }
       break;
 
@@ -142,6 +250,10 @@ void DisplayManager::update() {
       }
       // Blinking is handled in updateBlinkingColon()
       break;
+
+    case SHOW_ZONES:
+      // Regions are redrawn with the blinking colon in updateBlinkingColon()
+      break;
   }
 }
 
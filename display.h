@@ -5,15 +5,23 @@
 #include <MD_Parola.h>
 #include <MD_MAX72XX.h>
 #include "config.h"
+#include "timeformat.h"
+#include "framebuffer.h"
 
 enum DisplayState {
   SHOW_TZ_SCROLL,
   SHOW_TZ_WAIT,
   SHOW_TIME_LTR,
   SHOW_TIME_RTL,
-  SHOW_TIME_STATIC
+  SHOW_TIME_STATIC,
+  SHOW_ZONES       // Side-by-side layout, every enabled timezone at once
 };
 
+// Called after the state, current timezone or displayed time changes
+typedef void (*DisplayListener)();
+
+const char* displayStateName(DisplayState state);
+
 class DisplayManager {
 public:
   DisplayManager();
@@ -22,29 +30,71 @@ public:
   void update();
   void setState(DisplayState newState);
   DisplayState getState() { return state; }
-  void setCurrentTZ(int tz) { currentTZ = tz; }
+  void setCurrentTZ(int tz);
   int getCurrentTZ() { return currentTZ; }
-  void setTimeString(String timeStr);
-  void setTimezoneName(String tzName);
+  void setTimeString(const char* timeStr);
+  const char* getTimeString() { return currentTimeString; }
+  void setTimezoneName(const char* tzName);
   void setShowTimezone(bool show) { showTimezone = show; }
   bool shouldShowTimezone() { return showTimezone; }
   unsigned long getWaitStart() { return waitStart; }
+  unsigned long getNextDeadline();
   void setTimeDisplayDuration(unsigned long duration) { timeDisplayDuration = duration; }
+  void setSecondStart(unsigned long at) { secondStart = at; } // millis() at which a UTC second began
+  FrameBuffer& getFrameBuffer() { return frame; }
+  void clearZones() { zoneCount = 0; }
+  void addZone(const char* label, const char* timeStr);
+  void renderZones();
+  void setListener(DisplayListener l) { listener = l; }
+  
+  // CPU time of the last and slowest animation frame, step and push together
+  unsigned long getLastFrameMicros() { return lastFrameMicros; }
+  unsigned long getMaxFrameMicros() { return maxFrameMicros; }
+  
+  // Animation frames run, run more than half an interval late, and skipped
+  unsigned long getAnimationFrames() { return animationFrames; }
+  unsigned long getLateFrames() { return lateFrames; }
+  unsigned long getDroppedFrames() { return droppedFrames; }
   
 private:
   void updateBlinkingColon();
-  String formatTimeWithBlinkingColon(String timeStr);
+  void syncBlink(unsigned long now);
+  void renderStaticTime();
+  void pushFrame();
+  void startScroll(ScrollEffect effect, uint16_t frameInterval);
+  bool animate();
+  void enterState(DisplayState newState);
+  void notify() { if (listener) listener(); }
+  
+  struct ZoneRegion {
+    char label[TZDB_LABEL_SIZE];
+    char time[TIME_FORMAT_MAX];
+  };
   
   MD_Parola display;
+  FrameBuffer frame;
   DisplayState state;
   int currentTZ;
   char scrollBuffer[32];
   unsigned long waitStart;
   unsigned long lastBlinkTime;
+  unsigned long secondStart;
+  unsigned long nextFrameTime;
+  uint16_t animationInterval;
   bool colonVisible;
-  String currentTimeString;
+  char currentTimeString[TIME_FORMAT_MAX];
   bool showTimezone;
   unsigned long timeDisplayDuration;
+  uint8_t intensity;
+  bool staticStale;        // Static time not drawn since entering the state
+  ZoneRegion zones[MAX_ZONE_REGIONS];
+  uint8_t zoneCount;
+  DisplayListener listener;
+  unsigned long lastFrameMicros;
+  unsigned long maxFrameMicros;
+  unsigned long animationFrames;
+  unsigned long lateFrames;
+  unsigned long droppedFrames;
 };
 
 #endif
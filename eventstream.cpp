@@ -0,0 +1,89 @@
+#include "eventstream.h"
+
+// Longest frame: id and event lines around a full payload
+static const size_t SSE_FRAME_SIZE = SSE_EVENT_SIZE + 48;
+
+EventStream::EventStream() : nextSeq(0) {
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    subscribers[i].active = false;
+  }
+}
+
+bool EventStream::hasFreeSlot() {
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    if (!subscribers[i].active) return true;
+  }
+  return false;
+}
+
+bool EventStream::subscribe(WiFiClient& client) {
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    Subscriber& sub = subscribers[i];
+    if (sub.active) continue;
+    // Holding a copy keeps the connection open after the request handler returns
+    sub.client = client;
+    sub.client.setNoDelay(true);
+    sub.active = true;
+    sub.nextSeq = nextSeq;
+    sub.dropped = 0;
+    sub.reported = 0;
+    sub.lastWrite = millis();
+    return true;
+  }
+  return false;
+}
+
+void EventStream::publish(const char* type, const char* data) {
+  Event& ev = queue[nextSeq % SSE_QUEUE_SIZE];
+  ev.type = type;
+  strlcpy(ev.data, data, sizeof(ev.data));
+  nextSeq++;
+}
+
+bool EventStream::sendFrame(Subscriber& sub, const char* frame, size_t len) {
+  // Only write what the TCP buffer takes right now; the rest waits a round
+  if ((size_t)sub.client.availableForWrite() < len) return false;
+  sub.client.write((const uint8_t*)frame, len);
+  sub.lastWrite = millis();
+  return true;
+}
+
+void EventStream::process() {
+  uint32_t oldest = nextSeq > SSE_QUEUE_SIZE ? nextSeq - SSE_QUEUE_SIZE : 0;
+  char frame[SSE_FRAME_SIZE];
+  
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    Subscriber& sub = subscribers[i];
+    if (!sub.active) continue;
+    if (!sub.client.connected()) {
+      sub.client.stop();
+      sub.active = false;
+      continue;
+    }
+    
+    // Events overwritten while this client wasn't draining are lost
+    if (sub.nextSeq < oldest) {
+      sub.dropped += oldest - sub.nextSeq;
+      sub.nextSeq = oldest;
+    }
+    if (sub.dropped != sub.reported) {
+      int len = snprintf(frame, sizeof(frame), "event: dropped\ndata: {\"dropped\":%lu}\n\n", (unsigned long)sub.dropped);
+      if (!sendFrame(sub, frame, len)) continue;
+      sub.reported = sub.dropped;
+    }
+    
+    while (sub.nextSeq != nextSeq) {
+      Event& ev = queue[sub.nextSeq % SSE_QUEUE_SIZE];
+      int len = snprintf(frame, sizeof(frame), "id: %lu\nevent: %s\ndata: %s\n\n",
+                         (unsigned long)sub.nextSeq, ev.type, ev.data);
+      if (len >= (int)sizeof(frame)) len = sizeof(frame) - 1;
+      if (!sendFrame(sub, frame, len)) break;
+      sub.nextSeq++;
+    }
+    
+    // Lets proxies and the TCP stack notice a dead connection
+    if (millis() - sub.lastWrite >= SSE_KEEPALIVE_INTERVAL) {
+      sendFrame(sub, ":\n\n", 3);
+    }
+  }
+}
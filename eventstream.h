@@ -0,0 +1,47 @@
+#ifndef EVENTSTREAM_H
+#define EVENTSTREAM_H
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include "config.h"
+
+// Server-Sent Events fan-out. Published events go into a fixed ring; each
+// subscriber has its own read position and only gets what fits in its TCP
+// send buffer on every process() call, so a slow client never blocks loop().
+// A subscriber that falls a whole ring behind skips ahead and has the
+// skipped events added to its dropped counter.
+class EventStream {
+public:
+  EventStream();
+  bool hasFreeSlot();
+  bool subscribe(WiFiClient& client);
+  void publish(const char* type, const char* data);
+  void process();
+  uint32_t getPublished() { return nextSeq; }
+  bool isSubscribed(uint8_t slot) { return subscribers[slot].active; }
+  uint32_t getDropped(uint8_t slot) { return subscribers[slot].dropped; }
+  uint32_t getPending(uint8_t slot) { return nextSeq - subscribers[slot].nextSeq; }
+  
+private:
+  struct Event {
+    const char* type;       // String literal
+    char data[SSE_EVENT_SIZE];
+  };
+  
+  struct Subscriber {
+    WiFiClient client;
+    bool active;
+    uint32_t nextSeq;       // Next event to send
+    uint32_t dropped;       // Events overwritten before they could be sent
+    uint32_t reported;      // Dropped count last announced to the client
+    unsigned long lastWrite;
+  };
+  
+  bool sendFrame(Subscriber& sub, const char* frame, size_t len);
+  
+  Event queue[SSE_QUEUE_SIZE];
+  Subscriber subscribers[SSE_MAX_CLIENTS];
+  uint32_t nextSeq;
+};
+
+#endif
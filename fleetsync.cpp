@@ -0,0 +1,295 @@
+#include "fleetsync.h"
+#include <ESP8266WiFi.h>
+#include <limits.h>
+#include <stddef.h>
+#include "debuglog.h"
+
+static const uint32_t FLEET_MAGIC = 0x4c465a4d; // "MZFL"
+static const uint8_t FLEET_VERSION = 2;  // 2: signed
+
+// Followers ignore announced steps further out than this
+static const uint64_t MAX_STEP_AHEAD = 120000;
+
+// The receive window widens to at most FLEET_RECEIVE_GUARD << this either
+// side, which covers a whole beacon interval
+static const uint8_t MAX_WIDENING = 7;
+
+// Sent as is; every clock in the fleet is little-endian
+struct FleetBeacon {
+  uint32_t magic;
+  uint8_t version;
+  uint8_t scheduled;       // 1 on the beacon cadence, 0 for a step announcement
+  uint16_t reserved;
+  uint32_t seq;
+  uint64_t utcMicros;      // Leader clock when sent
+  uint64_t nextStep;       // UTC ms of the leader's next rotation step, 0 if none
+  uint8_t mac[32];         // HMAC-SHA256 of everything above, keyed by FLEET_KEY
+};
+
+static void sign(const br_hmac_key_context& key, const FleetBeacon& beacon, uint8_t* mac) {
+  br_hmac_context hmac;
+  br_hmac_init(&hmac, &key, sizeof(beacon.mac));
+  br_hmac_update(&hmac, &beacon, offsetof(FleetBeacon, mac));
+  br_hmac_out(&hmac, mac);
+}
+
+// Compares every byte, so the time taken does not tell how many matched
+static bool verify(const br_hmac_key_context& key, const FleetBeacon& beacon) {
+  uint8_t mac[sizeof(beacon.mac)];
+  sign(key, beacon, mac);
+  uint8_t diff = 0;
+  for (size_t i = 0; i < sizeof(mac); i++) diff |= mac[i] ^ beacon.mac[i];
+  return diff == 0;
+}
+
+const char* fleetRoleName(uint8_t role) {
+  static const char* const ROLE_NAMES[] = { "off", "leader", "follower" };
+  return role <= FLEET_FOLLOWER ? ROLE_NAMES[role] : "off";
+}
+
+FleetSync::FleetSync(NtpClock& c) :
+  clock(c),
+  role(FLEET_OFF),
+  started(false),
+  nextPoll(0),
+  seq(0),
+  nextBeacon(0),
+  hasStep(false),
+  stepMillis(0),
+  stepChanged(false),
+  following(false),
+  lastBeacon(0),
+  expected(0),
+  misses(0),
+  lastPoll(0),
+  leaderStep(0),
+  leaderMicros(0),
+  bestOffset(0),
+  samples(0),
+  sampleGroup(0),
+  sent(0),
+  received(0),
+  leaderLosses(0),
+  rejected(0),
+  late(0),
+  lastOffset(0) {
+  br_hmac_key_init(&key, &br_sha256_vtable, FLEET_KEY, strlen(FLEET_KEY));
+}
+
+void FleetSync::setRole(uint8_t newRole) {
+  // Unsigned beacons would let anyone on the LAN set the clocks
+  if (newRole != FLEET_OFF && FLEET_KEY[0] == '\0') {
+    logEvent(LOG_FLEET_NO_KEY);
+    newRole = FLEET_OFF;
+  }
+  if (newRole == role) return;
+  if (started) {
+    udp.stop();
+    started = false;
+  }
+  if (following) {
+    following = false;
+    clock.setExternalSource(false);
+  }
+  role = newRole;
+  leaderStep = 0;
+  leaderMicros = 0;
+  samples = 0;
+  nextPoll = millis();
+}
+
+void FleetSync::start() {
+  // Followers join the group; the leader only sends to it but binds the
+  // same port, which also keeps a second leader's beacons out of its way
+  udp.beginMulticast(WiFi.localIP(), FLEET_MULTICAST_GROUP, FLEET_PORT);
+  started = true;
+  nextBeacon = millis();
+}
+
+void FleetSync::setNextStep(unsigned long atMillis) {
+  if (hasStep && atMillis == stepMillis) return;
+  hasStep = true;
+  stepMillis = atMillis;
+  stepChanged = true;
+  if (role == FLEET_LEADER) nextPoll = millis();
+}
+
+void FleetSync::clearNextStep() {
+  if (!hasStep) return;
+  hasStep = false;
+  stepChanged = true;
+  if (role == FLEET_LEADER) nextPoll = millis();
+}
+
+bool FleetSync::getLeaderStep(unsigned long& atMillis) {
+  if (!following || leaderStep == 0) return false;
+  uint64_t now = clock.nowMillis();
+  if (leaderStep <= now || leaderStep - now > MAX_STEP_AHEAD) return false;
+  atMillis = millis() + (unsigned long)(leaderStep - now);
+  return true;
+}
+
+void FleetSync::sendBeacon(bool scheduled) {
+  // Padding is signed along with the fields, so it goes out zeroed
+  FleetBeacon beacon;
+  memset(&beacon, 0, sizeof(beacon));
+  beacon.magic = FLEET_MAGIC;
+  beacon.version = FLEET_VERSION;
+  beacon.scheduled = scheduled ? 1 : 0;
+  beacon.reserved = 0;
+  beacon.seq = seq++;
+  beacon.utcMicros = clock.nowMicros();
+  beacon.nextStep = hasStep ? beacon.utcMicros / 1000 + (long)(stepMillis - millis()) : 0;
+  sign(key, beacon, beacon.mac);
+  
+  udp.beginPacketMulticast(FLEET_MULTICAST_GROUP, FLEET_PORT, WiFi.localIP());
+  udp.write((const uint8_t*)&beacon, sizeof(beacon));
+  udp.endPacket();
+  sent++;
+}
+
+void FleetSync::receive() {
+  FleetBeacon beacon;
+  while (udp.parsePacket() > 0) {
+    // Timestamp before reading, as close to the arrival as the poll allows.
+    // Only a beacon that came in since the last close poll has a known
+    // arrival time; anything older sat in the queue for an unknown while
+    uint64_t local = clock.nowMicros();
+    unsigned long arrived = millis();
+    bool timed = following && arrived - lastPoll <= 2 * FLEET_RECEIVE_POLL;
+    if (udp.read((uint8_t*)&beacon, sizeof(beacon)) != (int)sizeof(beacon)) continue;
+    if (beacon.magic != FLEET_MAGIC || beacon.version != FLEET_VERSION) continue;
+    if (!verify(key, beacon)) {
+      rejected++;
+      continue;
+    }
+    // A replayed beacon is signed but carries an older leader time. One
+    // overtaken by a newer beacon on the way is a beacon interval old at
+    // most; anything older was sent again. With no leader, every beacon sent
+    // before the last one was lost is FLEET_LEADER_TIMEOUT behind our clock.
+    if (beacon.utcMicros <= leaderMicros) {
+      if (leaderMicros - beacon.utcMicros <= FLEET_BEACON_INTERVAL * 1000ULL) {
+        late++;
+      } else {
+        rejected++;
+      }
+      continue;
+    }
+    if (leaderMicros == 0 && clock.isSynced() && beacon.utcMicros + FLEET_LEADER_TIMEOUT * 1000ULL < local) {
+      rejected++;
+      continue;
+    }
+    leaderMicros = beacon.utcMicros;
+    
+    received++;
+    lastBeacon = arrived;
+    leaderStep = beacon.nextStep;
+    if (!following) {
+      following = true;
+      samples = 0;
+      // Picked up by a WEB_POLL_INTERVAL poll, so start with a wide window
+      expected = arrived - WEB_POLL_INTERVAL / 2 + FLEET_BEACON_INTERVAL;
+      misses = 2;
+      clock.setExternalSource(true);
+      logEvent(LOG_FLEET_FOLLOWING);
+    }
+    
+    // Step announcements arrive off cadence and are not polled for closely
+    if (!beacon.scheduled) continue;
+    int64_t offset = (int64_t)(beacon.utcMicros - local);
+    if (!timed && clock.hasTime()) continue;
+    
+    // The window tracks the earliest arrivals: network delay only ever makes
+    // a beacon later, so it moves back at once but forward by 1 ms a beacon,
+    // unless a widened window found the beacons somewhere else entirely. It
+    // is kept in local time, so a step of the leader's clock does not move it.
+    if (timed) {
+      long early = (long)(expected - arrived);
+      if (early > 0 || (misses > 0 && -early > (long)FLEET_RECEIVE_GUARD)) {
+        expected = arrived;
+      } else if (arrived != expected) {
+        expected++;
+      }
+      expected += FLEET_BEACON_INTERVAL;
+      misses = 0;
+    }
+    
+    uint32_t group = beacon.seq / FLEET_FILTER_SIZE;
+    if (samples > 0 && group != sampleGroup) correct();
+    if (samples == 0 || offset > bestOffset) bestOffset = offset;
+    sampleGroup = group;
+    samples++;
+    if (!clock.hasTime() || beacon.seq % FLEET_FILTER_SIZE == FLEET_FILTER_SIZE - 1) correct();
+  }
+}
+
+void FleetSync::correct() {
+  clock.applyExternalOffset(bestOffset);
+  lastOffset = bestOffset > LONG_MAX ? LONG_MAX : (bestOffset < LONG_MIN ? LONG_MIN : (long)bestOffset);
+  samples = 0;
+}
+
+void FleetSync::process() {
+  unsigned long now = millis();
+  if (role == FLEET_OFF) return;
+  
+  if (!started) {
+    if (WiFi.status() != WL_CONNECTED) {
+      nextPoll = now + FLEET_BEACON_INTERVAL;
+      return;
+    }
+    start();
+  }
+  
+  if (role == FLEET_LEADER) {
+    // Nothing to read; a second leader's beacons are dropped
+    while (udp.parsePacket() > 0) {
+      udp.flush();
+    }
+    // Only time that NTP has confirmed is handed on
+    if (clock.isSynced()) {
+      if ((long)(now - nextBeacon) >= 0) {
+        sendBeacon(true);
+        stepChanged = false;
+      } else if (stepChanged) {
+        sendBeacon(false);
+        stepChanged = false;
+      }
+    }
+    if ((long)(now - nextBeacon) >= 0) {
+      nextBeacon += FLEET_BEACON_INTERVAL;
+      if ((long)(now - nextBeacon) >= 0) nextBeacon = now + FLEET_BEACON_INTERVAL;
+    }
+    nextPoll = nextBeacon;
+    return;
+  }
+  
+  receive();
+  lastPoll = now;
+  if (following && now - lastBeacon >= FLEET_LEADER_TIMEOUT) {
+    following = false;
+    leaderStep = 0;
+    // The next leader, or this one after a step back, starts afresh
+    leaderMicros = 0;
+    samples = 0;
+    leaderLosses++;
+    clock.setExternalSource(false);
+    logEvent(LOG_FLEET_LOST);
+  }
+  
+  if (!following) {
+    nextPoll = now + WEB_POLL_INTERVAL;
+    return;
+  }
+  // Poll closely from a little before a scheduled beacon is due until a
+  // little after. A window that closes empty was perhaps misplaced, so the
+  // next one is twice as wide.
+  unsigned long guard = FLEET_RECEIVE_GUARD << misses;
+  while ((long)(now - expected) > (long)guard) {
+    expected += FLEET_BEACON_INTERVAL;
+    if (misses < MAX_WIDENING) misses++;
+    guard = FLEET_RECEIVE_GUARD << misses;
+  }
+  unsigned long opens = expected - guard;
+  nextPoll = (long)(now - opens) >= 0 ? now + FLEET_RECEIVE_POLL : opens;
+}
@@ -0,0 +1,98 @@
+#ifndef FLEETSYNC_H
+#define FLEETSYNC_H
+
+#include <Arduino.h>
+#include <WiFiUdp.h>
+#include <bearssl/bearssl_hmac.h>
+#include "config.h"
+#include "ntpclock.h"
+
+const char* fleetRoleName(uint8_t role);
+
+// Leader/follower time distribution over UDP multicast, so a room of clocks
+// needs one NTP client instead of one each and rotates in step.
+//
+// The leader multicasts a beacon every FLEET_BEACON_INTERVAL with its clock
+// and the UTC instant of its next rotation step, plus an extra beacon
+// whenever that step changes. Followers stop polling NTP while beacons
+// arrive. Network delay can only make the leader look late, so of every
+// FLEET_FILTER_SIZE beacons the one implying the largest offset is fed to
+// the clock discipline. The groups go by the leader's sequence numbers, so
+// all followers correct on the same beacon and a change of the leader's
+// clock reaches them together. Beacons are polled for in a short window around
+// their expected arrival to keep the pickup delay near 1 ms; the window is
+// kept in local time from the beacons it caught, and widens after a miss.
+// Beacons that arrived outside it have no usable arrival time and only
+// count towards keeping the leader. After
+// FLEET_LEADER_TIMEOUT without a beacon a follower goes back to NTP.
+//
+// Beacons are signed with an HMAC-SHA256 keyed by FLEET_KEY, and a follower
+// only takes a beacon whose leader time is later than the last one it took,
+// so neither a forged nor a replayed beacon moves its clock. Losing the
+// leader clears that time, so a leader whose clock stepped back is taken up
+// again once it is within FLEET_LEADER_TIMEOUT of the follower's own.
+class FleetSync {
+public:
+  FleetSync(NtpClock& clock);
+  void setRole(uint8_t role);
+  uint8_t getRole() { return role; }
+  void process();
+  unsigned long getNextDeadline() { return nextPoll; }
+  
+  // Leader: millis() at which the rotation moves on to the next zone
+  void setNextStep(unsigned long atMillis);
+  void clearNextStep();
+  
+  // Follower: the leader's next step in local millis(), if one is coming up
+  bool getLeaderStep(unsigned long& atMillis);
+  bool isFollowing() { return following; }
+  
+  // Statistics
+  unsigned long getSent() { return sent; }
+  unsigned long getReceived() { return received; }
+  unsigned long getLeaderLosses() { return leaderLosses; }
+  unsigned long getRejected() { return rejected; }  // Bad signature or replayed
+  unsigned long getLate() { return late; }          // Overtaken by a newer beacon
+  long getLastOffset() { return lastOffset; }  // us, last correction applied
+  
+private:
+  void start();
+  void sendBeacon(bool scheduled);
+  void receive();
+  void correct();
+  
+  WiFiUDP udp;
+  br_hmac_key_context key;
+  NtpClock& clock;
+  uint8_t role;
+  bool started;
+  unsigned long nextPoll;
+  
+  // Leader
+  uint32_t seq;
+  unsigned long nextBeacon;
+  bool hasStep;
+  unsigned long stepMillis;
+  bool stepChanged;
+  
+  // Follower
+  bool following;
+  unsigned long lastBeacon;
+  unsigned long expected;     // millis() the next scheduled beacon should arrive at
+  uint8_t misses;             // Windows in a row without one; each doubles the window
+  unsigned long lastPoll;
+  uint64_t leaderStep;        // UTC ms, 0 if the leader has none scheduled
+  uint64_t leaderMicros;      // Leader clock of the last beacon taken, 0 without a leader
+  int64_t bestOffset;
+  uint8_t samples;
+  uint32_t sampleGroup;       // Beacon seq / FLEET_FILTER_SIZE of the samples
+  
+  unsigned long sent;
+  unsigned long received;
+  unsigned long leaderLosses;
+  unsigned long rejected;
+  unsigned long late;
+  long lastOffset;
+};
+
+#endif
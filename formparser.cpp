@@ -0,0 +1,158 @@
+#include "formparser.h"
+
+// Longest number accepted; anything longer is out of range for every field
+static const uint8_t MAX_DIGITS = 5;
+
+static int8_t hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+// Decodes '+' and %XX in place and returns the new length, or -1 if an
+// escape is malformed
+static int decodeInPlace(char* text, size_t length) {
+  size_t out = 0;
+  for (size_t in = 0; in < length; in++) {
+    char c = text[in];
+    if (c == '+') {
+      c = ' ';
+    } else if (c == '%') {
+      if (in + 2 >= length) return -1;
+      int8_t high = hexValue(text[in + 1]);
+      int8_t low = hexValue(text[in + 2]);
+      if (high < 0 || low < 0) return -1;
+      c = (char)(high << 4 | low);
+      in += 2;
+    }
+    text[out++] = c;
+  }
+  return out;
+}
+
+static bool parseNumber(const char* text, size_t length, long& value) {
+  if (length == 0 || length > MAX_DIGITS) return false;
+  value = 0;
+  for (size_t i = 0; i < length; i++) {
+    if (text[i] < '0' || text[i] > '9') return false;
+    value = value * 10 + (text[i] - '0');
+  }
+  return true;
+}
+
+static bool equals(const char* text, size_t length, const char* literal) {
+  return strlen(literal) == length && memcmp(text, literal, length) == 0;
+}
+
+// The page lists zones in rotation order, so the first field naming a zone
+// gives its place in the rotation
+static void notePosition(SettingsForm& form, uint8_t tz) {
+  for (uint8_t i = 0; i < form.orderLength; i++) {
+    if (form.order[i] == tz) return;
+  }
+  form.order[form.orderLength++] = tz;
+}
+
+void beginSettingsForm(SettingsForm& form) {
+  memset(&form, 0, sizeof(form));
+  form.layout = LAYOUT_ROTATE;
+  form.fleetRole = FLEET_OFF;
+}
+
+void mergeRotationOrder(const SettingsForm& form, uint8_t* order) {
+  uint8_t merged[TZ_COUNT];
+  bool placed[TZ_COUNT] = {};
+  uint8_t length = 0;
+  for (uint8_t i = 0; i < form.orderLength; i++) {
+    placed[form.order[i]] = true;
+    merged[length++] = form.order[i];
+  }
+  for (int i = 0; i < TZ_COUNT; i++) {
+    if (order[i] < TZ_COUNT && !placed[order[i]]) {
+      placed[order[i]] = true;
+      merged[length++] = order[i];
+    }
+  }
+  // Anything still missing was lost from a damaged saved order
+  for (int tz = 0; tz < TZ_COUNT; tz++) {
+    if (!placed[tz]) merged[length++] = tz;
+  }
+  memcpy(order, merged, sizeof(merged));
+}
+
+void parseSettingsField(SettingsForm& form, const char* key, size_t keyLength, const char* value, size_t valueLength) {
+  long number;
+  
+  if (keyLength > 2 && key[0] == 't' && key[1] == 'z') {
+    // tz<index>; the checkbox only has to be present
+    if (parseNumber(key + 2, keyLength - 2, number) && number < TZ_COUNT) {
+      form.enabled[number] = 1;
+      notePosition(form, number);
+    } else {
+      form.rejected++;
+    }
+  } else if (keyLength > 5 && memcmp(key, "dwell", 5) == 0) {
+    // dwell<index>=seconds, left blank for the global duration
+    long seconds = 0;
+    if (parseNumber(key + 5, keyLength - 5, number) && number < TZ_COUNT &&
+        (valueLength == 0 || (parseNumber(value, valueLength, seconds) && seconds >= 1 && seconds <= 60))) {
+      form.dwell[number] = seconds;
+      notePosition(form, number);
+    } else {
+      form.rejected++;
+    }
+  } else if (equals(key, keyLength, "intensity")) {
+    if (parseNumber(value, valueLength, number) && number <= 15) {
+      form.intensity = number;
+      form.hasIntensity = true;
+    } else {
+      form.rejected++;
+    }
+  } else if (equals(key, keyLength, "timeDisplayDuration")) {
+    if (parseNumber(value, valueLength, number) && number >= 1 && number <= 60) {
+      form.timeDisplayDuration = number;
+      form.hasDuration = true;
+    } else {
+      form.rejected++;
+    }
+  } else if (equals(key, keyLength, "format")) {
+    form.use12Hour = equals(value, valueLength, "12") ? 1 : 0;
+  } else if (equals(key, keyLength, "layout")) {
+    form.layout = equals(value, valueLength, "zoned") ? LAYOUT_ZONED : LAYOUT_ROTATE;
+  } else if (equals(key, keyLength, "fleet")) {
+    if (equals(value, valueLength, "leader")) {
+      form.fleetRole = FLEET_LEADER;
+    } else if (equals(value, valueLength, "follower")) {
+      form.fleetRole = FLEET_FOLLOWER;
+    } else if (equals(value, valueLength, "off")) {
+      form.fleetRole = FLEET_OFF;
+    } else {
+      form.rejected++;
+    }
+  } else if (equals(key, keyLength, "debug")) {
+    form.debugEnabled = 1;
+  }
+}
+
+void parseSettingsForm(SettingsForm& form, char* body, size_t length) {
+  size_t start = 0;
+  while (start < length) {
+    // One key=value pair up to the next '&'
+    size_t end = start;
+    while (end < length && body[end] != '&') end++;
+    size_t equalsAt = start;
+    while (equalsAt < end && body[equalsAt] != '=') equalsAt++;
+    
+    char* key = body + start;
+    char* value = body + (equalsAt < end ? equalsAt + 1 : end);
+    int keyLength = decodeInPlace(key, equalsAt - start);
+    int valueLength = decodeInPlace(value, end - (value - body));
+    if (keyLength < 0 || valueLength < 0) {
+      form.rejected++;
+    } else if (keyLength > 0) {
+      parseSettingsField(form, key, keyLength, value, valueLength);
+    }
+    start = end + 1;
+  }
+}
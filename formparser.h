@@ -0,0 +1,38 @@
+#ifndef FORMPARSER_H
+#define FORMPARSER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Values posted to /save. Checkboxes and radios that are absent mean off;
+// the numeric fields are only applied when present and valid.
+struct SettingsForm {
+  uint8_t enabled[TZ_COUNT];
+  uint8_t order[TZ_COUNT];  // Zones in the order their fields were posted
+  uint8_t orderLength;
+  uint8_t dwell[TZ_COUNT];  // Seconds; blank or absent means the global duration
+  uint8_t use12Hour;
+  uint8_t debugEnabled;
+  uint8_t layout;
+  uint8_t fleetRole;
+  bool hasIntensity;
+  uint8_t intensity;
+  bool hasDuration;
+  uint16_t timeDisplayDuration;
+  uint16_t rejected;    // Fields that were malformed or out of range
+};
+
+void beginSettingsForm(SettingsForm& form);
+
+// Rewrites a saved rotation order with the posted one. Zones the form did
+// not mention keep their previous relative order after the posted ones.
+void mergeRotationOrder(const SettingsForm& form, uint8_t* order);
+
+// Applies one decoded key/value pair. Unknown keys are ignored.
+void parseSettingsField(SettingsForm& form, const char* key, size_t keyLength, const char* value, size_t valueLength);
+
+// Parses an application/x-www-form-urlencoded body in place: the buffer is
+// percent-decoded where it lies, so nothing is copied or allocated
+void parseSettingsForm(SettingsForm& form, char* body, size_t length);
+
+#endif
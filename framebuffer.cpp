@@ -0,0 +1,219 @@
+#include "framebuffer.h"
+#include "trace.h"
+#include "glyphatlas.h"
+
+// Matches MD_Parola's default spacing between characters
+static const uint8_t CHAR_SPACING = 1;
+static const uint8_t GLYPH_BUFFER_SIZE = 8;
+
+// Bits of the last word that lie past the end of the chain
+static const uint32_t LAST_WORD_MASK = MATRIX_COLUMNS % 32 ? (1UL << (MATRIX_COLUMNS % 32)) - 1 : 0xFFFFFFFFUL;
+
+FrameBuffer::FrameBuffer() :
+  mx(nullptr),
+  latchedValid(false),
+  lastRows(0),
+  lastBytes(0),
+  totalBytes(0),
+  frameCount(0),
+  changedFrames(0),
+  firstPushMillis(0),
+  scrollEffect(SCROLL_LEFT),
+  scrollWidth(0),
+  scrollStep(0),
+  scrollSteps(0) {
+  clear();
+}
+
+void FrameBuffer::begin(MD_MAX72XX* graphics) {
+  mx = graphics;
+  latchedValid = false;
+}
+
+void FrameBuffer::clear() {
+  memset(rows, 0, sizeof(rows));
+}
+
+uint8_t FrameBuffer::deviceRow(uint8_t device, uint8_t row) {
+  return rows[row][device / 4] >> ((device % 4) * 8);
+}
+
+void FrameBuffer::setColumn(int16_t x, uint8_t bits) {
+  // x counts from the left edge; the driver numbers columns from the right
+  if (x < 0 || x >= MATRIX_COLUMNS) return;
+  uint16_t column = MATRIX_COLUMNS - 1 - x;
+  uint8_t word = column / 32;
+  uint32_t mask = 1UL << (column % 32);
+  for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+    if (bits & (1 << row)) {
+      rows[row][word] |= mask;
+    } else {
+      rows[row][word] &= ~mask;
+    }
+  }
+}
+
+uint8_t FrameBuffer::getGlyph(char c, uint8_t* columns) {
+  // The atlas is a direct lookup; the driver's font is a linear walk
+  uint8_t slot = glyphSlot(c);
+  if (slot != GLYPH_NONE) {
+    memcpy_P(columns, GLYPHS[slot].columns, GLYPH_MAX_WIDTH);
+    return pgm_read_byte(&GLYPHS[slot].width);
+  }
+  return mx->getChar((uint8_t)c, GLYPH_BUFFER_SIZE, columns);
+}
+
+uint16_t FrameBuffer::textWidth(const char* text) {
+  if (mx == nullptr) return 0;
+  uint8_t glyph[GLYPH_BUFFER_SIZE];
+  uint16_t width = 0;
+  for (const char* p = text; *p; p++) {
+    width += getGlyph(*p, glyph);
+    if (p[1]) width += CHAR_SPACING;
+  }
+  return width;
+}
+
+void FrameBuffer::drawText(const char* text, bool hideColon) {
+  clear();
+  drawText(0, MATRIX_COLUMNS, text, hideColon);
+}
+
+void FrameBuffer::drawText(int16_t left, uint16_t width, const char* text, bool hideColon) {
+  if (mx == nullptr) return;
+  uint8_t glyph[GLYPH_BUFFER_SIZE];
+  
+  // Center within the region like PA_CENTER, clipping at its edges
+  int16_t right = left + width;
+  int16_t x = left + ((int16_t)width - (int16_t)textWidth(text)) / 2;
+  for (const char* p = text; *p; p++) {
+    uint8_t glyphWidth = getGlyph(*p, glyph);
+    // A hidden colon keeps its width so the digits around it don't move
+    bool blank = hideColon && *p == ':';
+    for (uint8_t i = 0; i < glyphWidth; i++, x++) {
+      if (x >= left && x < right) {
+        setColumn(x, blank ? 0 : glyph[i]);
+      }
+    }
+    x += CHAR_SPACING;
+  }
+}
+
+void FrameBuffer::push() {
+  if (mx == nullptr) return;
+  
+  // Register images of every device, remapped for the module wiring
+  uint8_t registers[MAX_DEVICES][MATRIX_ROWS];
+  for (uint8_t device = 0; device < MAX_DEVICES; device++) {
+    uint8_t deviceRows[MATRIX_ROWS];
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+      deviceRows[row] = deviceRow(device, row);
+    }
+    Matrix::remap(deviceRows, registers[device]);
+  }
+  
+  // Each digit write shifts one (opcode, data) pair through every device of the chain
+  lastRows = 0;
+  for (uint8_t digit = 0; digit < MATRIX_ROWS; digit++) {
+    bool digitChanged = !latchedValid;
+    for (uint8_t device = 0; device < MAX_DEVICES; device++) {
+      digitChanged |= registers[device][digit] != latched[device][digit];
+    }
+    if (!digitChanged) continue;
+    Matrix::writeDigit(digit, registers);
+    for (uint8_t device = 0; device < MAX_DEVICES; device++) {
+      latched[device][digit] = registers[device][digit];
+    }
+    lastRows++;
+  }
+  
+  latchedValid = true;
+  lastBytes = lastRows * MAX_DEVICES * 2;
+  totalBytes += lastBytes;
+  if (frameCount == 0) firstPushMillis = millis();
+  frameCount++;
+  if (lastRows > 0) changedFrames++;
+  traceFrame(*this);
+}
+
+void FrameBuffer::shiftLeft(uint8_t incoming) {
+  // Content moves towards higher column numbers; the new column enters at bit 0
+  for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+    uint32_t* words = rows[row];
+    for (uint8_t w = ROW_WORDS - 1; w > 0; w--) {
+      words[w] = (words[w] << 1) | (words[w - 1] >> 31);
+    }
+    words[0] = (words[0] << 1) | ((incoming >> row) & 1);
+    words[ROW_WORDS - 1] &= LAST_WORD_MASK;
+  }
+}
+
+void FrameBuffer::shiftRight(uint8_t incoming) {
+  // Content moves towards column 0; the new column enters at the left edge
+  static const uint8_t TOP_BIT = (MATRIX_COLUMNS - 1) % 32;
+  for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+    uint32_t* words = rows[row];
+    for (uint8_t w = 0; w < ROW_WORDS - 1; w++) {
+      words[w] = (words[w] >> 1) | (words[w + 1] << 31);
+    }
+    words[ROW_WORDS - 1] = (words[ROW_WORDS - 1] >> 1) | ((uint32_t)((incoming >> row) & 1) << TOP_BIT);
+  }
+}
+
+void FrameBuffer::shiftUp(const uint32_t* incoming) {
+  memmove(rows[0], rows[1], sizeof(rows) - sizeof(rows[0]));
+  if (incoming) {
+    memcpy(rows[MATRIX_ROWS - 1], incoming, sizeof(rows[0]));
+  } else {
+    memset(rows[MATRIX_ROWS - 1], 0, sizeof(rows[0]));
+  }
+}
+
+void FrameBuffer::startScroll(const char* text, ScrollEffect effect) {
+  scrollEffect = effect;
+  scrollStep = 0;
+  clear();
+  
+  if (effect == SCROLL_UP) {
+    // Lay the text out centred, then feed it in row by row from the bottom
+    drawText(text, false);
+    memcpy(scrollTarget, rows, sizeof(rows));
+    clear();
+    scrollSteps = MATRIX_ROWS * 2;
+    return;
+  }
+  
+  // Lay the text out as columns in reading order
+  uint8_t glyph[GLYPH_BUFFER_SIZE];
+  scrollWidth = 0;
+  if (mx != nullptr) {
+    for (const char* p = text; *p; p++) {
+      uint8_t glyphWidth = getGlyph(*p, glyph);
+      for (uint8_t i = 0; i < glyphWidth + CHAR_SPACING && scrollWidth < SCROLL_MAX_COLUMNS; i++) {
+        scrollColumns[scrollWidth++] = i < glyphWidth ? glyph[i] : 0;
+      }
+    }
+  }
+  // In from one edge and fully out of the other
+  scrollSteps = scrollWidth + MATRIX_COLUMNS;
+}
+
+bool FrameBuffer::stepScroll() {
+  if (scrollStep >= scrollSteps) return true;
+  
+  switch (scrollEffect) {
+    case SCROLL_LEFT:
+      shiftLeft(scrollStep < scrollWidth ? scrollColumns[scrollStep] : 0);
+      break;
+    case SCROLL_RIGHT:
+      // Enters last column first
+      shiftRight(scrollStep < scrollWidth ? scrollColumns[scrollWidth - 1 - scrollStep] : 0);
+      break;
+    case SCROLL_UP:
+      shiftUp(scrollStep < MATRIX_ROWS ? scrollTarget[scrollStep] : nullptr);
+      break;
+  }
+  
+  scrollStep++;
+  return scrollStep >= scrollSteps;
+}
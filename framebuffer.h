@@ -0,0 +1,86 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <Arduino.h>
+#include <MD_MAX72XX.h>
+#include "config.h"
+#include "matrixdriver.h"
+
+const uint8_t MATRIX_ROWS = 8;
+const uint16_t MATRIX_COLUMNS = MAX_DEVICES * 8;
+
+// Each matrix row is a bit string over the whole chain, packed into 32-bit
+// words: bit c is column c counted from the right, so byte k of the row is
+// exactly what device k latches for it
+const uint8_t ROW_WORDS = (MATRIX_COLUMNS + 31) / 32;
+
+// Frame output for the configured modules and chain
+typedef MatrixDriver<HARDWARE_TYPE, MAX_DEVICES, CS_PIN> Matrix;
+
+// Longest text the scroll engine lays out (scroll buffer at 6 columns a character)
+const uint16_t SCROLL_MAX_COLUMNS = 192;
+
+enum ScrollEffect {
+  SCROLL_LEFT,   // Enters at the right edge and leaves at the left
+  SCROLL_RIGHT,  // Enters at the left edge and leaves at the right
+  SCROLL_UP      // Rises into the centre from below, then out the top
+};
+
+// Shadow framebuffer. Keeps a copy of what is latched in the MAX7219 chain
+// and pushes only the digit registers that changed. Scrolls are shift-and-merge
+// passes over the packed rows, so a step costs ROW_WORDS words per row
+// whatever the chain length in pixels.
+class FrameBuffer {
+public:
+  FrameBuffer();
+  void begin(MD_MAX72XX* mx);
+  void clear();
+  uint16_t textWidth(const char* text);
+  void drawText(const char* text, bool hideColon);
+  void drawText(int16_t left, uint16_t width, const char* text, bool hideColon);
+  void push();
+  void invalidate() { latchedValid = false; }
+  uint8_t deviceRow(uint8_t device, uint8_t row);
+  
+  // Scroll text across a cleared frame; stepScroll() advances one frame and
+  // returns true once the text has left the matrix
+  void startScroll(const char* text, ScrollEffect effect);
+  bool stepScroll();
+  
+  // Counters for the last push and running totals
+  uint8_t getLastRows() { return lastRows; }
+  uint16_t getLastBytes() { return lastBytes; }
+  unsigned long getTotalBytes() { return totalBytes; }
+  unsigned long getFrameCount() { return frameCount; }
+  unsigned long getChangedFrames() { return changedFrames; }  // Pushes that changed a row
+  unsigned long getFirstPushMillis() { return firstPushMillis; } // Boot to first frame
+  
+private:
+  void setColumn(int16_t x, uint8_t bits);
+  uint8_t getGlyph(char c, uint8_t* columns);
+  void shiftLeft(uint8_t incoming);
+  void shiftRight(uint8_t incoming);
+  void shiftUp(const uint32_t* incoming);
+  
+  MD_MAX72XX* mx;
+  uint32_t rows[MATRIX_ROWS][ROW_WORDS];
+  uint8_t latched[MAX_DEVICES][MATRIX_ROWS];  // Digit registers, in the modules' wiring
+  bool latchedValid;
+  uint8_t lastRows;
+  uint16_t lastBytes;
+  unsigned long totalBytes;
+  unsigned long frameCount;
+  unsigned long changedFrames;
+  unsigned long firstPushMillis;
+  
+  // Scroll state: horizontal scrolls feed columns of the laid out text,
+  // vertical ones feed rows of the centred target frame
+  ScrollEffect scrollEffect;
+  uint8_t scrollColumns[SCROLL_MAX_COLUMNS];
+  uint16_t scrollWidth;
+  uint32_t scrollTarget[MATRIX_ROWS][ROW_WORDS];
+  uint16_t scrollStep;
+  uint16_t scrollSteps;
+};
+
+#endif
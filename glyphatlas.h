@@ -0,0 +1,111 @@
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <Arduino.h>
+
+// Column bitmaps for every character a time string or zone label can use,
+// so the framebuffer doesn't have to walk the MD_MAX72XX font for each one.
+// Bit n of a column is row n, row 0 at the top. Characters not in the atlas
+// fall back to the driver's font.
+
+const uint8_t GLYPH_MAX_WIDTH = 5;
+
+struct Glyph {
+  char ch;
+  uint8_t width;
+  uint8_t columns[GLYPH_MAX_WIDTH];
+};
+
+constexpr Glyph GLYPHS[] PROGMEM = {
+  { ' ', 2, { 0x00, 0x00 } },
+  { '-', 3, { 0x08, 0x08, 0x08 } },
+  { ':', 2, { 0x36, 0x36 } },
+  // Digits share one width so the time doesn't shift as it counts
+  { '0', 5, { 0x3E, 0x51, 0x49, 0x45, 0x3E } },
+  { '1', 5, { 0x00, 0x42, 0x7F, 0x40, 0x00 } },
+  { '2', 5, { 0x42, 0x61, 0x51, 0x49, 0x46 } },
+  { '3', 5, { 0x21, 0x41, 0x45, 0x4B, 0x31 } },
+  { '4', 5, { 0x18, 0x14, 0x12, 0x7F, 0x10 } },
+  { '5', 5, { 0x27, 0x45, 0x45, 0x45, 0x39 } },
+  { '6', 5, { 0x3C, 0x4A, 0x49, 0x49, 0x30 } },
+  { '7', 5, { 0x01, 0x71, 0x09, 0x05, 0x03 } },
+  { '8', 5, { 0x36, 0x49, 0x49, 0x49, 0x36 } },
+  { '9', 5, { 0x06, 0x49, 0x49, 0x29, 0x1E } },
+  { 'A', 5, { 0x7E, 0x11, 0x11, 0x11, 0x7E } },
+  { 'B', 5, { 0x7F, 0x49, 0x49, 0x49, 0x36 } },
+  { 'C', 5, { 0x3E, 0x41, 0x41, 0x41, 0x22 } },
+  { 'D', 5, { 0x7F, 0x41, 0x41, 0x22, 0x1C } },
+  { 'E', 5, { 0x7F, 0x49, 0x49, 0x49, 0x41 } },
+  { 'F', 5, { 0x7F, 0x09, 0x09, 0x09, 0x01 } },
+  { 'G', 5, { 0x3E, 0x41, 0x49, 0x49, 0x7A } },
+  { 'H', 5, { 0x7F, 0x08, 0x08, 0x08, 0x7F } },
+  { 'I', 3, { 0x41, 0x7F, 0x41 } },
+  { 'J', 5, { 0x20, 0x40, 0x41, 0x3F, 0x01 } },
+  { 'K', 5, { 0x7F, 0x08, 0x14, 0x22, 0x41 } },
+  { 'L', 5, { 0x7F, 0x40, 0x40, 0x40, 0x40 } },
+  { 'M', 5, { 0x7F, 0x02, 0x0C, 0x02, 0x7F } },
+  { 'N', 5, { 0x7F, 0x04, 0x08, 0x10, 0x7F } },
+  { 'O', 5, { 0x3E, 0x41, 0x41, 0x41, 0x3E } },
+  { 'P', 5, { 0x7F, 0x09, 0x09, 0x09, 0x06 } },
+  { 'Q', 5, { 0x3E, 0x41, 0x51, 0x21, 0x5E } },
+  { 'R', 5, { 0x7F, 0x09, 0x19, 0x29, 0x46 } },
+  { 'S', 5, { 0x46, 0x49, 0x49, 0x49, 0x31 } },
+  { 'T', 5, { 0x01, 0x01, 0x7F, 0x01, 0x01 } },
+  { 'U', 5, { 0x3F, 0x40, 0x40, 0x40, 0x3F } },
+  { 'V', 5, { 0x1F, 0x20, 0x40, 0x20, 0x1F } },
+  { 'W', 5, { 0x3F, 0x40, 0x38, 0x40, 0x3F } },
+  { 'X', 5, { 0x63, 0x14, 0x08, 0x14, 0x63 } },
+  { 'Y', 5, { 0x07, 0x08, 0x70, 0x08, 0x07 } },
+  { 'Z', 5, { 0x61, 0x51, 0x49, 0x45, 0x43 } }
+};
+
+const uint8_t GLYPH_COUNT = sizeof(GLYPHS) / sizeof(GLYPHS[0]);
+const char GLYPH_FIRST = ' ';
+const char GLYPH_LAST = 'Z';
+const uint8_t GLYPH_NONE = 0xFF;
+
+// Character -> GLYPHS slot, built by the compiler from the table above
+struct GlyphIndex {
+  uint8_t slot[GLYPH_LAST - GLYPH_FIRST + 1];
+};
+
+constexpr GlyphIndex buildGlyphIndex() {
+  GlyphIndex index = {};
+  for (uint8_t i = 0; i < sizeof(index.slot); i++) {
+    index.slot[i] = GLYPH_NONE;
+  }
+  for (uint8_t i = 0; i < GLYPH_COUNT; i++) {
+    index.slot[GLYPHS[i].ch - GLYPH_FIRST] = i;
+  }
+  return index;
+}
+
+constexpr GlyphIndex GLYPH_INDEX PROGMEM = buildGlyphIndex();
+
+constexpr bool digitsShareWidth() {
+  for (char c = '1'; c <= '9'; c++) {
+    if (GLYPHS[GLYPH_INDEX.slot[c - GLYPH_FIRST]].width != GLYPHS[GLYPH_INDEX.slot['0' - GLYPH_FIRST]].width) return false;
+  }
+  return true;
+}
+
+constexpr bool glyphsFit() {
+  for (uint8_t i = 0; i < GLYPH_COUNT; i++) {
+    if (GLYPHS[i].ch < GLYPH_FIRST || GLYPHS[i].ch > GLYPH_LAST || GLYPHS[i].width > GLYPH_MAX_WIDTH) return false;
+  }
+  return true;
+}
+
+static_assert(glyphsFit(), "Glyph outside the atlas index or wider than GLYPH_MAX_WIDTH");
+static_assert(digitsShareWidth(), "Digits must share one width");
+
+// Atlas footprint in flash: 273 bytes of glyphs plus a 59 byte index
+static_assert(sizeof(GLYPHS) + sizeof(GLYPH_INDEX) <= 400, "Glyph atlas grew unexpectedly");
+
+// Returns the atlas slot of c, or GLYPH_NONE
+inline uint8_t glyphSlot(char c) {
+  if (c < GLYPH_FIRST || c > GLYPH_LAST) return GLYPH_NONE;
+  return pgm_read_byte(&GLYPH_INDEX.slot[c - GLYPH_FIRST]);
+}
+
+#endif
@@ -0,0 +1,88 @@
+#include "jsonwriter.h"
+
+JsonWriter::JsonWriter(char* b, size_t s) :
+  buf(b),
+  size(s),
+  len(0),
+  overflow(false),
+  needComma(false) {
+  if (size > 0) buf[0] = '\0';
+}
+
+void JsonWriter::put(char c) {
+  if (len + 1 >= size) {
+    overflow = true;
+    return;
+  }
+  buf[len++] = c;
+  buf[len] = '\0';
+}
+
+void JsonWriter::raw(const char* s) {
+  while (*s) put(*s++);
+}
+
+void JsonWriter::separate() {
+  if (needComma) put(',');
+  needComma = false;
+}
+
+void JsonWriter::beginObject() {
+  separate();
+  put('{');
+}
+
+void JsonWriter::endObject() {
+  put('}');
+  needComma = true;
+}
+
+void JsonWriter::beginArray() {
+  separate();
+  put('[');
+}
+
+void JsonWriter::endArray() {
+  put(']');
+  needComma = true;
+}
+
+void JsonWriter::key(const char* name) {
+  string(name);
+  put(':');
+  needComma = false;
+}
+
+void JsonWriter::string(const char* value) {
+  separate();
+  put('"');
+  for (const char* p = value; *p; p++) {
+    char c = *p;
+    if (c == '"' || c == '\\') {
+      put('\\');
+      put(c);
+    } else if ((uint8_t)c < 0x20) {
+      char escaped[7];
+      snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      raw(escaped);
+    } else {
+      put(c);
+    }
+  }
+  put('"');
+  needComma = true;
+}
+
+void JsonWriter::number(long value) {
+  separate();
+  char digits[12];
+  snprintf(digits, sizeof(digits), "%ld", value);
+  raw(digits);
+  needComma = true;
+}
+
+void JsonWriter::boolean(bool value) {
+  separate();
+  raw(value ? "true" : "false");
+  needComma = true;
+}
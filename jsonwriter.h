@@ -0,0 +1,41 @@
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+
+#include <Arduino.h>
+
+// Minimal JSON serializer into a caller-supplied fixed buffer. Output that
+// doesn't fit sets the overflow flag instead of growing anything.
+class JsonWriter {
+public:
+  JsonWriter(char* buf, size_t size);
+  void beginObject();
+  void endObject();
+  void beginArray();
+  void endArray();
+  void key(const char* name);
+  void string(const char* value);
+  void number(long value);
+  void boolean(bool value);
+  
+  // Shorthands for "name": value inside an object
+  void field(const char* name, const char* value) { key(name); string(value); }
+  void field(const char* name, long value) { key(name); number(value); }
+  void fieldBool(const char* name, bool value) { key(name); boolean(value); }
+  
+  const char* c_str() { return buf; }
+  size_t length() { return len; }
+  bool overflowed() { return overflow; }
+  
+private:
+  void put(char c);
+  void raw(const char* s);
+  void separate();
+  
+  char* buf;
+  size_t size;
+  size_t len;
+  bool overflow;
+  bool needComma;
+};
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef MATRIXDRIVER_H
+#define MATRIXDRIVER_H
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <MD_MAX72XX.h>
+
+// Frame output for a MAX7219 chain, specialized at compile time for the
+// module wiring and chain length. MD_MAX72XX checks the wiring flags on
+// every pixel it sets; here they pick constexpr remap tables and the
+// compiler folds the rest, so a frame goes to SPI without branching on the
+// hardware type. MD_MAX72XX still initializes the chain and sets intensity.
+
+// How a module connects its LEDs to the MAX7219, as MD_MAX72XX describes it
+struct ModuleWiring {
+  bool supported;
+  bool digitRows;       // A digit register drives a row, not a column
+  bool reverseColumns;  // Register bits run left to right
+  bool reverseRows;     // Digits run bottom to top
+};
+
+constexpr ModuleWiring moduleWiring(MD_MAX72XX::moduleType_t type) {
+  return type == MD_MAX72XX::FC16_HW      ? ModuleWiring{ true, true, false, false } :
+         type == MD_MAX72XX::PAROLA_HW    ? ModuleWiring{ true, true, true, false } :
+         type == MD_MAX72XX::GENERIC_HW   ? ModuleWiring{ true, false, true, false } :
+         type == MD_MAX72XX::ICSTATION_HW ? ModuleWiring{ true, true, true, true } :
+                                            ModuleWiring{ false, false, false, false };
+}
+
+// Row byte -> register bits, for wirings with reversed columns
+struct ColumnMap {
+  uint8_t bits[256];
+};
+
+constexpr ColumnMap buildColumnMap() {
+  ColumnMap map = {};
+  for (int value = 0; value < 256; value++) {
+    uint8_t bits = 0;
+    for (uint8_t c = 0; c < 8; c++) {
+      if (value & (1 << c)) bits |= 1 << (7 - c);
+    }
+    map.bits[value] = bits;
+  }
+  return map;
+}
+
+// In flash, read with pgm_read_byte(). Outside the template, since GCC
+// drops the section attribute of a template's static members.
+constexpr ColumnMap REVERSED_COLUMNS PROGMEM = buildColumnMap();
+
+// Row -> bit offset of its digit in a device's packed 64-bit register image
+struct RowMap {
+  uint8_t shift[8];
+};
+
+constexpr RowMap buildRowMap(bool reverse) {
+  RowMap map = {};
+  for (uint8_t row = 0; row < 8; row++) {
+    map.shift[row] = (reverse ? 7 - row : row) * 8;
+  }
+  return map;
+}
+
+// 8x8 bit matrix transpose: bit c of byte r moves to bit r of byte c
+inline uint64_t transposeBits(uint64_t x) {
+  uint64_t t;
+  t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+  x ^= t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+  x ^= t ^ (t << 14);
+  t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+  x ^= t ^ (t << 28);
+  return x;
+}
+
+template <MD_MAX72XX::moduleType_t HARDWARE, uint8_t DEVICES, uint8_t CS>
+class MatrixDriver {
+public:
+  static constexpr ModuleWiring WIRING = moduleWiring(HARDWARE);
+  static_assert(WIRING.supported, "HARDWARE_TYPE must be FC16_HW, PAROLA_HW, GENERIC_HW or ICSTATION_HW");
+
+  // Turns one device's rows (bit c = column c from the right, as the
+  // framebuffer and MD_MAX72XX count them) into its digit registers
+  static void remap(const uint8_t* rows, uint8_t* digits) {
+    uint64_t image = 0;
+    for (uint8_t row = 0; row < 8; row++) {
+      uint8_t bits = WIRING.reverseColumns ? pgm_read_byte(&REVERSED_COLUMNS.bits[rows[row]]) : rows[row];
+      image |= (uint64_t)bits << ROWS.shift[row];
+    }
+    // Column-wired modules hold the same image transposed
+    if (!WIRING.digitRows) image = transposeBits(image);
+    for (uint8_t digit = 0; digit < 8; digit++) {
+      digits[digit] = image >> (digit * 8);
+    }
+  }
+
+  // Latches one digit register on every device of the chain in a single
+  // SPI transaction; registers[device][digit] come from remap()
+  static void writeDigit(uint8_t digit, const uint8_t (*registers)[8]) {
+    uint8_t frame[DEVICES * 2];
+    // The first pair shifted out ends up in the farthest device
+    for (uint8_t device = 0; device < DEVICES; device++) {
+      frame[(DEVICES - 1 - device) * 2] = OP_DIGIT0 + digit;
+      frame[(DEVICES - 1 - device) * 2 + 1] = registers[device][digit];
+    }
+    SPI.beginTransaction(SPISettings(SPI_CLOCK, MSBFIRST, SPI_MODE0));
+    digitalWrite(CS, LOW);
+    SPI.writeBytes(frame, sizeof(frame));
+    digitalWrite(CS, HIGH);
+    SPI.endTransaction();
+  }
+
+private:
+  static const uint8_t OP_DIGIT0 = 1;
+  static const uint32_t SPI_CLOCK = 8000000;  // Same as MD_MAX72XX; the MAX7219 takes up to 10 MHz
+  static constexpr RowMap ROWS = buildRowMap(WIRING.reverseRows);
+};
+
+template <MD_MAX72XX::moduleType_t HARDWARE, uint8_t DEVICES, uint8_t CS>
+constexpr ModuleWiring MatrixDriver<HARDWARE, DEVICES, CS>::WIRING;
+template <MD_MAX72XX::moduleType_t HARDWARE, uint8_t DEVICES, uint8_t CS>
+constexpr RowMap MatrixDriver<HARDWARE, DEVICES, CS>::ROWS;
+
+#endif
@@ -0,0 +1,77 @@
+#include "metrics.h"
+
+#if METRICS_ENABLED
+
+static LatencyHistogram loopHistogram;
+static LatencyHistogram httpHistogram;
+static LatencyHistogram frameHistogram;
+static PushHistogram pushHistogram;
+static uint64_t stateMillis[DISPLAY_STATE_COUNT];
+static DisplayState lastState = SHOW_TZ_SCROLL;
+static unsigned long lastStateChange = 0;
+
+static void record(LatencyHistogram& histogram, unsigned long micros) {
+  // Bucket n holds 64 << (n - 1) < micros <= 64 << n
+  uint8_t bucket = 0;
+  uint32_t bound = metricsBucketBound(0);
+  while (bucket < METRICS_BUCKETS && micros > bound) {
+    bucket++;
+    bound <<= 1;
+  }
+  histogram.buckets[bucket]++;
+  histogram.count++;
+  histogram.sumMicros += micros;
+}
+
+void metricsLoopCost(unsigned long busyMicros) {
+  record(loopHistogram, busyMicros);
+}
+
+void metricsHandleClient(unsigned long micros) {
+  record(httpHistogram, micros);
+}
+
+void metricsFrameLateness(unsigned long micros) {
+  record(frameHistogram, micros);
+}
+
+void metricsFramePush(uint8_t rows, uint16_t bytes) {
+  if (rows > MATRIX_ROWS) rows = MATRIX_ROWS;
+  pushHistogram.rows[rows]++;
+  pushHistogram.count++;
+  pushHistogram.rowSum += rows;
+  pushHistogram.byteSum += bytes;
+}
+
+void metricsDisplayState(DisplayState state) {
+  // Time since the last call goes to the state that was current during it
+  unsigned long now = millis();
+  stateMillis[lastState] += now - lastStateChange;
+  lastStateChange = now;
+  lastState = state;
+}
+
+const LatencyHistogram& metricsLoopHistogram() {
+  return loopHistogram;
+}
+
+const LatencyHistogram& metricsHttpHistogram() {
+  return httpHistogram;
+}
+
+const LatencyHistogram& metricsFrameHistogram() {
+  return frameHistogram;
+}
+
+const PushHistogram& metricsPushHistogram() {
+  return pushHistogram;
+}
+
+uint64_t metricsStateMillis(DisplayState state) {
+  // Include the running interval so the current state doesn't lag
+  uint64_t total = stateMillis[state];
+  if (state == lastState) total += millis() - lastStateChange;
+  return total;
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "display.h"
+
+// Hot-path counters for /metrics, compiled in with METRICS_ENABLED. All
+// storage is static; recording is a few adds. Counters that other modules
+// already keep (NTP, settings store, frames, events) are read from them
+// when /metrics is served instead of being duplicated here.
+
+// Latency histogram buckets: upper bounds of 64 us << n, then +Inf
+const uint8_t METRICS_BUCKETS = 12;
+const uint8_t DISPLAY_STATE_COUNT = SHOW_ZONES + 1;
+
+struct LatencyHistogram {
+  uint32_t buckets[METRICS_BUCKETS + 1];  // Per bucket, not cumulative; last is +Inf
+  uint32_t count;
+  uint64_t sumMicros;
+};
+
+inline uint32_t metricsBucketBound(uint8_t bucket) { return 64UL << bucket; }
+
+// Digit rows each frame push sent, one bucket per row count. A row costs
+// the same bytes on every push (an opcode and data byte per device), so
+// the byte histogram is this one scaled.
+struct PushHistogram {
+  uint32_t rows[MATRIX_ROWS + 1];
+  uint32_t count;
+  uint64_t rowSum;
+  uint64_t byteSum;
+};
+
+#if METRICS_ENABLED
+void metricsLoopCost(unsigned long busyMicros);
+void metricsHandleClient(unsigned long micros);
+void metricsDisplayState(DisplayState state);
+void metricsFrameLateness(unsigned long micros);
+void metricsFramePush(uint8_t rows, uint16_t bytes);
+const LatencyHistogram& metricsLoopHistogram();
+const LatencyHistogram& metricsHttpHistogram();
+const LatencyHistogram& metricsFrameHistogram();
+const PushHistogram& metricsPushHistogram();
+uint64_t metricsStateMillis(DisplayState state);
+#else
+inline void metricsLoopCost(unsigned long) {}
+inline void metricsHandleClient(unsigned long) {}
+inline void metricsDisplayState(DisplayState) {}
+inline void metricsFrameLateness(unsigned long) {}
+inline void metricsFramePush(uint8_t, uint16_t) {}
+#endif
+
+#endif
@@ -0,0 +1,319 @@
+#include "ntpclock.h"
+#include <ESP8266WiFi.h>
+#include <limits.h>
+#include <coredecls.h>
+extern "C" {
+#include <user_interface.h>
+}
+
+static const uint16_t NTP_PORT = 123;
+static const uint8_t NTP_PACKET_SIZE = 48;
+static const uint32_t NTP_UNIX_OFFSET = 2208988800UL; // 1900-01-01 to 1970-01-01 in seconds
+
+static const int64_t STEP_THRESHOLD = 1000000;  // Offsets above 1 s are stepped, not slewed
+static const uint8_t SLEW_DIVISOR = 20;         // Slew at most 1/20 of the elapsed time
+static const long SETTLED_OFFSET = 20000;       // us; smaller offsets lengthen the poll interval
+static const long UNSETTLED_OFFSET = 100000;    // us; larger offsets shorten it
+static const long MAX_DRIFT = 500000;           // ppb
+
+static const uint32_t RTC_SNAPSHOT_MAGIC = 0x4e54504b; // "NTPK"
+static const uint64_t RTC_RESTORE_MAX_GAP = 3600000000ULL; // us
+
+// Kept in RTC user memory; the RTC cycle counter keeps running through a
+// reset, which tells how long the chip was down
+struct RtcClockSnapshot {
+  uint32_t magic;
+  uint32_t rtcCycles;      // system_get_rtc_time() when saved
+  uint64_t clockMicros;
+  int32_t driftPpb;
+  uint32_t crc;
+};
+
+static uint64_t fromNtpTimestamp(const uint8_t* p) {
+  uint32_t seconds = (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+  uint32_t fraction = (uint32_t)p[4] << 24 | (uint32_t)p[5] << 16 | (uint32_t)p[6] << 8 | p[7];
+  return (uint64_t)(seconds - NTP_UNIX_OFFSET) * 1000000 + (((uint64_t)fraction * 1000000) >> 32);
+}
+
+static void toNtpTimestamp(uint64_t micros, uint32_t stamp[2]) {
+  stamp[0] = (uint32_t)(micros / 1000000) + NTP_UNIX_OFFSET;
+  stamp[1] = (uint32_t)((((uint64_t)(micros % 1000000)) << 32) / 1000000);
+}
+
+NtpClock::NtpClock(WiFiUDP& u, const char* srv) :
+  udp(u),
+  server(srv),
+  dnsMillis(0),
+  resolved(false),
+  state(NTP_IDLE),
+  clockMicros(0),
+  lastMicros(0),
+  driftResidual(0),
+  slewRemaining(0),
+  driftPpb(0),
+  synced(false),
+  restored(false),
+  external(false),
+  requestSent(0),
+  requestMillis(0),
+  lastSync(0),
+  lastSyncValid(false),
+  pollInterval(NTP_MIN_POLL),
+  nextPoll(0),
+  requestCount(0),
+  replyCount(0),
+  timeoutCount(0),
+  stepCount(0),
+  lastOffset(0),
+  lastDelay(0) {
+  requestStamp[0] = requestStamp[1] = 0;
+  dnsAddr = {};
+}
+
+void NtpClock::begin() {
+  udp.begin(NTP_LOCAL_PORT);
+  lastMicros = micros();
+  nextPoll = millis();
+}
+
+void NtpClock::setExternalSource(bool active) {
+  if (active == external) return;
+  external = active;
+  // Back to NTP right away when the leader goes
+  if (!active) nextPoll = millis();
+}
+
+bool NtpClock::restore() {
+  RtcClockSnapshot snapshot;
+  if (!ESP.rtcUserMemoryRead(RTC_SNAPSHOT_OFFSET, (uint32_t*)&snapshot, sizeof(snapshot))) return false;
+  if (snapshot.magic != RTC_SNAPSHOT_MAGIC ||
+      snapshot.crc != crc32(&snapshot, offsetof(RtcClockSnapshot, crc))) {
+    // Power-on: RTC memory holds noise
+    return false;
+  }
+  
+  // Time since the snapshot, from the RTC counter (period in 1/4096 us).
+  // A gap shorter than the uptime or implausibly long means the counter was
+  // reset too; then all we know is the time since boot.
+  uint32_t cycles = system_get_rtc_time() - snapshot.rtcCycles;
+  uint64_t gap = ((uint64_t)cycles * system_rtc_clock_cali_proc()) >> 12;
+  uint64_t uptime = micros();
+  if (gap < uptime || gap > RTC_RESTORE_MAX_GAP) {
+    gap = uptime;
+  }
+  
+  clockMicros = snapshot.clockMicros + gap;
+  lastMicros = micros();
+  driftPpb = snapshot.driftPpb;
+  restored = true;
+  return true;
+}
+
+void NtpClock::save() {
+  if (!hasTime()) return;
+  RtcClockSnapshot snapshot;
+  snapshot.magic = RTC_SNAPSHOT_MAGIC;
+  snapshot.clockMicros = nowMicros();
+  snapshot.rtcCycles = system_get_rtc_time();
+  snapshot.driftPpb = driftPpb;
+  snapshot.crc = crc32(&snapshot, offsetof(RtcClockSnapshot, crc));
+  ESP.rtcUserMemoryWrite(RTC_SNAPSHOT_OFFSET, (uint32_t*)&snapshot, sizeof(snapshot));
+}
+
+void NtpClock::advance() {
+  unsigned long nowUs = micros();
+  uint32_t elapsed = (uint32_t)(nowUs - lastMicros);
+  lastMicros = nowUs;
+  
+  // Frequency correction, keeping the sub-microsecond remainder
+  driftResidual += (int64_t)elapsed * driftPpb;
+  int64_t correction = driftResidual / 1000000000;
+  driftResidual -= correction * 1000000000;
+  
+  // Slew the outstanding offset in at a bounded rate so the clock never jumps
+  int64_t maxSlew = elapsed / SLEW_DIVISOR;
+  int64_t slew = slewRemaining;
+  if (slew > maxSlew) slew = maxSlew;
+  if (slew < -maxSlew) slew = -maxSlew;
+  slewRemaining -= slew;
+  
+  clockMicros += elapsed + correction + slew;
+}
+
+uint64_t NtpClock::nowMicros() {
+  advance();
+  return clockMicros;
+}
+
+void NtpClock::sendRequest() {
+  uint8_t packet[NTP_PACKET_SIZE];
+  memset(packet, 0, sizeof(packet));
+  packet[0] = 0x23; // LI 0, version 4, mode 3 (client)
+  
+  // Our transmit time comes back as the originate timestamp of the reply
+  requestSent = nowMicros();
+  toNtpTimestamp(requestSent, requestStamp);
+  for (uint8_t i = 0; i < 4; i++) {
+    packet[40 + i] = requestStamp[0] >> (24 - 8 * i);
+    packet[44 + i] = requestStamp[1] >> (24 - 8 * i);
+  }
+  
+  udp.beginPacket(serverIP, NTP_PORT);
+  udp.write(packet, sizeof(packet));
+  udp.endPacket();
+  requestMillis = millis();
+  requestCount++;
+}
+
+bool NtpClock::readReply() {
+  uint8_t packet[NTP_PACKET_SIZE];
+  while (udp.parsePacket() > 0) {
+    uint64_t received = nowMicros();
+    if (udp.read(packet, sizeof(packet)) < NTP_PACKET_SIZE) continue;
+    
+    // Server mode, synchronized, and answering our request (not a stale one)
+    if ((packet[0] & 0x07) != 4 || packet[1] == 0) continue;
+    bool matches = true;
+    for (uint8_t i = 0; i < 4; i++) {
+      matches &= packet[24 + i] == (uint8_t)(requestStamp[0] >> (24 - 8 * i));
+      matches &= packet[28 + i] == (uint8_t)(requestStamp[1] >> (24 - 8 * i));
+    }
+    if (!matches) continue;
+    
+    int64_t serverReceived = fromNtpTimestamp(packet + 32);
+    int64_t serverSent = fromNtpTimestamp(packet + 40);
+    int64_t offset = ((serverReceived - (int64_t)requestSent) + (serverSent - (int64_t)received)) / 2;
+    int64_t delay = ((int64_t)received - (int64_t)requestSent) - (serverSent - serverReceived);
+    
+    replyCount++;
+    lastDelay = (long)delay;
+    discipline(offset);
+    return true;
+  }
+  return false;
+}
+
+void NtpClock::discipline(int64_t offset) {
+  lastOffset = offset > LONG_MAX ? LONG_MAX : (offset < LONG_MIN ? LONG_MIN : (long)offset);
+  
+  if (!hasTime() || offset > STEP_THRESHOLD || offset < -STEP_THRESHOLD) {
+    // First sync or a large error: step, and restart the drift estimate
+    clockMicros += offset;
+    slewRemaining = 0;
+    synced = true;
+    restored = false;
+    lastSyncValid = false;
+    pollInterval = NTP_MIN_POLL;
+    stepCount++;
+    return;
+  }
+  
+  // What is left after the previous slew is frequency error accumulated
+  // over the interval; fold half of it into the drift estimate
+  uint64_t nowUs = clockMicros;
+  if (lastSyncValid && nowUs > lastSync) {
+    long measured = (long)(offset * 1000000000 / (int64_t)(nowUs - lastSync));
+    driftPpb += measured / 2;
+    if (driftPpb > MAX_DRIFT) driftPpb = MAX_DRIFT;
+    if (driftPpb < -MAX_DRIFT) driftPpb = -MAX_DRIFT;
+  }
+  // A restored clock close enough to slew is corrected in place
+  synced = true;
+  restored = false;
+  slewRemaining = offset;
+  lastSync = nowUs;
+  lastSyncValid = true;
+  
+  // Back off while the estimate holds, tighten up when it doesn't
+  long magnitude = lastOffset < 0 ? -lastOffset : lastOffset;
+  if (magnitude < SETTLED_OFFSET && pollInterval < NTP_MAX_POLL) {
+    pollInterval *= 2;
+    if (pollInterval > NTP_MAX_POLL) pollInterval = NTP_MAX_POLL;
+  } else if (magnitude > UNSETTLED_OFFSET && pollInterval > NTP_MIN_POLL) {
+    pollInterval /= 2;
+    if (pollInterval < NTP_MIN_POLL) pollInterval = NTP_MIN_POLL;
+  }
+}
+
+void NtpClock::dnsFound(const char*, const ip_addr_t* ipaddr, void* arg) {
+  // Called from lwIP between loop() passes; an answer after the lookup
+  // timed out is dropped
+  NtpClock* clock = (NtpClock*)arg;
+  if (clock->state != NTP_RESOLVING) return;
+  clock->state = NTP_IDLE;
+  if (ipaddr) {
+    clock->serverIP = IPAddress(ipaddr);
+    clock->resolved = true;
+    clock->nextPoll = millis();
+  } else {
+    clock->nextPoll = millis() + NTP_RETRY_INTERVAL;
+  }
+}
+
+void NtpClock::poll() {
+  advance();
+  unsigned long now = millis();
+  
+  if (state == NTP_WAITING) {
+    if (readReply()) {
+      state = NTP_IDLE;
+      nextPoll = now + pollInterval;
+    } else if (now - requestMillis >= NTP_REPLY_TIMEOUT) {
+      timeoutCount++;
+      resolved = false; // Pick another pool server next time
+      state = NTP_IDLE;
+      nextPoll = now + (synced ? NTP_RETRY_INTERVAL * 6 : NTP_RETRY_INTERVAL);
+    } else {
+      // Pick the reply up promptly; the delay adds to the measured round trip
+      nextPoll = now + NTP_REPLY_POLL;
+    }
+    return;
+  }
+  
+  if (state == NTP_RESOLVING) {
+    // dnsFound() ends the lookup; until then check on it like on a reply
+    if (now - dnsMillis >= NTP_DNS_TIMEOUT) {
+      state = NTP_IDLE;
+      nextPoll = now + NTP_RETRY_INTERVAL;
+    } else {
+      nextPoll = now + NTP_REPLY_POLL;
+    }
+    return;
+  }
+  
+  if ((long)(now - nextPoll) < 0) return;
+  
+  if (external) {
+    nextPoll = now + NTP_RETRY_INTERVAL;
+    return;
+  }
+  if (WiFi.status() != WL_CONNECTED) {
+    nextPoll = now + NTP_RETRY_INTERVAL;
+    return;
+  }
+  if (!resolved) {
+    // Looked up on the first request and after a timeout. A cached answer
+    // comes back at once; otherwise dnsFound() gets it later.
+    dnsMillis = now;
+    err_t err = dns_gethostbyname(server, &dnsAddr, dnsFound, this);
+    if (err == ERR_INPROGRESS) {
+      state = NTP_RESOLVING;
+      nextPoll = now + NTP_REPLY_POLL;
+      return;
+    }
+    if (err != ERR_OK) {
+      nextPoll = now + NTP_RETRY_INTERVAL;
+      return;
+    }
+    serverIP = IPAddress(&dnsAddr);
+    resolved = true;
+  }
+  
+  // Drop anything left over from an earlier request
+  while (udp.parsePacket() > 0) {
+    udp.flush();
+  }
+  sendRequest();
+  state = NTP_WAITING;
+  nextPoll = millis() + NTP_REPLY_POLL;
+}
@@ -0,0 +1,94 @@
+#ifndef NTPCLOCK_H
+#define NTPCLOCK_H
+
+#include <Arduino.h>
+#include <WiFiUdp.h>
+#include <lwip/dns.h>
+#include "config.h"
+
+enum NtpState {
+  NTP_IDLE,       // Waiting for the next poll
+  NTP_RESOLVING,  // DNS lookup of the server in flight
+  NTP_WAITING     // Request sent, reply not picked up yet
+};
+
+// Asynchronous SNTP client driving a disciplined local clock. The server
+// name is resolved through lwIP's callback API, requests are sent from one
+// poll() and the reply is picked up on a later one, so nothing blocks. Offsets
+// are slewed out gradually, the crystal drift is estimated from successive
+// offsets, and the poll interval backs off as the estimate settles.
+class NtpClock {
+public:
+  NtpClock(WiFiUDP& udp, const char* server);
+  void begin();
+  void poll();
+  unsigned long getNextDeadline() { return nextPoll; }
+  
+  bool isSynced() { return synced; }
+  bool isRestored() { return restored; }
+  bool hasTime() { return synced || restored; }
+  
+  // Time from a fleet leader (fleetsync.h) instead of NTP; no requests are
+  // sent while it is set
+  void setExternalSource(bool active);
+  void applyExternalOffset(int64_t offset) { discipline(offset); }
+  
+  // Carry the clock across resets in RTC user memory
+  bool restore();
+  void save();
+  uint64_t nowMicros();
+  uint64_t nowMillis() { return nowMicros() / 1000; }
+  time_t now() { return (time_t)(nowMicros() / 1000000); }
+  
+  // Statistics
+  unsigned long getRequestCount() { return requestCount; }
+  unsigned long getReplyCount() { return replyCount; }
+  unsigned long getTimeoutCount() { return timeoutCount; }
+  unsigned long getStepCount() { return stepCount; }
+  long getLastOffset() { return lastOffset; }       // us
+  long getLastDelay() { return lastDelay; }         // us, round trip
+  long getDrift() { return driftPpb; }              // ppb, positive = crystal slow
+  unsigned long getPollInterval() { return pollInterval; }
+  
+private:
+  void advance();
+  void sendRequest();
+  bool readReply();
+  void discipline(int64_t offset);
+  static void dnsFound(const char* name, const ip_addr_t* ipaddr, void* arg);
+  
+  WiFiUDP& udp;
+  const char* server;
+  IPAddress serverIP;
+  ip_addr_t dnsAddr;       // Filled in by lwIP when the answer is cached
+  unsigned long dnsMillis; // When the lookup started
+  bool resolved;
+  NtpState state;
+  
+  // Local clock in microseconds since the Unix epoch
+  uint64_t clockMicros;
+  unsigned long lastMicros;
+  int64_t driftResidual;   // Fraction of a microsecond, in 1e-9 us
+  int64_t slewRemaining;   // us still to be slewed into the clock
+  long driftPpb;
+  bool synced;
+  bool restored;           // Running from an RTC snapshot, not yet confirmed by NTP
+  bool external;           // Disciplined by a fleet leader, NTP paused
+  
+  uint64_t requestSent;    // Local clock when the request went out
+  uint32_t requestStamp[2];
+  unsigned long requestMillis;
+  uint64_t lastSync;       // Local clock at the last slewed (not stepped) sync
+  bool lastSyncValid;
+  unsigned long pollInterval;
+  unsigned long nextPoll;
+  
+  unsigned long requestCount;
+  unsigned long replyCount;
+  unsigned long timeoutCount;
+  unsigned long stepCount;
+  long lastOffset;
+  long lastDelay;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef ROTATIONRING_H
+#define ROTATIONRING_H
+
+#include <Arduino.h>
+
+// Enabled entries of a catalog of N as a bitset, and the order they are
+// shown in as a ring. build() does the work when the selection changes, so
+// counting and stepping are lookups however large the catalog is.
+template <int N>
+class RotationRing {
+public:
+  RotationRing() : length(0) {
+    clear();
+    build((const uint8_t*)NULL);
+  }
+
+  void clear() { memset(bits, 0, sizeof(bits)); }
+  void enable(int index) { bits[index >> 5] |= 1UL << (index & 31); }
+  bool isEnabled(int index) const {
+    return index >= 0 && index < N && (bits[index >> 5] & (1UL << (index & 31)));
+  }
+  int getLength() const { return length; }
+
+  // Entries follow the given order of N indexes; duplicates and out-of-range
+  // entries are skipped, and enabled entries missing from it go last in
+  // catalog order. A null order is catalog order.
+  template <typename Index>
+  void build(const Index* order) {
+    for (int i = 0; i < N; i++) {
+      slot[i] = -1;
+    }
+    length = 0;
+    for (int i = 0; order && i < N; i++) {
+      int index = order[i];
+      if (isEnabled(index) && slot[index] < 0) add(index);
+    }
+    for (int index = 0; index < N; index++) {
+      if (isEnabled(index) && slot[index] < 0) add(index);
+    }
+  }
+
+  // The entry after start; one outside the ring (none yet, or just
+  // disabled) restarts it
+  int next(int start) const {
+    if (length == 0) return start;
+    int at = start >= 0 && start < N ? slot[start] : -1;
+    if (at < 0 || at + 1 == length) return ring[0];
+    return ring[at + 1];
+  }
+
+private:
+  void add(int index) {
+    slot[index] = length;
+    ring[length++] = index;
+  }
+
+  uint32_t bits[(N + 31) / 32];
+  int16_t ring[N];   // Enabled entries in display order
+  int16_t slot[N];   // Each entry's position in ring, -1 if off
+  int16_t length;
+};
+
+#endif
@@ -0,0 +1,67 @@
+#include "scheduler.h"
+
+const char* taskName(TaskId task) {
+  static const char* const TASK_NAMES[] = {
+    "wifi", "web", "ntp", "display", "minute", "dwell", "snapshot", "fleet"
+  };
+  return TASK_NAMES[task];
+}
+
+Scheduler::Scheduler() : wakeups(0) {
+  for (int i = 0; i < TASK_COUNT; i++) {
+    deadlines[i] = 0;
+    armed[i] = false;
+  }
+  memset(jitter, 0, sizeof(jitter));
+  memset(lateMillis, 0, sizeof(lateMillis));
+}
+
+void Scheduler::setDeadline(TaskId task, unsigned long at) {
+  deadlines[task] = at;
+  armed[task] = true;
+}
+
+void Scheduler::cancel(TaskId task) {
+  armed[task] = false;
+}
+
+bool Scheduler::isDue(TaskId task, unsigned long now) {
+  if (!armed[task]) return false;
+  long late = (long)(now - deadlines[task]);
+  if (late < 0) return false;
+  
+  // Record how late the task runs compared to its deadline
+  lateMillis[task] += late;
+  uint8_t bucket = 0;
+  while (late > 0 && bucket < JITTER_BUCKETS - 1) {
+    late >>= 1;
+    bucket++;
+  }
+  jitter[task][bucket]++;
+  armed[task] = false;
+  return true;
+}
+
+void Scheduler::sleepUntilNextDeadline() {
+  unsigned long now = millis();
+  long earliest = -1;
+  for (int i = 0; i < TASK_COUNT; i++) {
+    if (!armed[i]) continue;
+    long remaining = (long)(deadlines[i] - now);
+    if (remaining <= 0) {
+      earliest = 0;
+      break;
+    }
+    if (earliest < 0 || remaining < earliest) {
+      earliest = remaining;
+    }
+  }
+  
+  // delay() yields to the WiFi stack; zero still lets it run once
+  if (earliest > 0) {
+    delay(earliest);
+  } else {
+    yield();
+  }
+  wakeups++;
+}
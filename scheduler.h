@@ -0,0 +1,45 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+
+enum TaskId {
+  TASK_WIFI,      // WiFi connection and configuration portal
+  TASK_WEB,       // Poll the HTTP server
+  TASK_NTP,       // Poll the NTP client
+  TASK_DISPLAY,   // Next animation frame, colon blink or end of the wait pause
+  TASK_MINUTE,    // Minute rollover in single timezone mode
+  TASK_DWELL,     // End of the time display duration in multi timezone mode
+  TASK_SNAPSHOT,  // Save the clock to RTC memory for a fast boot after a reset
+  TASK_FLEET,     // Send or pick up fleet beacons
+  TASK_COUNT
+};
+
+// Lateness histogram buckets: 0, 1, 2-3, 4-7, 8-15, 16-31, 32-63, 64+ ms
+const uint8_t JITTER_BUCKETS = 8;
+
+const char* taskName(TaskId task);
+
+// Cooperative scheduler: every subsystem registers the millis() deadline it
+// next needs attention at, and loop() sleeps until the earliest one.
+class Scheduler {
+public:
+  Scheduler();
+  void setDeadline(TaskId task, unsigned long at);
+  void cancel(TaskId task);
+  bool isDue(TaskId task, unsigned long now);
+  void sleepUntilNextDeadline();
+  
+  unsigned long getWakeups() { return wakeups; }
+  unsigned long getJitterCount(TaskId task, uint8_t bucket) { return bucket < JITTER_BUCKETS ? jitter[task][bucket] : 0; }
+  unsigned long getLateMillis(TaskId task) { return lateMillis[task]; }  // Summed over every run
+  
+private:
+  unsigned long deadlines[TASK_COUNT];
+  bool armed[TASK_COUNT];
+  unsigned long wakeups;
+  unsigned long jitter[TASK_COUNT][JITTER_BUCKETS];
+  unsigned long lateMillis[TASK_COUNT];
+};
+
+#endif
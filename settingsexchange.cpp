@@ -0,0 +1,29 @@
+#include "settingsexchange.h"
+
+SettingsExchange::SettingsExchange() : writing(0), published(0), acquired(0) {
+  memset(slots, 0, sizeof(slots));
+}
+
+void SettingsExchange::publish(const Settings& settings) {
+  uint32_t version = published + 1;
+  writing = version;
+  __sync_synchronize();
+  slots[version & 1] = settings;
+  __sync_synchronize();
+  published = version;
+}
+
+bool SettingsExchange::acquire(Settings& settings) {
+  while (true) {
+    uint32_t version = published;
+    if (version == acquired) return false;
+    __sync_synchronize();
+    settings = slots[version & 1];
+    __sync_synchronize();
+    // Only a writer two versions ahead reuses the slot just copied
+    if (writing - version < 2) {
+      acquired = version;
+      return true;
+    }
+  }
+}
@@ -0,0 +1,26 @@
+#ifndef SETTINGSEXCHANGE_H
+#define SETTINGSEXCHANGE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Single-producer/single-consumer hand-off of settings from the web handlers
+// to the display loop. Two slots alternate: a publish fills the slot the
+// reader is not on and then bumps the version, so the reader always copies
+// a complete snapshot. The reader decides when to look, which lets the
+// display loop take a save only between rotation steps.
+class SettingsExchange {
+public:
+  SettingsExchange();
+  void publish(const Settings& settings);
+  bool acquire(Settings& settings);
+  uint32_t getVersion() { return published; }
+  uint32_t getAcquired() { return acquired; }
+private:
+  Settings slots[2];          // Version v lives in slots[v & 1]
+  volatile uint32_t writing;  // Version the writer is filling in
+  volatile uint32_t published; // Newest complete version
+  uint32_t acquired;          // Version the reader last copied
+};
+
+#endif
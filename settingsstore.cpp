@@ -0,0 +1,362 @@
+#include "settingsstore.h"
+#include <EEPROM.h>
+#include <coredecls.h>
+#include <flash_hal.h>
+#include <stddef.h>
+
+static const uint32_t STORE_MAGIC = 0x53435a4d; // "MZCS"
+static const uint16_t HEADER_SIZE = 8;
+static const uint8_t RECORD_END = 0xFF;         // Erased flash
+static const uint8_t MAX_FIELD_SIZE = 32;
+
+// Record ids are stored in flash: never reuse or renumber them. A field
+// that is dropped keeps its id reserved and is skipped on replay.
+enum SettingsFieldId : uint8_t {
+  FIELD_SCHEMA = 0x01,
+  FIELD_ENABLED = 0x10,
+  FIELD_INTENSITY = 0x11,
+  FIELD_USE_12_HOUR = 0x12,
+  FIELD_DEBUG = 0x13,
+  FIELD_DURATION = 0x14,
+  FIELD_LAYOUT = 0x15,
+  FIELD_FLEET_ROLE = 0x16,
+  FIELD_ORDER = 0x17,
+  FIELD_ZONE_DWELL = 0x18
+};
+
+struct SettingsField {
+  uint8_t id;
+  uint8_t offset;
+  uint8_t size;
+};
+
+#define SETTINGS_FIELD(id, member) { id, offsetof(Settings, member), sizeof(((Settings*)0)->member) }
+
+static const SettingsField FIELDS[] = {
+  SETTINGS_FIELD(FIELD_ENABLED, enabled),
+  SETTINGS_FIELD(FIELD_INTENSITY, intensity),
+  SETTINGS_FIELD(FIELD_USE_12_HOUR, use12Hour),
+  SETTINGS_FIELD(FIELD_DEBUG, debugEnabled),
+  SETTINGS_FIELD(FIELD_DURATION, timeDisplayDuration),
+  SETTINGS_FIELD(FIELD_LAYOUT, layout),
+  SETTINGS_FIELD(FIELD_FLEET_ROLE, fleetRole),
+  SETTINGS_FIELD(FIELD_ORDER, order),
+  SETTINGS_FIELD(FIELD_ZONE_DWELL, dwell)
+};
+static const uint8_t FIELD_COUNT = sizeof(FIELDS) / sizeof(FIELDS[0]);
+
+static_assert(sizeof(((Settings*)0)->enabled) <= MAX_FIELD_SIZE, "Settings field too large for a record");
+static_assert(sizeof(((Settings*)0)->order) <= MAX_FIELD_SIZE, "Settings field too large for a record");
+static_assert(sizeof(((Settings*)0)->dwell) <= MAX_FIELD_SIZE, "Settings field too large for a record");
+
+// EEPROM image of the released firmware (EEPROM_MAGIC 0x42), before the
+// tz database and the settings store. Its six zone flags are catalog
+// indexes 0-5.
+struct LegacySettings {
+  uint8_t magic;
+  uint8_t enabled[6];
+  uint8_t intensity;
+  uint8_t use12Hour;
+  uint8_t debugEnabled;
+  uint16_t timeDisplayDuration;
+};
+
+// Snapshot kept by the EEPROM fallback, after the legacy image so that one
+// can still be migrated
+struct FallbackImage {
+  uint32_t magic;          // STORE_MAGIC
+  uint8_t schema;
+  uint8_t reserved;
+  uint16_t size;           // sizeof(Settings) when written
+  Settings settings;
+  uint32_t crc;
+};
+
+static const int FALLBACK_OFFSET = EEPROM_SIZE;
+
+static_assert(sizeof(LegacySettings) == 12 && offsetof(LegacySettings, timeDisplayDuration) == 10, "LegacySettings must match the released EEPROM image");
+static_assert(TZ_COUNT >= 6, "The catalog must keep the released firmware's six zone slots");
+
+static uint16_t crc16(uint16_t crc, const uint8_t* data, size_t length) {
+  // CRC-16/CCITT-FALSE, bitwise; records are a few bytes long
+  while (length--) {
+    crc ^= (uint16_t)*data++ << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+  }
+  return crc;
+}
+
+static uint16_t recordCrc(uint8_t id, uint8_t length, const uint8_t* data) {
+  uint8_t head[2] = { id, length };
+  return crc16(crc16(0xFFFF, head, 2), data, length);
+}
+
+static uint16_t paddedSize(uint8_t length) {
+  return 4 + ((length + 3) & ~3);
+}
+
+const char* storeModeName(StoreMode mode) {
+  return mode == STORE_EEPROM ? "eeprom" : "flash";
+}
+
+SettingsStore::SettingsStore() :
+  available(false),
+  mode(STORE_FLASH),
+  failedSaves(0),
+  activeSector(0),
+  generation(0),
+  writeOffset(HEADER_SIZE),
+  eraseCount(0),
+  recordCount(0) {
+  memset(&current, 0, sizeof(current));
+}
+
+uint32_t SettingsStore::sectorAddress(uint8_t sector) {
+  return FS_PHYS_ADDR + (uint32_t)sector * FLASH_SECTOR_SIZE;
+}
+
+bool SettingsStore::readHeader(uint8_t sector, uint32_t& gen) {
+  uint32_t header[2];
+  if (!ESP.flashRead(sectorAddress(sector), header, sizeof(header))) return false;
+  if (header[0] != STORE_MAGIC) return false;
+  gen = header[1];
+  return true;
+}
+
+bool SettingsStore::replay(uint8_t sector, Settings& settings, uint8_t& schema) {
+  uint32_t base = sectorAddress(sector);
+  uint32_t words[1 + MAX_FIELD_SIZE / 4];
+  uint8_t* record = (uint8_t*)words;
+  
+  writeOffset = HEADER_SIZE;
+  while (writeOffset + 4 <= FLASH_SECTOR_SIZE) {
+    if (!ESP.flashRead(base + writeOffset, words, 4)) return false;
+    uint8_t id = record[0];
+    uint8_t length = record[1];
+    uint16_t crc = record[2] | (record[3] << 8);
+    if (id == RECORD_END) return true;
+    
+    uint16_t size = paddedSize(length);
+    if (length > MAX_FIELD_SIZE || writeOffset + size > FLASH_SECTOR_SIZE ||
+        !ESP.flashRead(base + writeOffset + 4, words + 1, size - 4) ||
+        recordCrc(id, length, record + 4) != crc) {
+      // Torn write: nothing after it can be trusted or written over, so the
+      // sector counts as full and the next save compacts
+      writeOffset = FLASH_SECTOR_SIZE;
+      return true;
+    }
+    
+    if (id == FIELD_SCHEMA && length == 1) {
+      schema = record[4];
+    }
+    for (uint8_t i = 0; i < FIELD_COUNT; i++) {
+      if (FIELDS[i].id == id && FIELDS[i].size == length) {
+        memcpy((uint8_t*)&settings + FIELDS[i].offset, record + 4, length);
+      }
+    }
+    writeOffset += size;
+  }
+  return true;
+}
+
+bool SettingsStore::writeRecord(uint32_t address, uint8_t id, const void* data, uint8_t length, uint16_t& size) {
+  uint32_t words[1 + MAX_FIELD_SIZE / 4];
+  uint8_t* record = (uint8_t*)words;
+  size = paddedSize(length);
+  memset(record, 0xFF, size);
+  uint16_t crc = recordCrc(id, length, (const uint8_t*)data);
+  record[0] = id;
+  record[1] = length;
+  record[2] = crc & 0xFF;
+  record[3] = crc >> 8;
+  memcpy(record + 4, data, length);
+  return ESP.flashWrite(address, words, size);
+}
+
+bool SettingsStore::append(uint8_t id, const void* data, uint8_t length) {
+  if (writeOffset + paddedSize(length) > FLASH_SECTOR_SIZE) return false;
+  uint16_t size;
+  if (!writeRecord(sectorAddress(activeSector) + writeOffset, id, data, length, size)) {
+    // Part of the record may be programmed; treat the sector as full
+    writeOffset = FLASH_SECTOR_SIZE;
+    return false;
+  }
+  writeOffset += size;
+  recordCount++;
+  return true;
+}
+
+bool SettingsStore::compact() {
+  uint8_t next = (activeSector + 1) % SETTINGS_STORE_SECTORS;
+  uint32_t base = sectorAddress(next);
+  if (!ESP.flashEraseSector(base / FLASH_SECTOR_SIZE)) return false;
+  eraseCount++;
+  
+  // Snapshot first, header last
+  uint16_t offset = HEADER_SIZE;
+  uint16_t size;
+  uint8_t schema = SETTINGS_SCHEMA_VERSION;
+  if (!writeRecord(base + offset, FIELD_SCHEMA, &schema, 1, size)) return false;
+  offset += size;
+  for (uint8_t i = 0; i < FIELD_COUNT; i++) {
+    if (!writeRecord(base + offset, FIELDS[i].id, (uint8_t*)&current + FIELDS[i].offset, FIELDS[i].size, size)) return false;
+    offset += size;
+  }
+  
+  uint32_t header[2] = { STORE_MAGIC, generation + 1 };
+  if (!ESP.flashWrite(base, header, sizeof(header))) return false;
+  
+  activeSector = next;
+  generation++;
+  writeOffset = offset;
+  recordCount += FIELD_COUNT + 1;
+  return true;
+}
+
+void SettingsStore::migrate(Settings& settings, uint8_t fromVersion) {
+  // Each step upgrades one schema version; fall through to the current one
+  switch (fromVersion) {
+    case 0: {
+      // Version 0 is the whole-struct EEPROM image
+      LegacySettings legacy;
+      EEPROM.begin(EEPROM_SIZE);
+      EEPROM.get(0, legacy);
+      EEPROM.end();
+      if (legacy.magic == EEPROM_MAGIC) {
+        // Zones added since were not there to be enabled
+        for (uint8_t i = 0; i < TZ_COUNT; i++) {
+          settings.enabled[i] = i < 6 && legacy.enabled[i] ? 1 : 0;
+        }
+        settings.intensity = legacy.intensity;
+        settings.use12Hour = legacy.use12Hour;
+        settings.debugEnabled = legacy.debugEnabled;
+        if (legacy.timeDisplayDuration != 0) {
+          settings.timeDisplayDuration = legacy.timeDisplayDuration;
+        }
+      }
+    }
+    // fall through
+    default:
+      break;
+  }
+}
+
+bool SettingsStore::readFallback(Settings& settings) {
+  FallbackImage image;
+  EEPROM.begin(FALLBACK_OFFSET + sizeof(image));
+  EEPROM.get(FALLBACK_OFFSET, image);
+  EEPROM.end();
+  if (image.magic != STORE_MAGIC || image.schema != SETTINGS_SCHEMA_VERSION || image.size != sizeof(Settings) ||
+      image.crc != crc32(&image, offsetof(FallbackImage, crc))) {
+    return false;
+  }
+  settings = image.settings;
+  return true;
+}
+
+bool SettingsStore::writeFallback(const Settings& settings) {
+  FallbackImage image;
+  memset(&image, 0, sizeof(image));
+  image.magic = STORE_MAGIC;
+  image.schema = SETTINGS_SCHEMA_VERSION;
+  image.size = sizeof(Settings);
+  image.settings = settings;
+  image.crc = crc32(&image, offsetof(FallbackImage, crc));
+  EEPROM.begin(FALLBACK_OFFSET + sizeof(image));
+  EEPROM.put(FALLBACK_OFFSET, image);
+  return EEPROM.end();
+}
+
+bool SettingsStore::begin(Settings& settings) {
+  // settings holds the defaults; stored fields are replayed over them
+  if (FS_PHYS_SIZE < (uint32_t)SETTINGS_STORE_SECTORS * FLASH_SECTOR_SIZE) {
+    // No flash set aside for the journal: keep settings in the EEPROM
+    // sector, starting from the released image the first time
+    mode = STORE_EEPROM;
+    if (!readFallback(settings)) {
+      migrate(settings, 0);
+    }
+    current = settings;
+    return false;
+  }
+  mode = STORE_FLASH;
+  available = true;
+  
+  bool found = false;
+  for (uint8_t i = 0; i < SETTINGS_STORE_SECTORS; i++) {
+    uint32_t gen;
+    if (readHeader(i, gen) && (!found || (int32_t)(gen - generation) > 0)) {
+      found = true;
+      activeSector = i;
+      generation = gen;
+    }
+  }
+  
+  uint8_t schema = 0;
+  if (found && !replay(activeSector, settings, schema)) {
+    found = false;
+  }
+  if (!found) {
+    // Fresh flash or unreadable store: start the ring over at the last
+    // sector so the first snapshot lands in sector 0
+    activeSector = SETTINGS_STORE_SECTORS - 1;
+    generation = 0;
+    schema = 0;
+    if (readFallback(settings)) {
+      // Saved by the EEPROM fallback before the layout got an FS area
+      current = settings;
+      return compact();
+    }
+  }
+  
+  if (schema < SETTINGS_SCHEMA_VERSION) {
+    migrate(settings, schema);
+    current = settings;
+    return compact();
+  }
+  current = settings;
+  return true;
+}
+
+bool SettingsStore::save(const Settings& settings) {
+  if (mode == STORE_EEPROM) {
+    if (memcmp(&settings, &current, sizeof(settings)) == 0) return true;
+    if (!writeFallback(settings)) {
+      failedSaves++;
+      return false;
+    }
+    current = settings;
+    return true;
+  }
+  if (!available) return false;
+  
+  // Append only what changed; current follows what is in flash, so a
+  // field only counts as stored once its record is written
+  for (uint8_t i = 0; i < FIELD_COUNT; i++) {
+    const uint8_t* value = (const uint8_t*)&settings + FIELDS[i].offset;
+    uint8_t* stored = (uint8_t*)&current + FIELDS[i].offset;
+    if (memcmp(value, stored, FIELDS[i].size) == 0) continue;
+    if (append(FIELDS[i].id, value, FIELDS[i].size)) {
+      memcpy(stored, value, FIELDS[i].size);
+      continue;
+    }
+    // Full sector or failed write: the snapshot carries every field,
+    // including the rest of this save
+    Settings committed = current;
+    current = settings;
+    if (compact()) return true;
+    current = committed;
+    failedSaves++;
+    return false;
+  }
+  return true;
+}
+
+void SettingsStore::process() {
+  // Compact ahead of time so a save from the web handler rarely has to erase
+  if (available && writeOffset > SETTINGS_COMPACT_THRESHOLD) {
+    compact();
+  }
+}
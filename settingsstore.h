@@ -0,0 +1,64 @@
+#ifndef SETTINGSSTORE_H
+#define SETTINGSSTORE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Log-structured settings on raw flash. Every save appends only the fields
+// that changed, as CRC-checked records, to the active sector. When a sector
+// fills up, a snapshot of all fields goes into the next sector in the ring,
+// so erases rotate over SETTINGS_STORE_SECTORS instead of hitting one spot.
+//
+// Sector layout: 8-byte header {magic, generation}, then records of
+// {id, length, crc16} followed by data padded to 4 bytes. Erased flash
+// (id 0xFF) ends the log. The header is written after the snapshot, so a
+// compaction cut short by a reset leaves the previous sector active.
+//
+// A flash layout without an FS area falls back to a whole-struct snapshot
+// in the EEPROM sector, which costs a sector erase on every save.
+enum StoreMode {
+  STORE_FLASH,   // Journal in the FS area
+  STORE_EEPROM   // No FS area: snapshots in the EEPROM sector
+};
+
+const char* storeModeName(StoreMode mode);
+
+class SettingsStore {
+public:
+  SettingsStore();
+  // False when settings only reach the EEPROM fallback, or the journal
+  // could not be set up
+  bool begin(Settings& settings);
+  bool save(const Settings& settings);
+  void process();
+  bool isAvailable() { return available; }
+  StoreMode getMode() { return mode; }
+  uint32_t getFailedSaves() { return failedSaves; }
+  uint32_t getEraseCount() { return eraseCount; }
+  uint32_t getRecordCount() { return recordCount; }
+  uint16_t getUsed() { return writeOffset; }
+  uint8_t getActiveSector() { return activeSector; }
+  
+private:
+  uint32_t sectorAddress(uint8_t sector);
+  bool readHeader(uint8_t sector, uint32_t& generation);
+  bool replay(uint8_t sector, Settings& settings, uint8_t& schema);
+  bool append(uint8_t id, const void* data, uint8_t length);
+  bool writeRecord(uint32_t address, uint8_t id, const void* data, uint8_t length, uint16_t& size);
+  bool compact();
+  void migrate(Settings& settings, uint8_t fromVersion);
+  bool readFallback(Settings& settings);
+  bool writeFallback(const Settings& settings);
+  
+  Settings current;        // What the active sector replays to
+  bool available;
+  StoreMode mode;
+  uint32_t failedSaves;
+  uint8_t activeSector;
+  uint32_t generation;
+  uint16_t writeOffset;    // Next free byte in the active sector
+  uint32_t eraseCount;
+  uint32_t recordCount;
+};
+
+#endif
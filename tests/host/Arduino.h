@@ -0,0 +1,166 @@
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+// Host stand-in for the ESP8266 Arduino core: the part of its API the
+// sketch uses, on Linux. Time comes from the virtual clock in sim.h.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+
+// Flash strings are ordinary strings on the host
+#define PROGMEM
+#define PGM_P const char*
+#define PSTR(s) (s)
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_ptr(addr) (*(void* const*)(addr))
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define strcmp_P strcmp
+#define snprintf_P snprintf
+#define vsnprintf_P vsnprintf
+#define ICACHE_RAM_ATTR
+#define IRAM_ATTR
+
+// NodeMCU pin names
+#define D5 14
+#define D7 13
+#define D8 15
+#define OUTPUT 1
+#define INPUT 0
+#define HIGH 1
+#define LOW 0
+#define MSBFIRST 1
+#define LSBFIRST 0
+
+#define bitRead(value, bit) (((value) >> (bit)) & 1)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, on) ((on) ? bitSet(value, bit) : bitClear(value, bit))
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t value);
+
+template <class T> T constrain(T value, T low, T high) {
+  return value < low ? low : (value > high ? high : value);
+}
+
+// glibc only has strlcpy from 2.38
+#if !defined(__GLIBC__) || !__GLIBC_PREREQ(2, 38)
+size_t strlcpy(char* dst, const char* src, size_t size);
+#endif
+
+class String {
+public:
+  String(const char* s = "") : s(s ? s : "") {}
+  String(const std::string& s) : s(s) {}
+  String(const __FlashStringHelper* s) : s((const char*)s) {}
+  String(int n) : s(std::to_string(n)) {}
+  String(unsigned int n) : s(std::to_string(n)) {}
+  String(long n) : s(std::to_string(n)) {}
+  String(unsigned long n) : s(std::to_string(n)) {}
+  const char* c_str() const { return s.c_str(); }
+  unsigned int length() const { return s.length(); }
+  bool reserve(unsigned int size) { s.reserve(size); return true; }
+  long toInt() const { return atol(s.c_str()); }
+  int indexOf(char c) const { size_t i = s.find(c); return i == std::string::npos ? -1 : (int)i; }
+  String substring(unsigned int from, unsigned int to) const { return String(s.substr(from, to - from)); }
+  String& operator+=(const String& other) { s += other.s; return *this; }
+  String& operator+=(const char* other) { s += other; return *this; }
+  bool operator==(const char* other) const { return s == other; }
+  bool operator!=(const char* other) const { return s != other; }
+  bool operator==(const String& other) const { return s == other.s; }
+  friend String operator+(const String& a, const String& b) { return String(a.s + b.s); }
+  const std::string& str() const { return s; }
+
+private:
+  std::string s;
+};
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buf, size_t size);
+  size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+  size_t print(const char* s) { return write(s); }
+  size_t print(const String& s) { return write(s.c_str()); }
+  size_t print(const __FlashStringHelper* s) { return write((const char*)s); }
+  size_t print(long n) { return printf("%ld", n); }
+  size_t print(unsigned long n) { return printf("%lu", n); }
+  size_t print(int n) { return printf("%d", n); }
+  size_t print(unsigned int n) { return printf("%u", n); }
+  size_t println() { return write("\r\n"); }
+  template <class T> size_t println(T value) { return print(value) + println(); }
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class HardwareSerial : public Print {
+public:
+  void begin(unsigned long) {}
+  int availableForWrite();
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buf, size_t size) override;
+  using Print::write;
+  operator bool() { return true; }
+};
+extern HardwareSerial Serial;
+
+struct ip_addr;
+
+class IPAddress {
+public:
+  IPAddress() : address(0) {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : address(a | b << 8 | c << 16 | (uint32_t)d << 24) {}
+  IPAddress(uint32_t raw) : address(raw) {}
+  IPAddress(const ip_addr* ip);
+  operator uint32_t() const { return address; }
+  uint8_t operator[](int i) const { return address >> (8 * i); }
+  bool operator==(const IPAddress& other) const { return address == other.address; }
+  bool operator!=(const IPAddress& other) const { return address != other.address; }
+  bool isSet() const { return address != 0; }
+  String toString() const;
+
+private:
+  uint32_t address;   // First octet in the low byte, as on the ESP8266
+};
+
+class EspClass {
+public:
+  uint32_t getFreeHeap() { return 40000; }
+  uint32_t getMaxFreeBlockSize() { return 30000; }
+  uint8_t getHeapFragmentation() { return 10; }
+  uint32_t getChipId() { return 0x00C10C; }
+  uint32_t getCycleCount() { return (uint32_t)(micros() * 80); }
+  String getResetReason() { return String("Host"); }
+  bool rtcUserMemoryRead(uint32_t offset, uint32_t* data, size_t size);
+  bool rtcUserMemoryWrite(uint32_t offset, uint32_t* data, size_t size);
+  bool flashRead(uint32_t address, uint32_t* data, size_t size);
+  bool flashWrite(uint32_t address, const uint32_t* data, size_t size);
+  bool flashEraseSector(uint32_t sector);
+};
+extern EspClass ESP;
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef EEPROM_H
+#define EEPROM_H
+
+#include <Arduino.h>
+
+// Emulated EEPROM: a RAM copy of one flash sector between begin() and
+// commit(), like the ESP8266 core's
+class EEPROMClass {
+public:
+  void begin(size_t size);
+  uint8_t read(int address);
+  void write(int address, uint8_t value);
+  bool commit();
+  bool end();
+  uint8_t* getDataPtr();
+  size_t length() { return size; }
+
+  template <class T> T& get(int address, T& t) {
+    if (address >= 0 && address + sizeof(T) <= size) memcpy(&t, data + address, sizeof(T));
+    return t;
+  }
+  template <class T> const T& put(int address, const T& t) {
+    if (address >= 0 && address + sizeof(T) <= size) {
+      memcpy(data + address, &t, sizeof(T));
+      dirty = true;
+    }
+    return t;
+  }
+
+private:
+  uint8_t* data = nullptr;
+  size_t size = 0;
+  bool dirty = false;
+};
+extern EEPROMClass EEPROM;
+
+#endif
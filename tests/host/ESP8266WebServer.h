@@ -0,0 +1,90 @@
+#ifndef ESP8266WEBSERVER_H
+#define ESP8266WEBSERVER_H
+
+#include <ESP8266WiFi.h>
+#include <functional>
+#include <vector>
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_DELETE };
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+#define CONTENT_LENGTH_NOT_SET ((size_t)-2)
+
+// HTTP/1.1 server on a host TCP socket, with the request and response
+// behaviour of the ESP8266 core's server that the sketch relies on: one
+// request per handleClient() call, form posts split into args and any other
+// body in the "plain" arg, chunked responses after
+// setContentLength(CONTENT_LENGTH_UNKNOWN), and connections that stay open
+// while a handler keeps a copy of client(). Every response closes the
+// connection.
+class ESP8266WebServer {
+public:
+  typedef std::function<void(void)> THandlerFunction;
+
+  explicit ESP8266WebServer(int port);
+  ~ESP8266WebServer();
+  void begin();
+  void close();
+  void handleClient();
+  uint16_t hostPort() { return boundPort; }  // Host side only, see simMapPort()
+
+  void on(const char* uri, THandlerFunction handler) { on(uri, HTTP_ANY, handler); }
+  void on(const char* uri, HTTPMethod method, THandlerFunction handler);
+  void onNotFound(THandlerFunction handler) { notFound = handler; }
+  void collectHeaders(const char* headerKeys[], size_t count);
+
+  HTTPMethod method() const { return requestMethod; }
+  const String& uri() const { return requestUri; }
+  int args() const { return argNames.size(); }
+  const String& arg(int i) const;
+  const String& argName(int i) const;
+  const String& arg(const String& name) const;
+  bool hasArg(const String& name) const;
+  const String& header(const String& name) const;
+  bool hasHeader(const String& name) const;
+  WiFiClient& client() { return current; }
+
+  void sendHeader(const String& name, const String& value, bool first = false);
+  void setContentLength(size_t length) { contentLength = length; }
+  void send(int code, const char* contentType, const String& content);
+  void send(int code, const char* contentType, const char* content) { send(code, contentType, content, strlen(content)); }
+  void send(int code, const char* contentType, const char* content, size_t length);
+  void send(int code, const String& contentType, const String& content) { send(code, contentType.c_str(), content); }
+  void send_P(int code, PGM_P contentType, PGM_P content) { send(code, contentType, content); }
+  void send_P(int code, PGM_P contentType, PGM_P content, size_t length) { send(code, contentType, content, length); }
+  void sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+  void sendContent(const char* content) { sendContent(content, strlen(content)); }
+  void sendContent(const char* content, size_t length);
+  void sendContent_P(PGM_P content) { sendContent(content); }
+  void sendContent_P(PGM_P content, size_t length) { sendContent(content, length); }
+
+private:
+  struct Route {
+    String uri;
+    HTTPMethod method;
+    THandlerFunction handler;
+  };
+
+  bool readRequest();
+  void parseArgs(const std::string& encoded);
+  void sendHead(int code, const char* contentType, size_t length);
+
+  int devicePort;
+  uint16_t boundPort;
+  int listenFd;
+  std::vector<Route> routes;
+  THandlerFunction notFound;
+  std::vector<String> collected;
+  std::vector<String> headerValues;
+  WiFiClient current;
+  HTTPMethod requestMethod;
+  String requestUri;
+  std::vector<String> argNames;
+  std::vector<String> argValues;
+  std::vector<std::pair<String, String>> responseHeaders;
+  size_t contentLength;
+  bool chunked;
+  bool headSent;
+};
+
+#endif
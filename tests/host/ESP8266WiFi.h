@@ -0,0 +1,52 @@
+#ifndef ESP8266WIFI_H
+#define ESP8266WIFI_H
+
+#include <Arduino.h>
+#include <memory>
+
+enum wl_status_t {
+  WL_IDLE_STATUS = 0,
+  WL_CONNECTED = 3,
+  WL_DISCONNECTED = 6
+};
+
+enum WiFiMode_t { WIFI_OFF, WIFI_STA, WIFI_AP, WIFI_AP_STA };
+
+struct SimSocket;
+
+// A TCP connection on a host socket. Copies share the connection, which
+// closes with stop() or when the last copy goes, as lwIP's ClientContext
+// does on the ESP8266.
+class WiFiClient : public Print {
+public:
+  WiFiClient();
+  explicit WiFiClient(int fd);
+  uint8_t connected();
+  int available();
+  int read();
+  int read(uint8_t* buf, size_t size);
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buf, size_t size) override;
+  using Print::write;
+  int availableForWrite();   // Room in the send buffer, capped at the ESP8266's TCP_SND_BUF
+  void setNoDelay(bool noDelay);
+  void flush() {}
+  void stop();
+  IPAddress remoteIP() { return IPAddress(127, 0, 0, 1); }
+  uint16_t remotePort() { return 0; }
+  operator bool() { return connected(); }
+
+private:
+  std::shared_ptr<SimSocket> socket;
+};
+
+class WiFiClass {
+public:
+  bool mode(WiFiMode_t) { return true; }
+  bool begin() { return true; }
+  wl_status_t status();
+  IPAddress localIP();
+};
+extern WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef MD_MAX72XX_H
+#define MD_MAX72XX_H
+
+#include <Arduino.h>
+
+// Stand-in for MD_MAX72XX: the constructor, begin() and control() drive
+// the MAX7219 chain model over the SPI stand-in like the library does, and
+// getChar() returns a placeholder box for any character. Pixel drawing is
+// not modelled; the firmware draws through its own framebuffer. Tests that
+// compare against the real library build it from MD_MAX72XX_DIR instead.
+class MD_MAX72XX {
+public:
+  enum moduleType_t { PAROLA_HW, GENERIC_HW, ICSTATION_HW, FC16_HW };
+  enum controlRequest_t { SHUTDOWN, SCANLIMIT, INTENSITY, TEST, DECODE, UPDATE, WRAPAROUND };
+  enum controlValue_t { OFF = 0, ON = 1 };
+
+  MD_MAX72XX(moduleType_t type, uint8_t csPin, uint8_t numDevices = 1);
+  bool begin();
+  bool control(controlRequest_t mode, int value);
+  void clear();
+  uint8_t getChar(uint16_t c, uint8_t size, uint8_t* buf);
+  uint8_t getDeviceCount() { return devices; }
+  uint16_t getColumnCount() { return devices * 8; }
+
+private:
+  void sendAll(uint8_t opcode, uint8_t data);
+
+  moduleType_t type;
+  uint8_t csPin;
+  uint8_t devices;
+};
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef MD_PAROLA_H
+#define MD_PAROLA_H
+
+#include <MD_MAX72XX.h>
+
+enum textPosition_t { PA_LEFT, PA_CENTER, PA_RIGHT };
+
+// Stand-in for MD_Parola: owns the MD_MAX72XX stand-in and forwards setup
+// and intensity to it. The firmware animates through its own framebuffer.
+class MD_Parola {
+public:
+  MD_Parola(MD_MAX72XX::moduleType_t type, uint8_t csPin, uint8_t numDevices = 1) : graphics(type, csPin, numDevices) {}
+  bool begin() { return graphics.begin(); }
+  void setIntensity(uint8_t intensity) { graphics.control(MD_MAX72XX::INTENSITY, intensity); }
+  void setTextAlignment(textPosition_t) {}
+  void displayClear() { graphics.clear(); }
+  MD_MAX72XX* getGraphicObject() { return &graphics; }
+
+private:
+  MD_MAX72XX graphics;
+};
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef SPI_H
+#define SPI_H
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0x00
+
+class SPISettings {
+public:
+  SPISettings(uint32_t clock = 1000000, uint8_t bitOrder = MSBFIRST, uint8_t dataMode = SPI_MODE0) : clock(clock) { (void)bitOrder; (void)dataMode; }
+  uint32_t clock;
+};
+
+// Bytes written here shift into the MAX7219 chain model in max7219.h,
+// which latches them when CS goes high
+class SPIClass {
+public:
+  void begin() {}
+  void end() {}
+  void beginTransaction(SPISettings) {}
+  void endTransaction() {}
+  uint8_t transfer(uint8_t data);
+  void transfer(void* buf, size_t count);
+  void writeBytes(const uint8_t* data, uint32_t size);
+};
+extern SPIClass SPI;
+
+#endif
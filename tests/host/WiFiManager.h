@@ -0,0 +1,24 @@
+#ifndef WIFIMANAGER_H
+#define WIFIMANAGER_H
+
+#include <Arduino.h>
+
+// Stand-in for WiFiManager's non-blocking portal. It records what it is
+// asked to do in simPortal(); a test ends the portal by clearing
+// simPortal().active, optionally after simSetWifi(true) as if credentials
+// had been saved.
+class WiFiManager {
+public:
+  void setConfigPortalBlocking(bool blocking) { (void)blocking; }
+  void setConfigPortalTimeout(unsigned long seconds) { (void)seconds; }
+  void setHttpPort(uint16_t port) { httpPort = port; }
+  bool startConfigPortal(const char* apName);
+  bool process();
+  bool getConfigPortalActive();
+  void stopConfigPortal();
+
+private:
+  uint16_t httpPort = 80;
+};
+
+#endif
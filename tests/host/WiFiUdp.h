@@ -0,0 +1,45 @@
+#ifndef WIFIUDP_H
+#define WIFIUDP_H
+
+#include <ESP8266WiFi.h>
+#include <deque>
+#include "sim.h"
+
+// UDP on the virtual network in sim.h
+class WiFiUDP {
+public:
+  WiFiUDP();
+  ~WiFiUDP();
+  uint8_t begin(uint16_t port);
+  uint8_t beginMulticast(IPAddress local, IPAddress group, uint16_t port);
+  void stop();
+  int beginPacket(IPAddress ip, uint16_t port);
+  int beginPacket(const char* host, uint16_t port);
+  int beginPacketMulticast(IPAddress group, uint16_t port, IPAddress local, int ttl = 1);
+  size_t write(const uint8_t* buf, size_t size);
+  size_t write(uint8_t c) { return write(&c, 1); }
+  int endPacket();
+  int parsePacket();
+  int available() { return reading.size() - readOffset; }
+  int read(uint8_t* buf, size_t size);
+  int read();
+  void flush();
+  IPAddress remoteIP() { return readFrom; }
+  uint16_t remotePort() { return readFromPort; }
+
+  int node;                   // Owner, see simSelectNode()
+  uint16_t port;              // Bound port, 0 if closed
+  IPAddress group;            // Joined multicast group, if any
+  std::deque<SimDatagram> queue;  // Arrived or in flight, by delivery time in .time
+
+private:
+  IPAddress sendTo;
+  uint16_t sendPort;
+  std::vector<uint8_t> sending;
+  std::vector<uint8_t> reading;
+  size_t readOffset;
+  IPAddress readFrom;
+  uint16_t readFromPort;
+};
+
+#endif
@@ -0,0 +1,112 @@
+// BearSSL stand-in: SHA-256 (FIPS 180-4) and HMAC (RFC 2104)
+#include <bearssl/bearssl_hmac.h>
+#include <string.h>
+
+const br_hash_class br_sha256_vtable = { 32 };
+
+static const uint32_t K[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static uint32_t rotr(uint32_t x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+static void sha256Init(br_sha256_context* ctx) {
+  static const uint32_t H0[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+  };
+  memcpy(ctx->state, H0, sizeof(H0));
+  ctx->count = 0;
+}
+
+static void sha256Block(br_sha256_context* ctx, const unsigned char* block) {
+  uint32_t w[64];
+  for (int i = 0; i < 16; i++) {
+    w[i] = (uint32_t)block[4 * i] << 24 | (uint32_t)block[4 * i + 1] << 16 | (uint32_t)block[4 * i + 2] << 8 | block[4 * i + 3];
+  }
+  for (int i = 16; i < 64; i++) {
+    uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+  uint32_t v[8];
+  memcpy(v, ctx->state, sizeof(v));
+  for (int i = 0; i < 64; i++) {
+    uint32_t t1 = v[7] + (rotr(v[4], 6) ^ rotr(v[4], 11) ^ rotr(v[4], 25)) + ((v[4] & v[5]) ^ (~v[4] & v[6])) + K[i] + w[i];
+    uint32_t t2 = (rotr(v[0], 2) ^ rotr(v[0], 13) ^ rotr(v[0], 22)) + ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+    memmove(v + 1, v, 7 * sizeof(uint32_t));
+    v[4] += t1;
+    v[0] = t1 + t2;
+  }
+  for (int i = 0; i < 8; i++) ctx->state[i] += v[i];
+}
+
+static void sha256Update(br_sha256_context* ctx, const void* data, size_t len) {
+  const unsigned char* p = (const unsigned char*)data;
+  while (len--) {
+    ctx->buf[ctx->count++ % 64] = *p++;
+    if (ctx->count % 64 == 0) sha256Block(ctx, ctx->buf);
+  }
+}
+
+static void sha256Out(const br_sha256_context* ctx, unsigned char* out) {
+  br_sha256_context done = *ctx;
+  uint64_t bits = done.count * 8;
+  unsigned char pad = 0x80;
+  sha256Update(&done, &pad, 1);
+  pad = 0;
+  while (done.count % 64 != 56) sha256Update(&done, &pad, 1);
+  for (int i = 7; i >= 0; i--) {
+    pad = (unsigned char)(bits >> (8 * i));
+    sha256Update(&done, &pad, 1);
+  }
+  for (int i = 0; i < 32; i++) out[i] = (unsigned char)(done.state[i / 4] >> (24 - 8 * (i % 4)));
+}
+
+void br_hmac_key_init(br_hmac_key_context* kc, const br_hash_class* digest_vtable, const void* key, size_t key_len) {
+  unsigned char block[64] = {};
+  if (key_len > sizeof(block)) {
+    br_sha256_context ctx;
+    sha256Init(&ctx);
+    sha256Update(&ctx, key, key_len);
+    sha256Out(&ctx, block);
+  } else {
+    memcpy(block, key, key_len);
+  }
+  kc->dig_vtable = digest_vtable;
+  for (int i = 0; i < 64; i++) {
+    kc->ksi[i] = block[i] ^ 0x36;
+    kc->kso[i] = block[i] ^ 0x5c;
+  }
+}
+
+void br_hmac_init(br_hmac_context* ctx, const br_hmac_key_context* kc, size_t out_len) {
+  sha256Init(&ctx->dig);
+  sha256Update(&ctx->dig, kc->ksi, sizeof(kc->ksi));
+  memcpy(ctx->kso, kc->kso, sizeof(ctx->kso));
+  ctx->out_len = out_len == 0 || out_len > 32 ? 32 : out_len;
+}
+
+void br_hmac_update(br_hmac_context* ctx, const void* data, size_t len) {
+  sha256Update(&ctx->dig, data, len);
+}
+
+size_t br_hmac_out(const br_hmac_context* ctx, void* out) {
+  unsigned char inner[32], outer[32];
+  sha256Out(&ctx->dig, inner);
+  br_sha256_context dig;
+  sha256Init(&dig);
+  sha256Update(&dig, ctx->kso, sizeof(ctx->kso));
+  sha256Update(&dig, inner, sizeof(inner));
+  sha256Out(&dig, outer);
+  memcpy(out, outer, ctx->out_len);
+  return ctx->out_len;
+}
@@ -0,0 +1,38 @@
+#ifndef BEARSSL_HMAC_H
+#define BEARSSL_HMAC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// HMAC from the BearSSL bundled with the ESP8266 core, SHA-256 only
+
+typedef struct {
+  size_t outputSize;
+} br_hash_class;
+
+extern const br_hash_class br_sha256_vtable;
+
+typedef struct {
+  uint32_t state[8];
+  uint64_t count;
+  unsigned char buf[64];
+} br_sha256_context;
+
+typedef struct {
+  const br_hash_class* dig_vtable;
+  unsigned char ksi[64];
+  unsigned char kso[64];
+} br_hmac_key_context;
+
+typedef struct {
+  br_sha256_context dig;
+  unsigned char kso[64];
+  size_t out_len;
+} br_hmac_context;
+
+void br_hmac_key_init(br_hmac_key_context* kc, const br_hash_class* digest_vtable, const void* key, size_t key_len);
+void br_hmac_init(br_hmac_context* ctx, const br_hmac_key_context* kc, size_t out_len);
+void br_hmac_update(br_hmac_context* ctx, const void* data, size_t len);
+size_t br_hmac_out(const br_hmac_context* ctx, void* out);
+
+#endif
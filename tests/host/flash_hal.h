@@ -0,0 +1,15 @@
+#ifndef FLASH_HAL_H
+#define FLASH_HAL_H
+
+#include <stdint.h>
+
+// Flash layout of a 4 MB module with a 2 MB FS area. As on the ESP8266,
+// where the FS size comes from linker symbols, FS_PHYS_SIZE is only known
+// at run time (see simSetFsSize()).
+#define FLASH_SECTOR_SIZE 0x1000
+#define FS_PHYS_ADDR ((uint32_t)0x200000)
+#define FS_PHYS_SIZE simFsPhysSize()
+
+uint32_t simFsPhysSize();
+
+#endif
@@ -0,0 +1,399 @@
+// Host core: virtual clock, nodes, Serial, RTC memory, flash and EEPROM
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <WiFiManager.h>
+#include <ESP8266WiFi.h>
+#include <coredecls.h>
+#include <flash_hal.h>
+#include <user_interface.h>
+#include "sim.h"
+#include "max7219.h"
+#include <chrono>
+#include <thread>
+
+HardwareSerial Serial;
+EspClass ESP;
+EEPROMClass EEPROM;
+
+static const uint32_t FLASH_SIZE = 0x400000;
+static const uint32_t EEPROM_SECTOR = 0x3FB000 / FLASH_SECTOR_SIZE;  // Just below the SDK sectors
+static const size_t RTC_USER_MEMORY = 512;
+static const uint32_t RTC_CALIBRATION = 6 << 12;  // A 6 us RTC period, in 1/4096 us
+
+struct SimNodeState {
+  double ppm;
+  uint64_t boot;
+  bool wifi;
+  unsigned long datagramsSent;
+  uint8_t rtcMemory[RTC_USER_MEMORY];
+};
+
+static uint64_t trueTime = 0;
+static bool realtime = false;
+static std::chrono::steady_clock::time_point realtimeStart;
+static std::vector<SimNodeState> nodes(1, SimNodeState{ 0, 0, true, 0, {} });
+static int currentNode = 0;
+
+static std::vector<uint8_t> flash(FLASH_SIZE, 0xFF);
+static FILE* flashFile = nullptr;
+static uint32_t fsSize = 0x1FA000;
+static long flashWritesLeft = -1;
+static uint32_t flashErases = 0;
+
+static std::string serialOutput;
+static int serialRoom = 128;
+static SimPortal portal;
+
+void simProcessNetwork();  // sim_network.cpp: completes DNS lookups that are due
+
+// ---- Virtual clock and nodes ----
+
+uint64_t simTime() {
+  if (realtime) {
+    trueTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - realtimeStart).count();
+  }
+  return trueTime;
+}
+
+void simAdvance(uint64_t micros) {
+  if (realtime) {
+    std::this_thread::sleep_for(std::chrono::microseconds(micros));
+  } else {
+    trueTime += micros;
+  }
+  simProcessNetwork();
+}
+
+void simSetRealtime(bool on) {
+  realtime = on;
+  realtimeStart = std::chrono::steady_clock::now() - std::chrono::microseconds(trueTime);
+}
+
+static uint64_t localMicros() {
+  const SimNodeState& node = nodes[currentNode];
+  uint64_t now = simTime();
+  if (now <= node.boot) return 0;
+  return (uint64_t)((now - node.boot) * (1.0 + node.ppm * 1e-6));
+}
+
+unsigned long micros() {
+  return (unsigned long)(uint32_t)localMicros();
+}
+
+unsigned long millis() {
+  return (unsigned long)(uint32_t)(localMicros() / 1000);
+}
+
+void delay(unsigned long ms) {
+  // Local milliseconds, run on this node's crystal
+  simAdvance((uint64_t)(ms * 1000 / (1.0 + nodes[currentNode].ppm * 1e-6)));
+}
+
+void delayMicroseconds(unsigned int us) {
+  simAdvance(us);
+}
+
+void yield() {
+  simProcessNetwork();
+}
+
+int simAddNode(double ppm, uint64_t bootMicros) {
+  nodes.push_back(SimNodeState{ ppm, bootMicros, true, 0, {} });
+  return nodes.size() - 1;
+}
+
+void simSelectNode(int node) {
+  currentNode = node;
+}
+
+int simNode() {
+  return currentNode;
+}
+
+IPAddress simNodeIP(int node) {
+  return IPAddress(10, 0, 0, 2 + node);
+}
+
+void simSetWifi(bool connected) {
+  nodes[currentNode].wifi = connected;
+}
+
+unsigned long& simNodeDatagrams(int node) {
+  return nodes[node].datagramsSent;
+}
+
+unsigned long simDatagramsSent(int node) {
+  return nodes[node].datagramsSent;
+}
+
+wl_status_t WiFiClass::status() {
+  return nodes[currentNode].wifi ? WL_CONNECTED : WL_DISCONNECTED;
+}
+
+IPAddress WiFiClass::localIP() {
+  return nodes[currentNode].wifi ? simNodeIP(currentNode) : IPAddress();
+}
+
+void simResetNetwork();  // sim_network.cpp
+
+void simReset() {
+  trueTime = 0;
+  realtime = false;
+  nodes.assign(1, SimNodeState{ 0, 0, true, 0, {} });
+  currentNode = 0;
+  if (flashFile) fclose(flashFile);
+  flashFile = nullptr;
+  flash.assign(FLASH_SIZE, 0xFF);
+  fsSize = 0x1FA000;
+  flashWritesLeft = -1;
+  flashErases = 0;
+  serialOutput.clear();
+  serialRoom = 128;
+  portal = SimPortal();
+  simResetNetwork();
+}
+
+// ---- Serial ----
+
+size_t Print::write(const uint8_t* buf, size_t size) {
+  size_t n = 0;
+  while (size--) n += write(*buf++);
+  return n;
+}
+
+size_t Print::printf(const char* format, ...) {
+  char buf[256];
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  if (len < 0) return 0;
+  return write((const uint8_t*)buf, (size_t)len < sizeof(buf) ? len : sizeof(buf) - 1);
+}
+
+int HardwareSerial::availableForWrite() {
+  return serialRoom;
+}
+
+size_t HardwareSerial::write(const uint8_t* buf, size_t size) {
+  serialOutput.append((const char*)buf, size);
+  return size;
+}
+
+const std::string& simSerialOutput() {
+  return serialOutput;
+}
+
+void simSetSerialRoom(int bytes) {
+  serialRoom = bytes;
+}
+
+// ---- Pins: CS of the matrix chain ----
+
+void pinMode(uint8_t, uint8_t) {}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  if (pin == simMatrix.getCsPin()) simMatrix.select(value == LOW);
+}
+
+int digitalRead(uint8_t) {
+  return LOW;
+}
+
+void shiftOut(uint8_t, uint8_t, uint8_t bitOrder, uint8_t value) {
+  if (bitOrder == LSBFIRST) {
+    uint8_t reversed = 0;
+    for (uint8_t i = 0; i < 8; i++) if (value & (1 << i)) reversed |= 0x80 >> i;
+    value = reversed;
+  }
+  simMatrix.shiftIn(value);
+}
+
+#if !defined(__GLIBC__) || !__GLIBC_PREREQ(2, 38)
+size_t strlcpy(char* dst, const char* src, size_t size) {
+  size_t length = strlen(src);
+  if (size > 0) {
+    size_t n = length < size - 1 ? length : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return length;
+}
+#endif
+
+String IPAddress::toString() const {
+  char buf[16];
+  snprintf(buf, sizeof(buf), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+  return String(buf);
+}
+
+uint32_t crc32(const void* data, size_t length, uint32_t crc) {
+  const uint8_t* p = (const uint8_t*)data;
+  while (length--) {
+    crc ^= *p++;
+    for (uint8_t bit = 0; bit < 8; bit++) crc = crc & 1 ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+  }
+  return crc;
+}
+
+// ---- RTC ----
+
+uint32_t system_get_rtc_time(void) {
+  // Runs from power-on of the process, through simulated resets
+  return (uint32_t)((simTime() << 12) / RTC_CALIBRATION);
+}
+
+uint32_t system_rtc_clock_cali_proc(void) {
+  return RTC_CALIBRATION;
+}
+
+bool EspClass::rtcUserMemoryRead(uint32_t offset, uint32_t* data, size_t size) {
+  if (offset * 4 + size > RTC_USER_MEMORY) return false;
+  memcpy(data, nodes[currentNode].rtcMemory + offset * 4, size);
+  return true;
+}
+
+bool EspClass::rtcUserMemoryWrite(uint32_t offset, uint32_t* data, size_t size) {
+  if (offset * 4 + size > RTC_USER_MEMORY) return false;
+  memcpy(nodes[currentNode].rtcMemory + offset * 4, data, size);
+  return true;
+}
+
+// ---- Flash ----
+
+uint32_t simFsPhysSize() {
+  return fsSize;
+}
+
+void simSetFsSize(uint32_t bytes) {
+  fsSize = bytes;
+}
+
+void simFailFlashWrites(long after) {
+  flashWritesLeft = after;
+}
+
+uint32_t simFlashErases() {
+  return flashErases;
+}
+
+static void writeBack(uint32_t address, size_t size) {
+  if (!flashFile) return;
+  fseek(flashFile, address, SEEK_SET);
+  fwrite(flash.data() + address, 1, size, flashFile);
+  fflush(flashFile);
+}
+
+void simFlashOpen(const char* path) {
+  if (flashFile) fclose(flashFile);
+  flashFile = fopen(path, "r+b");
+  if (flashFile) {
+    size_t n = fread(flash.data(), 1, FLASH_SIZE, flashFile);
+    (void)n;
+  } else {
+    flashFile = fopen(path, "w+b");
+    if (flashFile) writeBack(0, FLASH_SIZE);
+  }
+}
+
+bool EspClass::flashRead(uint32_t address, uint32_t* data, size_t size) {
+  if (address % 4 || (uintptr_t)data % 4 || address + size > FLASH_SIZE) return false;
+  memcpy(data, flash.data() + address, size);
+  return true;
+}
+
+bool EspClass::flashWrite(uint32_t address, const uint32_t* data, size_t size) {
+  if (address % 4 || size % 4 || address + size > FLASH_SIZE) return false;
+  if (flashWritesLeft == 0) return false;
+  if (flashWritesLeft > 0) flashWritesLeft--;
+  // Programming only clears bits
+  const uint8_t* bytes = (const uint8_t*)data;
+  for (size_t i = 0; i < size; i++) flash[address + i] &= bytes[i];
+  writeBack(address, size);
+  return true;
+}
+
+bool EspClass::flashEraseSector(uint32_t sector) {
+  if ((sector + 1) * FLASH_SECTOR_SIZE > FLASH_SIZE) return false;
+  memset(flash.data() + sector * FLASH_SECTOR_SIZE, 0xFF, FLASH_SECTOR_SIZE);
+  flashErases++;
+  writeBack(sector * FLASH_SECTOR_SIZE, FLASH_SECTOR_SIZE);
+  return true;
+}
+
+// ---- EEPROM: one flash sector, erased and rewritten by commit() ----
+
+void EEPROMClass::begin(size_t newSize) {
+  size = (newSize + 3) & ~3;
+  if (size > FLASH_SECTOR_SIZE) size = FLASH_SECTOR_SIZE;
+  delete[] data;
+  data = new uint8_t[size];
+  ESP.flashRead(EEPROM_SECTOR * FLASH_SECTOR_SIZE, (uint32_t*)data, size);
+  dirty = false;
+}
+
+uint8_t EEPROMClass::read(int address) {
+  return address >= 0 && (size_t)address < size ? data[address] : 0;
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+  if (address < 0 || (size_t)address >= size) return;
+  if (data[address] != value) dirty = true;
+  data[address] = value;
+}
+
+uint8_t* EEPROMClass::getDataPtr() {
+  dirty = true;
+  return data;
+}
+
+bool EEPROMClass::commit() {
+  if (!data) return false;
+  if (!dirty) return true;
+  if (!ESP.flashEraseSector(EEPROM_SECTOR)) return false;
+  if (!ESP.flashWrite(EEPROM_SECTOR * FLASH_SECTOR_SIZE, (const uint32_t*)data, size)) return false;
+  dirty = false;
+  return true;
+}
+
+bool EEPROMClass::end() {
+  bool ok = commit();
+  delete[] data;
+  data = nullptr;
+  size = 0;
+  return ok;
+}
+
+// ---- WiFiManager portal ----
+
+SimPortal& simPortal() {
+  return portal;
+}
+
+bool WiFiManager::startConfigPortal(const char* apName) {
+  portal.active = true;
+  portal.apName = apName;
+  portal.port = httpPort;
+  portal.starts++;
+  portal.lastProcessMillis = millis();
+  return false;
+}
+
+bool WiFiManager::process() {
+  unsigned long now = millis();
+  if (portal.active) {
+    unsigned long gap = now - portal.lastProcessMillis;
+    if (gap > portal.maxProcessGap) portal.maxProcessGap = gap;
+  }
+  portal.lastProcessMillis = now;
+  portal.processCalls++;
+  return !portal.active && WiFi.status() == WL_CONNECTED;
+}
+
+bool WiFiManager::getConfigPortalActive() {
+  return portal.active;
+}
+
+void WiFiManager::stopConfigPortal() {
+  portal.active = false;
+}
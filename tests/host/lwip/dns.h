@@ -0,0 +1,24 @@
+#ifndef LWIP_DNS_H
+#define LWIP_DNS_H
+
+#include <stdint.h>
+
+// lwIP's asynchronous resolver, answering from the names added with
+// simAddHost() after simSetDnsDelay()
+
+typedef int8_t err_t;
+#define ERR_OK 0
+#define ERR_INPROGRESS -5
+#define ERR_ARG -16
+
+typedef struct ip_addr {
+  uint32_t addr;
+} ip_addr_t;
+
+#define ip_addr_get_ip4_u32(ip) ((ip)->addr)
+
+typedef void (*dns_found_callback)(const char* name, const ip_addr_t* ipaddr, void* callback_arg);
+
+err_t dns_gethostbyname(const char* hostname, ip_addr_t* addr, dns_found_callback found, void* callback_arg);
+
+#endif
@@ -0,0 +1,98 @@
+// MAX7219 chain model and the SPI bus into it
+#include <SPI.h>
+#include "max7219.h"
+
+Max7219Chain simMatrix;
+SPIClass SPI;
+
+// MAX7219 register addresses
+static const uint8_t OP_DIGIT0 = 0x01;
+static const uint8_t OP_DIGIT7 = 0x08;
+static const uint8_t OP_DECODE = 0x09;
+static const uint8_t OP_INTENSITY = 0x0A;
+static const uint8_t OP_SCANLIMIT = 0x0B;
+static const uint8_t OP_SHUTDOWN = 0x0C;
+static const uint8_t OP_TEST = 0x0F;
+
+void Max7219Chain::reset(uint8_t count, uint8_t pin) {
+  *this = Max7219Chain();
+  devices = count < MAX_CHAIN ? count : MAX_CHAIN;
+  csPin = pin;
+  for (uint8_t i = 0; i < MAX_CHAIN; i++) shutdown[i] = true;  // Power-on state
+}
+
+void Max7219Chain::select(bool low) {
+  if (selected && !low) {
+    // Rising edge: each device latches the pair now in its shift register
+    latches++;
+    for (uint8_t k = 0; k < devices; k++) {
+      if (shifted < 2u * (k + 1)) break;  // Nothing complete reached it
+      uint8_t opcode = shift[2 * k + 1] & 0x0F;
+      uint8_t data = shift[2 * k];
+      if (opcode >= OP_DIGIT0 && opcode <= OP_DIGIT7) {
+        digits[k][opcode - OP_DIGIT0] = data;
+      } else if (opcode == OP_DECODE) {
+        decode[k] = data;
+      } else if (opcode == OP_INTENSITY) {
+        intensity[k] = data & 0x0F;
+      } else if (opcode == OP_SCANLIMIT) {
+        scanLimit[k] = data & 0x07;
+      } else if (opcode == OP_SHUTDOWN) {
+        shutdown[k] = !(data & 1);
+      } else if (opcode == OP_TEST) {
+        test[k] = data & 1;
+      }
+    }
+  }
+  if (!selected && low) shifted = 0;
+  selected = low;
+}
+
+void Max7219Chain::shiftIn(uint8_t data) {
+  bytes++;
+  if (!selected) return;
+  memmove(shift + 1, shift, sizeof(shift) - 1);
+  shift[0] = data;
+  shifted++;
+}
+
+bool Max7219Chain::pixel(const SimWiring& wiring, uint8_t row, uint16_t column) {
+  // Device 0 is nearest the ESP8266, at the right end of the chain
+  uint16_t fromRight = devices * 8 - 1 - column;
+  uint8_t device = fromRight / 8;
+  uint8_t c = fromRight % 8;
+  uint8_t hwRow = wiring.reverseRows ? 7 - row : row;
+  uint8_t hwCol = wiring.reverseColumns ? 7 - c : c;
+  if (wiring.digitRows) return digits[device][hwRow] >> hwCol & 1;
+  return digits[device][hwCol] >> hwRow & 1;
+}
+
+std::string Max7219Chain::rowHex(const SimWiring& wiring, uint8_t row) {
+  std::string hex;
+  char buf[3];
+  for (uint16_t byte = 0; byte < devices; byte++) {
+    uint8_t bits = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+      if (pixel(wiring, row, byte * 8 + i)) bits |= 0x80 >> i;
+    }
+    snprintf(buf, sizeof(buf), "%02x", bits);
+    hex += buf;
+  }
+  return hex;
+}
+
+// ---- SPI ----
+
+uint8_t SPIClass::transfer(uint8_t data) {
+  simMatrix.shiftIn(data);
+  return 0;
+}
+
+void SPIClass::transfer(void* buf, size_t count) {
+  uint8_t* bytes = (uint8_t*)buf;
+  for (size_t i = 0; i < count; i++) bytes[i] = transfer(bytes[i]);
+}
+
+void SPIClass::writeBytes(const uint8_t* data, uint32_t size) {
+  for (uint32_t i = 0; i < size; i++) simMatrix.shiftIn(data[i]);
+}
@@ -0,0 +1,70 @@
+#ifndef MAX7219_H
+#define MAX7219_H
+
+#include <Arduino.h>
+
+// How a module connects its LEDs to the MAX7219. This is MD_MAX72XX's
+// description of the module types, written out independently of the
+// firmware's matrixdriver.h so tests can check one against the other:
+//   FC16_HW DR1CR0RR0, PAROLA_HW DR1CR1RR0, GENERIC_HW DR0CR1RR0,
+//   ICSTATION_HW DR1CR1RR1
+struct SimWiring {
+  bool digitRows;       // DR1: a digit register drives a row
+  bool reverseColumns;  // CR1
+  bool reverseRows;     // RR1
+};
+
+const SimWiring SIM_FC16 = { true, false, false };
+const SimWiring SIM_PAROLA = { true, true, false };
+const SimWiring SIM_GENERIC = { false, true, false };
+const SimWiring SIM_ICSTATION = { true, true, true };
+
+// Model of a MAX7219 chain on the SPI bus. Bytes shift in while CS is low;
+// when CS rises every device latches the last 16 bits that reached it, the
+// first pair shifted out ending up in the farthest device.
+class Max7219Chain {
+public:
+  static const uint8_t MAX_CHAIN = 64;
+
+  void reset(uint8_t devices, uint8_t csPin);
+  void select(bool low);
+  void shiftIn(uint8_t data);
+
+  uint8_t getDevices() { return devices; }
+  uint8_t getCsPin() { return csPin; }
+  uint8_t digit(uint8_t device, uint8_t digit) { return digits[device][digit]; }
+  uint8_t getIntensity(uint8_t device) { return intensity[device]; }
+  bool isShutdown(uint8_t device) { return shutdown[device]; }
+  bool isTest(uint8_t device) { return test[device]; }
+  uint8_t getScanLimit(uint8_t device) { return scanLimit[device]; }
+  uint8_t getDecode(uint8_t device) { return decode[device]; }
+
+  // Lit LED at row (0 at the top) and column counted from the left end of
+  // the chain, read through the module wiring
+  bool pixel(const SimWiring& wiring, uint8_t row, uint16_t column);
+  // One row of the whole chain as hex, leftmost device first
+  std::string rowHex(const SimWiring& wiring, uint8_t row);
+
+  unsigned long getLatches() { return latches; }    // CS rising edges
+  unsigned long getBytes() { return bytes; }        // Bytes shifted in
+  void clearCounters() { latches = 0; bytes = 0; }
+
+private:
+  uint8_t devices = 0;
+  uint8_t csPin = 0xFF;
+  bool selected = false;
+  uint8_t shift[MAX_CHAIN * 2] = {};  // shift[0] is the newest byte, nearest the ESP8266
+  unsigned long shifted = 0;
+  uint8_t digits[MAX_CHAIN][8] = {};
+  uint8_t intensity[MAX_CHAIN] = {};
+  uint8_t scanLimit[MAX_CHAIN] = {};
+  uint8_t decode[MAX_CHAIN] = {};
+  bool shutdown[MAX_CHAIN] = {};
+  bool test[MAX_CHAIN] = {};
+  unsigned long latches = 0;
+  unsigned long bytes = 0;
+};
+
+extern Max7219Chain simMatrix;
+
+#endif
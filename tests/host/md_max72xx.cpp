@@ -0,0 +1,83 @@
+// MD_MAX72XX stand-in, talking to the chain model over the SPI stand-in
+#include <SPI.h>
+#include <MD_MAX72XX.h>
+#include "max7219.h"
+
+static const uint8_t OP_DIGIT0 = 0x01;
+static const uint8_t OP_DIGIT7 = 0x08;
+static const uint8_t OP_DECODE = 0x09;
+static const uint8_t OP_INTENSITY = 0x0A;
+static const uint8_t OP_SCANLIMIT = 0x0B;
+static const uint8_t OP_SHUTDOWN = 0x0C;
+static const uint8_t OP_TEST = 0x0F;
+
+MD_MAX72XX::MD_MAX72XX(moduleType_t type, uint8_t csPin, uint8_t numDevices)
+  : type(type), csPin(csPin), devices(numDevices) {}
+
+void MD_MAX72XX::sendAll(uint8_t opcode, uint8_t data) {
+  digitalWrite(csPin, LOW);
+  for (uint8_t i = 0; i < devices; i++) {
+    SPI.transfer(opcode);
+    SPI.transfer(data);
+  }
+  digitalWrite(csPin, HIGH);
+}
+
+bool MD_MAX72XX::begin() {
+  // The library's start-up sequence
+  simMatrix.reset(devices, csPin);
+  pinMode(csPin, OUTPUT);
+  digitalWrite(csPin, HIGH);
+  SPI.begin();
+  sendAll(OP_TEST, 0);
+  sendAll(OP_SCANLIMIT, 7);
+  sendAll(OP_INTENSITY, 7);
+  sendAll(OP_DECODE, 0);
+  clear();
+  sendAll(OP_SHUTDOWN, 1);
+  return true;
+}
+
+bool MD_MAX72XX::control(controlRequest_t mode, int value) {
+  switch (mode) {
+    case SHUTDOWN: sendAll(OP_SHUTDOWN, value == ON ? 0 : 1); return true;
+    case SCANLIMIT: sendAll(OP_SCANLIMIT, value); return true;
+    case INTENSITY: sendAll(OP_INTENSITY, value); return true;
+    case TEST: sendAll(OP_TEST, value == ON ? 1 : 0); return true;
+    case DECODE: sendAll(OP_DECODE, value == ON ? 0xFF : 0); return true;
+    default: return false;
+  }
+}
+
+void MD_MAX72XX::clear() {
+  for (uint8_t d = OP_DIGIT0; d <= OP_DIGIT7; d++) sendAll(d, 0);
+}
+
+// Laid out like the library's default font, a width byte and the columns
+// of each of 256 characters, and walked from the start for every lookup as
+// MD_MAX72XX does without a font index, so the fallback costs what the
+// library's getChar() does. Every glyph is a 5-column box; tests only
+// check that the fallback glyph is drawn.
+static const uint8_t BOX[] = { 0x7F, 0x41, 0x41, 0x41, 0x7F };
+static const uint16_t FONT_CHARS = 256;
+
+struct BoxFont {
+  uint8_t data[FONT_CHARS * (sizeof(BOX) + 1)];
+  BoxFont() {
+    for (uint16_t c = 0; c < FONT_CHARS; c++) {
+      data[c * (sizeof(BOX) + 1)] = sizeof(BOX);
+      memcpy(&data[c * (sizeof(BOX) + 1) + 1], BOX, sizeof(BOX));
+    }
+  }
+};
+static const BoxFont font;
+
+uint8_t MD_MAX72XX::getChar(uint16_t c, uint8_t size, uint8_t* buf) {
+  if (c >= FONT_CHARS) return 0;
+  uint16_t offset = 0;
+  for (uint16_t i = 0; i < c; i++) offset += pgm_read_byte(&font.data[offset]) + 1;
+  uint8_t width = pgm_read_byte(&font.data[offset]);
+  uint8_t n = size < width ? size : width;
+  for (uint8_t i = 0; i < n; i++) buf[i] = pgm_read_byte(&font.data[offset + 1 + i]);
+  return n;
+}
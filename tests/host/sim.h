@@ -0,0 +1,88 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <Arduino.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Controls for the host stand-ins of the ESP8266 core and libraries. Tests
+// and the simulator drive the virtual clock, the network, WiFi and flash
+// through these; the sketch only sees the usual Arduino API.
+
+// Virtual clock. millis() and micros() read the selected node's view of
+// it and delay() advances it, so a loop() that sleeps until its next
+// deadline runs as fast as the host executes it. Code in between takes no
+// virtual time.
+void simReset();                      // Time 0, one node, empty network, erased flash
+uint64_t simTime();                   // True time in us since the start
+void simAdvance(uint64_t micros);
+void simSetRealtime(bool realtime);   // Follow the host clock; delay() sleeps
+
+// Nodes: several clocks in one process, each with its own crystal error and
+// power-on time. Sockets belong to the node selected when they are opened.
+int simAddNode(double ppm, uint64_t bootMicros);
+void simSelectNode(int node);
+int simNode();
+IPAddress simNodeIP(int node);
+void simSetWifi(bool connected);      // Station state of the selected node
+
+// Network. Datagrams between nodes take simNetworkDelay() each, which
+// returns the delay in us or SIM_DROP. Datagrams to an address no node has
+// go to the service registered for it, which answers with simSend().
+const uint64_t SIM_DROP = ~0ULL;
+
+struct SimDatagram {
+  IPAddress from;
+  uint16_t fromPort;
+  IPAddress to;
+  uint16_t toPort;
+  std::vector<uint8_t> data;
+  uint64_t time;                      // True time of arrival at the service
+};
+
+void simSetNetworkDelay(std::function<uint64_t()> delay);
+void simAddService(IPAddress ip, uint16_t port, std::function<void(const SimDatagram&)> handler);
+void simSend(const SimDatagram& datagram, uint64_t deliverAt);
+unsigned long simDatagramsSent(int node);
+
+// SNTP server at ip:123 whose clock reads epochMicros at true time 0 and
+// takes processingMicros between receive and transmit. Replies take
+// simNetworkDelay() back.
+void simAddNtpServer(IPAddress ip, uint64_t epochMicros, uint64_t processingMicros);
+unsigned long simNtpRequests();
+
+// DNS: names resolve after simDnsDelay() us, unknown names fail
+void simAddHost(const char* name, IPAddress ip);
+void simSetDnsDelay(uint64_t micros);
+unsigned long simDnsQueries();
+
+// Flash. The FS area and the EEPROM sector live in RAM, or in a file that
+// keeps them across runs. Writes can only clear bits, as on NOR flash.
+void simFlashOpen(const char* path);  // Load, and write back on every change
+void simSetFsSize(uint32_t bytes);    // 0 for a flash layout without an FS area
+void simFailFlashWrites(long after);  // Fail every write after this many, -1 never
+uint32_t simFlashErases();
+
+// Serial output of every node, and how much the TX FIFO takes per call
+const std::string& simSerialOutput();
+void simSetSerialRoom(int bytes);
+
+// HTTP: ESP8266WebServer(port) listens on 127.0.0.1 at the mapped host
+// port, 0 for any free one (see ESP8266WebServer::hostPort())
+void simMapPort(uint16_t devicePort, uint16_t hostPort);
+uint16_t simHostPort(uint16_t devicePort);
+
+// Portal: what the WiFiManager stand-in was asked to do
+struct SimPortal {
+  bool active;
+  std::string apName;
+  uint16_t port;
+  unsigned long starts;
+  unsigned long processCalls;
+  unsigned long lastProcessMillis;
+  unsigned long maxProcessGap;        // ms between process() calls while active
+};
+SimPortal& simPortal();
+
+#endif
@@ -0,0 +1,401 @@
+// TCP clients and the web server on host sockets
+#include <ESP8266WebServer.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/sockios.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <map>
+#include "sim.h"
+
+WiFiClass WiFi;
+
+static const int TCP_SND_BUF = 2 * 1460;      // lwIP's send buffer in the ESP8266 core
+static const int REQUEST_TIMEOUT_MS = 2000;   // HTTP_MAX_DATA_WAIT
+static const size_t REQUEST_MAX = 16384;
+
+static std::map<uint16_t, uint16_t> portMap;
+
+void simMapPort(uint16_t devicePort, uint16_t hostPort) {
+  portMap[devicePort] = hostPort;
+}
+
+uint16_t simHostPort(uint16_t devicePort) {
+  auto mapped = portMap.find(devicePort);
+  return mapped == portMap.end() ? 0 : mapped->second;
+}
+
+struct SimSocket {
+  int fd;
+  explicit SimSocket(int fd) : fd(fd) {}
+  ~SimSocket() {
+    if (fd >= 0) ::close(fd);
+  }
+};
+
+// ---- WiFiClient ----
+
+WiFiClient::WiFiClient() {}
+
+WiFiClient::WiFiClient(int fd) : socket(std::make_shared<SimSocket>(fd)) {}
+
+uint8_t WiFiClient::connected() {
+  if (!socket || socket->fd < 0) return 0;
+  char c;
+  ssize_t n = recv(socket->fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+  if (n == 0) return 0;  // Peer closed
+  if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) return 0;
+  return 1;
+}
+
+int WiFiClient::available() {
+  if (!socket || socket->fd < 0) return 0;
+  int n = 0;
+  if (ioctl(socket->fd, FIONREAD, &n) < 0) return 0;
+  return n;
+}
+
+int WiFiClient::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t* buf, size_t size) {
+  if (!socket || socket->fd < 0) return -1;
+  ssize_t n = recv(socket->fd, buf, size, MSG_DONTWAIT);
+  return n < 0 ? -1 : (int)n;
+}
+
+size_t WiFiClient::write(const uint8_t* buf, size_t size) {
+  if (!socket || socket->fd < 0) return 0;
+  // Blocks like the core's write() until the data is queued
+  size_t sent = 0;
+  while (sent < size) {
+    ssize_t n = send(socket->fd, buf + sent, size - sent, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        struct pollfd p = { socket->fd, POLLOUT, 0 };
+        if (poll(&p, 1, REQUEST_TIMEOUT_MS) <= 0) break;
+        continue;
+      }
+      break;
+    }
+    sent += n;
+  }
+  return sent;
+}
+
+int WiFiClient::availableForWrite() {
+  if (!socket || socket->fd < 0) return 0;
+  int queued = 0;
+  if (ioctl(socket->fd, SIOCOUTQ, &queued) < 0) return 0;
+  return queued < TCP_SND_BUF ? TCP_SND_BUF - queued : 0;
+}
+
+void WiFiClient::setNoDelay(bool noDelay) {
+  if (!socket || socket->fd < 0) return;
+  int on = noDelay;
+  setsockopt(socket->fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
+
+void WiFiClient::stop() {
+  if (!socket || socket->fd < 0) return;
+  ::close(socket->fd);
+  socket->fd = -1;
+}
+
+// ---- ESP8266WebServer ----
+
+static const String EMPTY;
+
+ESP8266WebServer::ESP8266WebServer(int port)
+  : devicePort(port), boundPort(0), listenFd(-1), requestMethod(HTTP_ANY),
+    contentLength(CONTENT_LENGTH_NOT_SET), chunked(false), headSent(false) {}
+
+ESP8266WebServer::~ESP8266WebServer() {
+  close();
+}
+
+void ESP8266WebServer::begin() {
+  close();
+  listenFd = socket(AF_INET, SOCK_STREAM, 0);
+  if (listenFd < 0) return;
+  int on = 1;
+  setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(simHostPort(devicePort));
+  if (bind(listenFd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(listenFd, 16) < 0) {
+    perror("ESP8266WebServer");
+    close();
+    return;
+  }
+  fcntl(listenFd, F_SETFL, O_NONBLOCK);
+  socklen_t len = sizeof(addr);
+  getsockname(listenFd, (sockaddr*)&addr, &len);
+  boundPort = ntohs(addr.sin_port);
+}
+
+void ESP8266WebServer::close() {
+  if (listenFd >= 0) ::close(listenFd);
+  listenFd = -1;
+  boundPort = 0;
+}
+
+void ESP8266WebServer::on(const char* uri, HTTPMethod method, THandlerFunction handler) {
+  routes.push_back(Route{ uri, method, handler });
+}
+
+void ESP8266WebServer::collectHeaders(const char* headerKeys[], size_t count) {
+  collected.assign(headerKeys, headerKeys + count);
+}
+
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+static std::string urlDecode(const std::string& s) {
+  std::string out;
+  for (size_t i = 0; i < s.size(); i++) {
+    if (s[i] == '+') {
+      out += ' ';
+    } else if (s[i] == '%' && i + 2 < s.size() && hexValue(s[i + 1]) >= 0 && hexValue(s[i + 2]) >= 0) {
+      out += (char)(hexValue(s[i + 1]) << 4 | hexValue(s[i + 2]));
+      i += 2;
+    } else {
+      out += s[i];
+    }
+  }
+  return out;
+}
+
+static bool sameText(const std::string& a, const std::string& b) {
+  return a.size() == b.size() && strncasecmp(a.c_str(), b.c_str(), a.size()) == 0;
+}
+
+void ESP8266WebServer::parseArgs(const std::string& encoded) {
+  size_t start = 0;
+  while (start < encoded.size()) {
+    size_t end = encoded.find('&', start);
+    if (end == std::string::npos) end = encoded.size();
+    std::string pair = encoded.substr(start, end - start);
+    if (!pair.empty()) {
+      size_t eq = pair.find('=');
+      argNames.push_back(String(urlDecode(pair.substr(0, eq))));
+      argValues.push_back(String(eq == std::string::npos ? "" : urlDecode(pair.substr(eq + 1))));
+    }
+    start = end + 1;
+  }
+}
+
+// Reads until the buffer holds the head and the announced body
+static bool readWithTimeout(int fd, std::string& data, size_t want) {
+  char buf[2048];
+  while (data.size() < want) {
+    struct pollfd p = { fd, POLLIN, 0 };
+    if (poll(&p, 1, REQUEST_TIMEOUT_MS) <= 0) return false;
+    ssize_t n = recv(fd, buf, sizeof(buf), 0);
+    if (n <= 0) return false;
+    data.append(buf, n);
+    if (want == REQUEST_MAX && data.find("\r\n\r\n") != std::string::npos) return true;
+  }
+  return true;
+}
+
+bool ESP8266WebServer::readRequest() {
+  int fd = accept(listenFd, nullptr, nullptr);
+  if (fd < 0) return false;
+  current = WiFiClient(fd);
+
+  std::string data;
+  if (!readWithTimeout(fd, data, REQUEST_MAX)) return false;
+  size_t headEnd = data.find("\r\n\r\n");
+  if (headEnd == std::string::npos) return false;
+  std::string head = data.substr(0, headEnd);
+  std::string body = data.substr(headEnd + 4);
+
+  size_t lineEnd = head.find("\r\n");
+  std::string requestLine = head.substr(0, lineEnd);
+  size_t sp1 = requestLine.find(' ');
+  size_t sp2 = requestLine.find(' ', sp1 + 1);
+  if (sp1 == std::string::npos || sp2 == std::string::npos) return false;
+  std::string method = requestLine.substr(0, sp1);
+  std::string target = requestLine.substr(sp1 + 1, sp2 - sp1 - 1);
+
+  requestMethod = method == "GET" ? HTTP_GET : method == "HEAD" ? HTTP_HEAD : method == "POST" ? HTTP_POST
+                : method == "PUT" ? HTTP_PUT : method == "DELETE" ? HTTP_DELETE : HTTP_ANY;
+  argNames.clear();
+  argValues.clear();
+  size_t query = target.find('?');
+  requestUri = String(target.substr(0, query));
+  if (query != std::string::npos) parseArgs(target.substr(query + 1));
+
+  headerValues.assign(collected.size(), String());
+  size_t length = 0;
+  std::string contentType;
+  size_t pos = lineEnd == std::string::npos ? head.size() : lineEnd + 2;
+  while (pos < head.size()) {
+    size_t end = head.find("\r\n", pos);
+    if (end == std::string::npos) end = head.size();
+    std::string line = head.substr(pos, end - pos);
+    pos = end + 2;
+    size_t colon = line.find(':');
+    if (colon == std::string::npos) continue;
+    std::string name = line.substr(0, colon);
+    std::string value = line.substr(colon + 1);
+    value.erase(0, value.find_first_not_of(' '));
+    if (sameText(name, "Content-Length")) length = strtoul(value.c_str(), nullptr, 10);
+    if (sameText(name, "Content-Type")) contentType = value;
+    for (size_t i = 0; i < collected.size(); i++) {
+      if (sameText(name, collected[i].str())) headerValues[i] = String(value);
+    }
+  }
+
+  if (length > REQUEST_MAX) return false;
+  if (body.size() < length) {
+    std::string rest;
+    if (!readWithTimeout(fd, rest, length - body.size())) return false;
+    body += rest;
+  }
+  body.resize(length);
+  if (contentType.compare(0, 33, "application/x-www-form-urlencoded") == 0) {
+    parseArgs(body);
+  } else if (length > 0) {
+    argNames.push_back(String("plain"));
+    argValues.push_back(String(body));
+  }
+  return true;
+}
+
+void ESP8266WebServer::handleClient() {
+  if (listenFd < 0) return;
+  if (!readRequest()) {
+    current = WiFiClient();
+    return;
+  }
+  responseHeaders.clear();
+  contentLength = CONTENT_LENGTH_NOT_SET;
+  chunked = false;
+  headSent = false;
+
+  THandlerFunction handler = notFound;
+  for (const Route& route : routes) {
+    if (route.uri == requestUri && (route.method == HTTP_ANY || route.method == requestMethod)) {
+      handler = route.handler;
+      break;
+    }
+  }
+  if (handler) {
+    handler();
+  } else {
+    send(404, "text/plain", "Not found");
+  }
+  if (chunked) sendContent("", 0);
+  // A handler that kept a copy of client() keeps the connection open
+  current = WiFiClient();
+}
+
+const String& ESP8266WebServer::arg(int i) const {
+  return i >= 0 && i < (int)argValues.size() ? argValues[i] : EMPTY;
+}
+
+const String& ESP8266WebServer::argName(int i) const {
+  return i >= 0 && i < (int)argNames.size() ? argNames[i] : EMPTY;
+}
+
+const String& ESP8266WebServer::arg(const String& name) const {
+  for (size_t i = 0; i < argNames.size(); i++) {
+    if (argNames[i] == name) return argValues[i];
+  }
+  return EMPTY;
+}
+
+bool ESP8266WebServer::hasArg(const String& name) const {
+  for (const String& n : argNames) {
+    if (n == name) return true;
+  }
+  return false;
+}
+
+const String& ESP8266WebServer::header(const String& name) const {
+  for (size_t i = 0; i < collected.size(); i++) {
+    if (sameText(collected[i].str(), name.str())) return headerValues[i];
+  }
+  return EMPTY;
+}
+
+bool ESP8266WebServer::hasHeader(const String& name) const {
+  return header(name).length() > 0;
+}
+
+void ESP8266WebServer::sendHeader(const String& name, const String& value, bool first) {
+  if (first) {
+    responseHeaders.insert(responseHeaders.begin(), std::make_pair(name, value));
+  } else {
+    responseHeaders.push_back(std::make_pair(name, value));
+  }
+}
+
+static const char* reasonPhrase(int code) {
+  switch (code) {
+    case 200: return "OK";
+    case 302: return "Found";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 413: return "Payload Too Large";
+    case 500: return "Internal Server Error";
+    case 503: return "Service Unavailable";
+    default: return "";
+  }
+}
+
+void ESP8266WebServer::sendHead(int code, const char* contentType, size_t length) {
+  std::string head = "HTTP/1.1 " + std::to_string(code) + " " + reasonPhrase(code) + "\r\n";
+  if (contentType && *contentType) head += std::string("Content-Type: ") + contentType + "\r\n";
+  if (length == CONTENT_LENGTH_UNKNOWN) {
+    head += "Transfer-Encoding: chunked\r\n";
+    chunked = true;
+  } else {
+    head += "Content-Length: " + std::to_string(length) + "\r\n";
+  }
+  for (const auto& header : responseHeaders) {
+    head += header.first.str() + ": " + header.second.str() + "\r\n";
+  }
+  head += "Connection: close\r\n\r\n";
+  current.write((const uint8_t*)head.data(), head.size());
+  headSent = true;
+}
+
+void ESP8266WebServer::send(int code, const char* contentType, const String& content) {
+  send(code, contentType, content.c_str(), content.length());
+}
+
+void ESP8266WebServer::send(int code, const char* contentType, const char* content, size_t length) {
+  size_t announced = contentLength == CONTENT_LENGTH_NOT_SET ? length : contentLength;
+  sendHead(code, contentType, announced);
+  if (length > 0) sendContent(content, length);
+}
+
+void ESP8266WebServer::sendContent(const char* content, size_t length) {
+  if (!chunked) {
+    // Before any send() this is the raw stream, headers and all
+    current.write((const uint8_t*)content, length);
+    return;
+  }
+  char size[12];
+  int n = snprintf(size, sizeof(size), "%zx\r\n", length);
+  current.write((const uint8_t*)size, n);
+  if (length > 0) current.write((const uint8_t*)content, length);
+  current.write((const uint8_t*)"\r\n", 2);
+  if (length == 0) chunked = false;
+}
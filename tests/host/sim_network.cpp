@@ -0,0 +1,292 @@
+// Virtual network: UDP between nodes and services, and DNS
+#include <WiFiUdp.h>
+#include <lwip/dns.h>
+#include <algorithm>
+#include <map>
+#include "sim.h"
+
+unsigned long& simNodeDatagrams(int node);  // host.cpp
+
+struct DnsQuery {
+  std::string name;
+  ip_addr_t* addr;
+  dns_found_callback found;
+  void* arg;
+  int node;
+  uint64_t doneAt;
+};
+
+static std::vector<WiFiUDP*> sockets;
+static std::function<uint64_t()> networkDelay;
+static std::map<std::pair<uint32_t, uint16_t>, std::function<void(const SimDatagram&)>> services;
+static std::map<std::string, IPAddress> hosts;
+static std::vector<DnsQuery> dnsQueries;
+static uint64_t dnsDelay = 20000;
+static unsigned long dnsQueryCount = 0;
+static uint16_t nextEphemeralPort = 50000;
+static unsigned long ntpRequests = 0;
+
+static const uint32_t NTP_UNIX_OFFSET = 2208988800UL;
+
+IPAddress::IPAddress(const ip_addr* ip) : address(ip ? ip->addr : 0) {}
+
+void simResetNetwork() {
+  for (WiFiUDP* socket : sockets) socket->queue.clear();
+  networkDelay = nullptr;
+  services.clear();
+  hosts.clear();
+  dnsQueries.clear();
+  dnsDelay = 20000;
+  dnsQueryCount = 0;
+  ntpRequests = 0;
+}
+
+void simSetNetworkDelay(std::function<uint64_t()> delay) {
+  networkDelay = delay;
+}
+
+void simAddService(IPAddress ip, uint16_t port, std::function<void(const SimDatagram&)> handler) {
+  services[std::make_pair((uint32_t)ip, port)] = handler;
+}
+
+void simAddHost(const char* name, IPAddress ip) {
+  hosts[name] = ip;
+}
+
+void simSetDnsDelay(uint64_t micros) {
+  dnsDelay = micros;
+}
+
+unsigned long simDnsQueries() {
+  return dnsQueryCount;
+}
+
+static void enqueue(WiFiUDP* socket, const SimDatagram& datagram) {
+  auto later = std::upper_bound(socket->queue.begin(), socket->queue.end(), datagram.time,
+                                [](uint64_t time, const SimDatagram& d) { return time < d.time; });
+  socket->queue.insert(later, datagram);
+}
+
+void simSend(const SimDatagram& datagram, uint64_t deliverAt) {
+  SimDatagram arriving = datagram;
+  arriving.time = deliverAt;
+  for (WiFiUDP* socket : sockets) {
+    if (socket->port == datagram.toPort && simNodeIP(socket->node) == datagram.to) {
+      enqueue(socket, arriving);
+      return;
+    }
+  }
+}
+
+static void putNtpTimestamp(uint8_t* p, uint64_t micros) {
+  uint32_t seconds = (uint32_t)(micros / 1000000) + NTP_UNIX_OFFSET;
+  uint32_t fraction = (uint32_t)((((uint64_t)(micros % 1000000)) << 32) / 1000000);
+  for (uint8_t i = 0; i < 4; i++) {
+    p[i] = seconds >> (24 - 8 * i);
+    p[4 + i] = fraction >> (24 - 8 * i);
+  }
+}
+
+void simAddNtpServer(IPAddress ip, uint64_t epochMicros, uint64_t processingMicros) {
+  simAddService(ip, 123, [epochMicros, processingMicros](const SimDatagram& request) {
+    if (request.data.size() < 48 || (request.data[0] & 0x07) != 3) return;
+    ntpRequests++;
+    SimDatagram reply;
+    reply.from = request.to;
+    reply.fromPort = request.toPort;
+    reply.to = request.from;
+    reply.toPort = request.fromPort;
+    reply.data.assign(48, 0);
+    reply.data[0] = 0x24;  // LI 0, version 4, mode 4 (server)
+    reply.data[1] = 2;     // Stratum
+    std::copy(request.data.begin() + 40, request.data.begin() + 48, reply.data.begin() + 24);
+    uint64_t sent = request.time + processingMicros;
+    putNtpTimestamp(&reply.data[32], epochMicros + request.time);
+    putNtpTimestamp(&reply.data[40], epochMicros + sent);
+    uint64_t delay = networkDelay ? networkDelay() : 0;
+    if (delay == SIM_DROP) return;
+    simSend(reply, sent + delay);
+  });
+}
+
+unsigned long simNtpRequests() {
+  return ntpRequests;
+}
+
+static bool isMulticast(IPAddress ip) {
+  return ip[0] >= 224 && ip[0] <= 239;
+}
+
+static bool parseAddress(const char* name, IPAddress& ip) {
+  unsigned a, b, c, d;
+  char end;
+  if (sscanf(name, "%u.%u.%u.%u%c", &a, &b, &c, &d, &end) != 4 || a > 255 || b > 255 || c > 255 || d > 255) return false;
+  ip = IPAddress(a, b, c, d);
+  return true;
+}
+
+// ---- WiFiUDP ----
+
+WiFiUDP::WiFiUDP() : node(simNode()), port(0), sendPort(0), readOffset(0), readFromPort(0) {}
+
+WiFiUDP::~WiFiUDP() {
+  stop();
+}
+
+uint8_t WiFiUDP::begin(uint16_t localPort) {
+  stop();
+  node = simNode();
+  port = localPort;
+  sockets.push_back(this);
+  return 1;
+}
+
+uint8_t WiFiUDP::beginMulticast(IPAddress, IPAddress multicast, uint16_t localPort) {
+  begin(localPort);
+  group = multicast;
+  return 1;
+}
+
+void WiFiUDP::stop() {
+  sockets.erase(std::remove(sockets.begin(), sockets.end(), this), sockets.end());
+  port = 0;
+  group = IPAddress();
+  queue.clear();
+  reading.clear();
+  readOffset = 0;
+}
+
+int WiFiUDP::beginPacket(IPAddress ip, uint16_t remotePort) {
+  sendTo = ip;
+  sendPort = remotePort;
+  sending.clear();
+  return 1;
+}
+
+int WiFiUDP::beginPacket(const char* host, uint16_t remotePort) {
+  IPAddress ip;
+  if (!parseAddress(host, ip)) {
+    auto known = hosts.find(host);
+    if (known == hosts.end()) return 0;
+    ip = known->second;
+  }
+  return beginPacket(ip, remotePort);
+}
+
+int WiFiUDP::beginPacketMulticast(IPAddress multicast, uint16_t remotePort, IPAddress, int) {
+  return beginPacket(multicast, remotePort);
+}
+
+size_t WiFiUDP::write(const uint8_t* buf, size_t size) {
+  sending.insert(sending.end(), buf, buf + size);
+  return size;
+}
+
+int WiFiUDP::endPacket() {
+  if (port == 0) {
+    // Unbound sockets send from an ephemeral port
+    port = nextEphemeralPort++;
+    sockets.push_back(this);
+  }
+  SimDatagram datagram;
+  datagram.from = simNodeIP(node);
+  datagram.fromPort = port;
+  datagram.to = sendTo;
+  datagram.toPort = sendPort;
+  datagram.data = sending;
+  simNodeDatagrams(node)++;
+  uint64_t now = simTime();
+
+  if (isMulticast(sendTo)) {
+    // Every other node in the group gets its own copy; the sender does not
+    std::vector<WiFiUDP*> members;
+    for (WiFiUDP* socket : sockets) {
+      if (socket->node != node && socket->group == sendTo && socket->port == sendPort) members.push_back(socket);
+    }
+    for (WiFiUDP* socket : members) {
+      uint64_t delay = networkDelay ? networkDelay() : 0;
+      if (delay == SIM_DROP) continue;
+      datagram.time = now + delay;
+      enqueue(socket, datagram);
+    }
+    return 1;
+  }
+
+  uint64_t delay = networkDelay ? networkDelay() : 0;
+  if (delay == SIM_DROP) return 1;
+  datagram.time = now + delay;
+  auto service = services.find(std::make_pair((uint32_t)sendTo, sendPort));
+  if (service != services.end()) {
+    service->second(datagram);
+  } else {
+    simSend(datagram, datagram.time);
+  }
+  return 1;
+}
+
+int WiFiUDP::parsePacket() {
+  // The unread rest of the previous datagram is dropped, as on the ESP8266
+  reading.clear();
+  readOffset = 0;
+  if (queue.empty() || queue.front().time > simTime()) return 0;
+  SimDatagram& datagram = queue.front();
+  reading.swap(datagram.data);
+  readFrom = datagram.from;
+  readFromPort = datagram.fromPort;
+  queue.pop_front();
+  return reading.size();
+}
+
+int WiFiUDP::read(uint8_t* buf, size_t size) {
+  size_t n = std::min(size, reading.size() - readOffset);
+  memcpy(buf, reading.data() + readOffset, n);
+  readOffset += n;
+  return n;
+}
+
+int WiFiUDP::read() {
+  if (readOffset >= reading.size()) return -1;
+  return reading[readOffset++];
+}
+
+void WiFiUDP::flush() {
+  reading.clear();
+  readOffset = 0;
+}
+
+// ---- DNS ----
+
+err_t dns_gethostbyname(const char* hostname, ip_addr_t* addr, dns_found_callback found, void* callback_arg) {
+  if (!hostname || !addr) return ERR_ARG;
+  IPAddress ip;
+  if (parseAddress(hostname, ip)) {
+    addr->addr = ip;
+    return ERR_OK;
+  }
+  dnsQueryCount++;
+  dnsQueries.push_back(DnsQuery{ hostname, addr, found, callback_arg, simNode(), simTime() + dnsDelay });
+  return ERR_INPROGRESS;
+}
+
+void simProcessNetwork() {
+  // Answers arrive from lwIP between loop() passes, in delay() or yield()
+  uint64_t now = simTime();
+  for (size_t i = 0; i < dnsQueries.size();) {
+    if (dnsQueries[i].doneAt > now) {
+      i++;
+      continue;
+    }
+    DnsQuery query = dnsQueries[i];
+    dnsQueries.erase(dnsQueries.begin() + i);
+    int previous = simNode();
+    simSelectNode(query.node);
+    auto known = hosts.find(query.name);
+    if (known != hosts.end()) {
+      ip_addr_t result = { (uint32_t)known->second };
+      query.found(query.name.c_str(), &result, query.arg);
+    } else {
+      query.found(query.name.c_str(), nullptr, query.arg);
+    }
+    simSelectNode(previous);
+  }
+}
@@ -0,0 +1,17 @@
+#ifndef USER_INTERFACE_H
+#define USER_INTERFACE_H
+
+#include <stdint.h>
+
+// RTC timer: keeps counting through a reset, at 1/4096 us per cycle times
+// the calibration value
+#ifdef __cplusplus
+extern "C" {
+#endif
+uint32_t system_get_rtc_time(void);
+uint32_t system_rtc_clock_cali_proc(void);
+#ifdef __cplusplus
+}
+#endif
+
+#endif
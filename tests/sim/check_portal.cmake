@@ -0,0 +1,58 @@
+# Runs the simulator on the portal replay and checks that frames kept coming
+# and the portal was served while it was open
+execute_process(COMMAND ${SIM} --replay ${REPLAY} --trace ${TRACE} --duration 30
+                RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "sim exited with ${result}")
+endif()
+file(STRINGS ${TRACE} portal REGEX "^P ")
+list(LENGTH portal portalCount)
+if(NOT portalCount EQUAL 2)
+  message(FATAL_ERROR "expected the portal to start and stop once, got: ${portal}")
+endif()
+list(GET portal 0 opened)
+list(GET portal 1 closed)
+string(REGEX MATCH "^P ([0-9]+) 1 " match "${opened}")
+set(openedAt ${CMAKE_MATCH_1})
+string(REGEX MATCH "^P ([0-9]+) 0 ([0-9]+) ([0-9]+)$" match "${closed}")
+set(closedAt ${CMAKE_MATCH_1})
+set(processCalls ${CMAKE_MATCH_2})
+set(processGap ${CMAKE_MATCH_3})
+
+# Longest time without a pushed frame while the portal was open
+file(STRINGS ${TRACE} frames REGEX "^F [0-9]+ ")
+set(previous ${openedAt})
+set(longestGap 0)
+set(portalFrames 0)
+foreach(frame IN LISTS frames)
+  string(REGEX MATCH "^F ([0-9]+) " match "${frame}")
+  set(at ${CMAKE_MATCH_1})
+  if(at GREATER openedAt AND at LESS closedAt)
+    math(EXPR gap "${at} - ${previous}")
+    if(gap GREATER longestGap)
+      set(longestGap ${gap})
+    endif()
+    set(previous ${at})
+    math(EXPR portalFrames "${portalFrames} + 1")
+  endif()
+endforeach()
+math(EXPR gap "${closedAt} - ${previous}")
+if(gap GREATER longestGap)
+  set(longestGap ${gap})
+endif()
+
+file(STRINGS ${TRACE} ok REGEX "^H [0-9]+ (200|302) [0-9]+ ")
+list(LENGTH ok okCount)
+message(STATUS "portal open ${openedAt}-${closedAt} ms: ${portalFrames} frames, longest gap ${longestGap} ms; "
+               "${processCalls} portal passes, longest gap ${processGap} ms; ${okCount} HTTP exchanges ok")
+# Nothing changes while a label is held for WAIT_DURATION (2 s); otherwise
+# the colon blinks every 500 ms
+if(portalFrames LESS 20 OR longestGap GREATER 2100)
+  message(FATAL_ERROR "the display stalled while the portal was open")
+endif()
+if(processGap GREATER 50)
+  message(FATAL_ERROR "the portal was not served every WIFI_POLL_INTERVAL")
+endif()
+if(NOT okCount EQUAL 6)
+  message(FATAL_ERROR "expected 6 successful HTTP exchanges")
+endif()
@@ -0,0 +1,33 @@
+# Runs the simulator on a replay and checks the trace it writes. With
+# -DMETRICS=OFF the firmware has no /metrics, and the replay's scrape must
+# get a 404.
+execute_process(COMMAND ${SIM} --replay ${REPLAY} --trace ${TRACE} --duration 20
+                RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "sim exited with ${result}")
+endif()
+string(REPEAT " [0-9a-f]+" 8 rows)
+file(STRINGS ${TRACE} frames REGEX "^F [0-9]+${rows}$")
+file(STRINGS ${TRACE} loops REGEX "^L [0-9]+ [0-9]+ [0-9]+$")
+file(STRINGS ${TRACE} ok REGEX "^H [0-9]+ (200|302) [0-9]+ ")
+file(STRINGS ${TRACE} exchanges REGEX "^H ")
+list(LENGTH frames frameCount)
+list(LENGTH loops loopCount)
+list(LENGTH ok okCount)
+list(LENGTH exchanges exchangeCount)
+message(STATUS "${frameCount} frames, ${loopCount} loop iterations, ${okCount}/${exchangeCount} HTTP exchanges ok")
+if(frameCount LESS 50 OR loopCount LESS 200)
+  message(FATAL_ERROR "trace too short")
+endif()
+set(expectedOk 6)
+if(METRICS STREQUAL "OFF")
+  set(expectedOk 5)
+  file(STRINGS ${TRACE} scrapes REGEX "^H [0-9]+ 404 [0-9]+ /metrics$")
+  list(LENGTH scrapes scrapeCount)
+  if(NOT scrapeCount EQUAL 1)
+    message(FATAL_ERROR "expected /metrics to be missing")
+  endif()
+endif()
+if(NOT okCount EQUAL expectedOk)
+  message(FATAL_ERROR "expected ${expectedOk} successful HTTP exchanges")
+endif()
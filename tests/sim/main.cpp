@@ -0,0 +1,212 @@
+// Host simulator: runs the sketch's setup() and loop() on the virtual clock,
+// replays timed events against it and writes the frame and loop-cost trace.
+//
+//   sim [--replay FILE] [--trace FILE] [--duration SECONDS] [--flash FILE]
+//       [--realtime] [--http-port PORT] [--loop-cost MICROS]
+//
+// Replay lines are "<ms> <command> [arguments]", in true time since boot:
+//   <ms> wifi up|down          station link of the clock
+//   <ms> get <path>            HTTP GET, reported as an H line
+//   <ms> post <path> <body>    form POST
+//   <ms> portal close          end a running WiFiManager portal
+//   <ms> ntp <ip>|off          where pool.ntp.org points, or no answers
+// Blank lines and lines starting with # are skipped.
+//
+// Besides the F, L and H lines of simtrace.h, the trace gets a line
+// "P <millis> <active> <process calls> <longest gap ms>" whenever the
+// WiFiManager portal starts or stops.
+#include <ESP8266WebServer.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <fstream>
+#include <sstream>
+#include "sim.h"
+#include "simtrace.h"
+
+void setup();
+void loop();
+extern ESP8266WebServer server;
+
+static const uint64_t DEFAULT_EPOCH = 1767225600ULL * 1000000;  // 2026-01-01 00:00 UTC
+static const IPAddress NTP_IP(10, 0, 1, 1);
+
+struct ReplayEvent {
+  uint64_t atMillis;
+  std::string command;
+  std::string arguments;
+};
+
+struct Exchange {
+  int fd;
+  std::string path;
+  std::string response;
+};
+
+static std::vector<Exchange> exchanges;
+
+static bool loadReplay(const char* path, std::vector<ReplayEvent>& events) {
+  std::ifstream in(path);
+  if (!in) return false;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream fields(line);
+    ReplayEvent event;
+    if (!(fields >> event.atMillis >> event.command)) continue;
+    std::getline(fields >> std::ws, event.arguments);
+    events.push_back(event);
+  }
+  return true;
+}
+
+static void startExchange(const std::string& method, const std::string& path, const std::string& body) {
+  if (server.hostPort() == 0) {
+    // Not listening yet: the client gets nothing, as on a real network
+    fprintf(simTraceFile(), "H %lu 0 0 %s\n", millis(), path.c_str());
+    return;
+  }
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(server.hostPort());
+  if (connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+    close(fd);
+    return;
+  }
+  std::string request = method + " " + path + " HTTP/1.1\r\nHost: clock\r\n";
+  if (method == "POST") {
+    request += "Content-Type: application/x-www-form-urlencoded\r\nContent-Length: " + std::to_string(body.size()) + "\r\n";
+  }
+  request += "Connection: close\r\n\r\n" + body;
+  if (write(fd, request.data(), request.size()) != (ssize_t)request.size()) {
+    close(fd);
+    return;
+  }
+  fcntl(fd, F_SETFL, O_NONBLOCK);
+  exchanges.push_back(Exchange{ fd, path, std::string() });
+}
+
+static void pollExchanges(bool flush) {
+  for (size_t i = 0; i < exchanges.size();) {
+    Exchange& exchange = exchanges[i];
+    char buf[4096];
+    ssize_t n;
+    while ((n = read(exchange.fd, buf, sizeof(buf))) > 0) exchange.response.append(buf, n);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && !flush) {
+      i++;
+      continue;
+    }
+    int status = 0;
+    sscanf(exchange.response.c_str(), "HTTP/1.1 %d", &status);
+    size_t head = exchange.response.find("\r\n\r\n");
+    size_t bytes = head == std::string::npos ? 0 : exchange.response.size() - head - 4;
+    fprintf(simTraceFile(), "H %lu %d %zu %s\n", millis(), status, bytes, exchange.path.c_str());
+    close(exchange.fd);
+    exchanges.erase(exchanges.begin() + i);
+  }
+}
+
+static void runEvent(const ReplayEvent& event) {
+  if (event.command == "wifi") {
+    simSetWifi(event.arguments == "up");
+  } else if (event.command == "get") {
+    startExchange("GET", event.arguments, "");
+  } else if (event.command == "post") {
+    size_t space = event.arguments.find(' ');
+    startExchange("POST", event.arguments.substr(0, space), space == std::string::npos ? "" : event.arguments.substr(space + 1));
+  } else if (event.command == "portal" && event.arguments == "close") {
+    simPortal().active = false;
+  } else if (event.command == "ntp") {
+    IPAddress ip;
+    unsigned a, b, c, d;
+    if (sscanf(event.arguments.c_str(), "%u.%u.%u.%u", &a, &b, &c, &d) == 4) ip = IPAddress(a, b, c, d);
+    simAddHost("pool.ntp.org", ip.isSet() ? ip : IPAddress(192, 0, 2, 1));
+  } else {
+    fprintf(stderr, "sim: unknown replay command '%s'\n", event.command.c_str());
+  }
+}
+
+int main(int argc, char** argv) {
+  const char* replayPath = nullptr;
+  const char* tracePath = nullptr;
+  const char* flashPath = nullptr;
+  double seconds = 60;
+  bool realtime = false;
+  int httpPort = 0;
+  uint64_t loopCost = 200;
+  for (int i = 1; i < argc; i++) {
+    std::string option = argv[i];
+    const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (option == "--realtime") {
+      realtime = true;
+      continue;
+    }
+    if (!value) {
+      fprintf(stderr, "sim: %s needs a value\n", option.c_str());
+      return 2;
+    }
+    i++;
+    if (option == "--replay") replayPath = value;
+    else if (option == "--trace") tracePath = value;
+    else if (option == "--flash") flashPath = value;
+    else if (option == "--duration") seconds = atof(value);
+    else if (option == "--http-port") httpPort = atoi(value);
+    else if (option == "--loop-cost") loopCost = strtoull(value, nullptr, 10);
+    else {
+      fprintf(stderr, "sim: unknown option %s\n", option.c_str());
+      return 2;
+    }
+  }
+
+  std::vector<ReplayEvent> events;
+  if (replayPath && !loadReplay(replayPath, events)) {
+    fprintf(stderr, "sim: cannot read %s\n", replayPath);
+    return 1;
+  }
+  FILE* trace = tracePath ? fopen(tracePath, "w") : stdout;
+  if (!trace) {
+    fprintf(stderr, "sim: cannot write %s\n", tracePath);
+    return 1;
+  }
+
+  simReset();
+  if (flashPath) simFlashOpen(flashPath);
+  if (httpPort) simMapPort(80, httpPort);
+  simAddHost("pool.ntp.org", NTP_IP);
+  simAddNtpServer(NTP_IP, DEFAULT_EPOCH, 50);
+  simSetNetworkDelay([] { return (uint64_t)2000; });
+  simTraceOpen(trace);
+  simSetRealtime(realtime);
+
+  setup();
+  if (httpPort) fprintf(stderr, "sim: serving http://127.0.0.1:%u/ once WiFi is up\n", httpPort);
+
+  // Each iteration costs loopCost of virtual CPU time, so a loop() that
+  // finds nothing to sleep for still moves the clock on
+  const uint64_t end = (uint64_t)(seconds * 1e6);
+  size_t next = 0;
+  bool portalActive = false;
+  while (simTime() < end) {
+    while (next < events.size() && events[next].atMillis * 1000 <= simTime()) {
+      runEvent(events[next++]);
+    }
+    simTraceLoopStart();
+    loop();
+    if (!realtime) simAdvance(loopCost);
+    pollExchanges(false);
+    const SimPortal& portal = simPortal();
+    if (portal.active != portalActive) {
+      portalActive = portal.active;
+      fprintf(trace, "P %lu %d %lu %lu\n", millis(), portalActive, portal.processCalls, portal.maxProcessGap);
+    }
+  }
+  pollExchanges(true);
+  fputs(simSerialOutput().c_str(), stderr);
+  if (trace != stdout) fclose(trace);
+  return 0;
+}
@@ -0,0 +1,47 @@
+// trace.h hooks for the simulator
+#include <chrono>
+#include "trace.h"
+#include "max7219.h"
+#include "simtrace.h"
+
+static FILE* traceFile = nullptr;
+static std::chrono::steady_clock::time_point loopStart;
+
+// The chain is read back through the module wiring, as MD_MAX72XX
+// documents it, so a wrong remap in the firmware shows up in the trace
+static SimWiring wiringOf(MD_MAX72XX::moduleType_t type) {
+  switch (type) {
+    case MD_MAX72XX::PAROLA_HW: return SIM_PAROLA;
+    case MD_MAX72XX::GENERIC_HW: return SIM_GENERIC;
+    case MD_MAX72XX::ICSTATION_HW: return SIM_ICSTATION;
+    default: return SIM_FC16;
+  }
+}
+
+void simTraceOpen(FILE* out) {
+  traceFile = out;
+}
+
+FILE* simTraceFile() {
+  return traceFile;
+}
+
+void simTraceLoopStart() {
+  loopStart = std::chrono::steady_clock::now();
+}
+
+void traceFrame(FrameBuffer&) {
+  if (!traceFile) return;
+  SimWiring wiring = wiringOf(HARDWARE_TYPE);
+  fprintf(traceFile, "F %lu", millis());
+  for (uint8_t row = 0; row < 8; row++) {
+    fprintf(traceFile, " %s", simMatrix.rowHex(wiring, row).c_str());
+  }
+  fputc('\n', traceFile);
+}
+
+void traceLoopCost(unsigned long busyMicros) {
+  if (!traceFile) return;
+  long long hostNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - loopStart).count();
+  fprintf(traceFile, "L %lu %lu %lld\n", millis(), busyMicros, hostNanos);
+}
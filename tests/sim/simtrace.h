@@ -0,0 +1,18 @@
+#ifndef SIMTRACE_H
+#define SIMTRACE_H
+
+#include <stdio.h>
+
+// Trace output of the simulator. The firmware's trace.h hooks write here:
+//   F <millis> <row0> ... <row7>       what the modules show after a pushed
+//                                      frame, one hex string per row,
+//                                      leftmost device first
+//   L <millis> <micros> <host ns>      one loop() iteration: virtual CPU
+//                                      time and host time spent in it
+// and the runner adds
+//   H <millis> <status> <bytes> <path> an HTTP exchange from the replay
+void simTraceOpen(FILE* out);
+void simTraceLoopStart();
+FILE* simTraceFile();
+
+#endif
@@ -0,0 +1,3 @@
+// The sketch itself, built as a translation unit of the simulator
+#include <Arduino.h>
+#include "../../MultiZoneMatrixClock.ino"
@@ -0,0 +1,40 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <stdio.h>
+#include <chrono>
+
+// Minimal assertions for the host tests: a failed check is reported and
+// counted, and main() returns checkResult()
+static int checkFailures = 0;
+
+#define CHECK(cond) \
+  do { \
+    if (!(cond)) { \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+      checkFailures++; \
+    } \
+  } while (0)
+
+#define CHECK_EQ(a, b) \
+  do { \
+    long long checkA = (long long)(a), checkB = (long long)(b); \
+    if (checkA != checkB) { \
+      fprintf(stderr, "%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", __FILE__, __LINE__, #a, #b, checkA, checkB); \
+      checkFailures++; \
+    } \
+  } while (0)
+
+static inline int checkResult() {
+  if (checkFailures) fprintf(stderr, "%d check(s) failed\n", checkFailures);
+  return checkFailures ? 1 : 0;
+}
+
+// Host nanoseconds per call of fn over n calls, for the benchmarks
+template <class F> double nanosPerCall(long n, F fn) {
+  auto start = std::chrono::steady_clock::now();
+  for (long i = 0; i < n; i++) fn(i);
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / n;
+}
+
+#endif
@@ -0,0 +1,277 @@
+// Twenty clocks on one LAN for two hours: one leader synced by NTP, the rest
+// following its beacons over a WiFi link with 2 ms + 5 ms (mean) delay, 100 ms
+// spikes on 10% of the packets and 2% loss. Checks how closely the followers
+// agree, how closely they step their rotation with the leader, the packets
+// sent, that forged and replayed beacons are dropped, and the fallback to NTP
+// once the leader goes quiet.
+#include <WiFiUdp.h>
+#include <bearssl/bearssl_hmac.h>
+#include <math.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include "fleetsync.h"
+#include "sim.h"
+#include "check.h"
+
+static const uint64_t EPOCH = 1767225600ULL * 1000000;  // 2026-01-01 00:00 UTC
+static const IPAddress NTP_IP(10, 0, 1, 1);
+static const uint64_t SECOND = 1000000;
+static const uint64_t HOUR = 3600 * SECOND;
+static const int FOLLOWERS = 19;
+static const uint64_t SETTLED = 3 * 60 * SECOND;  // Judged from here on
+static const uint64_t RUN = 2 * HOUR;
+static const unsigned long STEP_AHEAD = 7000;     // The leader announces a step this far ahead
+static const uint64_t STEP_EVERY = 14 * SECOND;
+
+struct Clock {
+  int node;
+  double ppm;
+  WiFiUDP udp;
+  NtpClock clock;
+  FleetSync fleet;
+  Clock(int n, double p) : node(n), ppm(p), clock(udp, NTP_SERVER), fleet(clock) {}
+};
+
+// Wire layout of a beacon (fleetsync.cpp): 32 bytes with the leader time at
+// 16, then the HMAC
+static const size_t BEACON_TIME = 16;
+static const size_t BEACON_SIGNED = 32;
+static const size_t BEACON_SIZE = BEACON_SIGNED + 32;
+
+static double percentile(std::vector<double> values, double p) {
+  std::sort(values.begin(), values.end());
+  return values[std::min(values.size() - 1, (size_t)(p * values.size()))];
+}
+
+static void run(Clock& c) {
+  simSelectNode(c.node);
+  if ((long)(millis() - c.clock.getNextDeadline()) >= 0) c.clock.poll();
+  if ((long)(millis() - c.fleet.getNextDeadline()) >= 0) c.fleet.process();
+}
+
+int main() {
+  simReset();
+  simAddNtpServer(NTP_IP, EPOCH, 50);
+  simAddHost(NTP_SERVER, NTP_IP);
+  std::mt19937 rng(7);
+  std::exponential_distribution<double> tail(1.0 / 5000);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  simSetNetworkDelay([&] {
+    if (uniform(rng) < 0.02) return SIM_DROP;
+    double delay = 2000 + tail(rng);
+    if (uniform(rng) < 0.1) delay += uniform(rng) * 100000;
+    return (uint64_t)delay;
+  });
+
+  // Node 0 is a stranger on the LAN: it records beacons and sends its own
+  int stranger = simNode();
+  WiFiUDP tap;
+  tap.beginMulticast(simNodeIP(stranger), FLEET_MULTICAST_GROUP, FLEET_PORT);
+
+  std::uniform_real_distribution<double> ppm(-50, 50);
+  std::uniform_real_distribution<double> boot(0, 5 * SECOND);
+  std::vector<std::unique_ptr<Clock>> clocks;
+  for (int i = 0; i <= FOLLOWERS; i++) {
+    double error = ppm(rng);
+    int node = simAddNode(error, (uint64_t)boot(rng));
+    simSelectNode(node);
+    clocks.emplace_back(new Clock(node, error));
+    clocks.back()->fleet.setRole(i == 0 ? FLEET_LEADER : FLEET_FOLLOWER);
+  }
+  Clock& leader = *clocks[0];
+  simAdvance(6 * SECOND);
+  for (auto& c : clocks) {
+    simSelectNode(c->node);
+    c->clock.begin();
+  }
+
+  std::vector<double> spread, stepError;
+  std::vector<unsigned long> followerPackets(clocks.size());
+  unsigned long leaderPackets = 0;
+  uint64_t nextSample = SETTLED, nextStep = 30 * SECOND, stepAt = 0;
+  std::vector<bool> stepSeen(clocks.size());
+  std::vector<uint8_t> recorded, stale;
+  bool forged = false, replayed = false;
+  long jumped = 0;
+
+  while (simTime() < RUN) {
+    for (auto& c : clocks) run(*c);
+
+    if (simTime() >= nextStep) {
+      simSelectNode(leader.node);
+      leader.fleet.setNextStep(millis() + STEP_AHEAD);
+      stepAt = simTime() + (uint64_t)(STEP_AHEAD * 1000 / (1 + leader.ppm * 1e-6));
+      std::fill(stepSeen.begin(), stepSeen.end(), false);
+      nextStep += STEP_EVERY;
+    }
+    // Where each follower puts the step, once it has heard of it
+    for (size_t i = 1; i < clocks.size(); i++) {
+      Clock& c = *clocks[i];
+      simSelectNode(c.node);
+      unsigned long at;
+      if (!stepAt || stepSeen[i] || simTime() + 3 * SECOND < stepAt || !c.fleet.getLeaderStep(at)) continue;
+      stepSeen[i] = true;
+      uint64_t followerAt = simTime() + (uint64_t)((long)(at - millis()) * 1000 / (1 + c.ppm * 1e-6));
+      if (simTime() >= SETTLED) stepError.push_back(fabs((double)followerAt - (double)stepAt) / 1000);
+    }
+
+    // The stranger keeps the latest beacon it overheard
+    simSelectNode(stranger);
+    while (tap.parsePacket() > 0) {
+      recorded.resize(BEACON_SIZE);
+      if (tap.read(recorded.data(), recorded.size()) != (int)BEACON_SIZE) recorded.clear();
+    }
+
+    if (simTime() >= nextSample) {
+      nextSample += SECOND;
+      std::vector<double> times;
+      for (size_t i = 1; i < clocks.size(); i++) {
+        simSelectNode(clocks[i]->node);
+        times.push_back((double)clocks[i]->clock.nowMicros());
+      }
+      if (simTime() == SETTLED) {
+        for (size_t i = 0; i < clocks.size(); i++) followerPackets[i] = simDatagramsSent(clocks[i]->node);
+        leaderPackets = simDatagramsSent(leader.node);
+      }
+      if (simTime() > SETTLED) {
+        for (size_t i = 0; i < times.size(); i++) {
+          for (size_t j = i + 1; j < times.size(); j++) spread.push_back(fabs(times[i] - times[j]) / 1000);
+        }
+      }
+
+      // An hour in, the stranger sends a beacon an hour ahead under its own
+      // key, and a minute later replays one it recorded a minute before
+      if (simTime() >= HOUR && !forged && recorded.size() == BEACON_SIZE) {
+        std::vector<uint8_t> beacon = recorded;
+        uint64_t utcMicros;
+        memcpy(&utcMicros, &beacon[BEACON_TIME], sizeof(utcMicros));
+        utcMicros += HOUR;
+        memcpy(&beacon[BEACON_TIME], &utcMicros, sizeof(utcMicros));
+        br_hmac_key_context key;
+        br_hmac_context hmac;
+        br_hmac_key_init(&key, &br_sha256_vtable, "guessed", 7);
+        br_hmac_init(&hmac, &key, 32);
+        br_hmac_update(&hmac, beacon.data(), BEACON_SIGNED);
+        br_hmac_out(&hmac, &beacon[BEACON_SIGNED]);
+        tap.beginPacketMulticast(FLEET_MULTICAST_GROUP, FLEET_PORT, simNodeIP(stranger));
+        tap.write(beacon.data(), beacon.size());
+        tap.endPacket();
+        forged = true;
+        jumped = 0;
+      }
+      if (forged && stale.empty() && simTime() >= HOUR + 60 * SECOND) stale = recorded;
+      if (!replayed && !stale.empty() && simTime() >= HOUR + 120 * SECOND) {
+        tap.beginPacketMulticast(FLEET_MULTICAST_GROUP, FLEET_PORT, simNodeIP(stranger));
+        tap.write(stale.data(), stale.size());
+        tap.endPacket();
+        replayed = true;
+      }
+      // Neither gets a follower anywhere near an hour or a minute off
+      for (size_t i = 1; i < clocks.size(); i++) {
+        simSelectNode(clocks[i]->node);
+        if (forged && labs(clocks[i]->fleet.getLastOffset()) > 1000000) jumped++;
+      }
+    }
+
+    // Sleep until the earliest deadline of any clock; followers near a
+    // beacon poll every millisecond
+    long wait = 1000;
+    for (auto& c : clocks) {
+      simSelectNode(c->node);
+      wait = std::min(wait, (long)(c->clock.getNextDeadline() - millis()));
+      wait = std::min(wait, (long)(c->fleet.getNextDeadline() - millis()));
+    }
+    uint64_t until = simTime() + (uint64_t)std::max(wait, 1L) * 1000;
+    if (until > nextSample) until = nextSample;
+    simAdvance(until - simTime());
+  }
+
+  double hours = (double)(RUN - SETTLED) / HOUR;
+  unsigned long followerSent = 0, rejected = 0, late = 0;
+  bool allFollowing = true;
+  for (size_t i = 1; i < clocks.size(); i++) {
+    followerSent += simDatagramsSent(clocks[i]->node) - followerPackets[i];
+    rejected += clocks[i]->fleet.getRejected();
+    late += clocks[i]->fleet.getLate();
+    allFollowing &= clocks[i]->fleet.isFollowing();
+  }
+  double leaderRate = (simDatagramsSent(leader.node) - leaderPackets) / hours;
+  printf("follower spread ms: p50 %.2f p99 %.2f max %.2f\n", percentile(spread, 0.5), percentile(spread, 0.99),
+         percentile(spread, 1));
+  printf("rotation step vs leader ms: p50 %.2f p99 %.2f max %.2f (%zu steps)\n", percentile(stepError, 0.5),
+         percentile(stepError, 0.99), percentile(stepError, 1), stepError.size());
+  printf("packets/hour: leader %.0f, followers %lu in total; beacons rejected %lu, late %lu\n", leaderRate,
+         followerSent, rejected, late);
+
+  CHECK(allFollowing);
+  // The leader trusts single NTP exchanges over the same link, so its clock
+  // moves by up to a few tens of ms now and then. Followers take that on
+  // together, at the end of a filter group, but their rotation steps are
+  // off by it until then.
+  CHECK(percentile(spread, 0.5) < 1);
+  CHECK(percentile(spread, 0.99) < 10);
+  CHECK(percentile(stepError, 0.5) < 5);
+  CHECK(percentile(stepError, 0.99) < 25);
+  CHECK(stepError.size() > (size_t)FOLLOWERS * 400);
+  // A beacon every 2 s, a step announcement every 14 s, a few NTP exchanges
+  CHECK(leaderRate > 2000 && leaderRate < 2150);
+  CHECK_EQ(followerSent, 0);
+  // Both the forged and the replayed beacon reach every follower but a few
+  // lost ones, and neither gets through. Nothing else is rejected: the
+  // leader's own beacons overtaken on the way are only late.
+  CHECK(forged && replayed);
+  CHECK(rejected >= (unsigned long)FOLLOWERS && rejected <= 2 * (unsigned long)FOLLOWERS);
+  CHECK_EQ(jumped, 0);
+
+  // The leader's clock steps an hour ahead and the followers take it on.
+  // When it steps back, its beacons are older than the last ones taken:
+  // followers lose the leader, check their own clocks against NTP and take
+  // it up again.
+  simSelectNode(leader.node);
+  leader.clock.applyExternalOffset(HOUR);
+  uint64_t stepped = simTime();
+  bool allAhead = false;
+  while (!allAhead && simTime() < stepped + 120 * SECOND) {
+    for (auto& c : clocks) run(*c);
+    simAdvance(1000);
+    allAhead = true;
+    for (size_t i = 1; i < clocks.size(); i++) {
+      simSelectNode(clocks[i]->node);
+      allAhead &= clocks[i]->clock.nowMicros() > EPOCH + simTime() + HOUR / 2;
+    }
+  }
+  CHECK(allAhead);
+  simSelectNode(leader.node);
+  if (leader.clock.nowMicros() > EPOCH + simTime() + HOUR / 2) leader.clock.applyExternalOffset(-(int64_t)HOUR);
+  // Long enough for a lost NTP exchange and its retry
+  uint64_t back = simTime();
+  while (simTime() < back + FLEET_LEADER_TIMEOUT * 1000 + 2 * NTP_RETRY_INTERVAL * 6000 + 10 * SECOND) {
+    for (auto& c : clocks) run(*c);
+    simAdvance(1000);
+  }
+  simSelectNode(leader.node);
+  uint64_t leaderNow = leader.clock.nowMicros();
+  for (size_t i = 1; i < clocks.size(); i++) {
+    simSelectNode(clocks[i]->node);
+    CHECK(clocks[i]->fleet.isFollowing());
+    CHECK_EQ(clocks[i]->fleet.getLeaderLosses(), 1);
+    CHECK(fabs((double)clocks[i]->clock.nowMicros() - (double)leaderNow) < 50000);
+  }
+
+  // The leader goes quiet: followers are back on NTP within the timeout
+  simSelectNode(leader.node);
+  leader.fleet.setRole(FLEET_OFF);
+  uint64_t quiet = simTime();
+  unsigned long ntpBefore = simNtpRequests();
+  while (simTime() < quiet + FLEET_LEADER_TIMEOUT * 1000 + 2 * SECOND) {
+    for (auto& c : clocks) run(*c);
+    simAdvance(1000);
+  }
+  for (size_t i = 1; i < clocks.size(); i++) {
+    CHECK(!clocks[i]->fleet.isFollowing());
+    CHECK_EQ(clocks[i]->fleet.getLeaderLosses(), 2);
+  }
+  CHECK(simNtpRequests() - ntpBefore >= (unsigned long)FOLLOWERS);
+  return checkResult();
+}
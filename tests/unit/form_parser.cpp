@@ -0,0 +1,208 @@
+// parseSettingsForm(): fuzzed against a straightforward split-and-decode
+// reference, checked for heap use and writes past the body, and timed at 6,
+// 64 and 512 timezone fields against the String-per-field parsing /save
+// used before
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include "formparser.h"
+#include "check.h"
+
+static long allocations = 0;
+
+void* operator new(size_t size) {
+  allocations++;
+  void* p = malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void* p) noexcept {
+  free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  free(p);
+}
+
+static bool sameForm(const SettingsForm& a, const SettingsForm& b) {
+  return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+// What the form should parse to: split on '&' and '=', decode with
+// std::string, one parseSettingsField() per pair
+static SettingsForm reference(const std::string& body) {
+  SettingsForm form;
+  beginSettingsForm(form);
+  size_t start = 0;
+  while (start < body.size()) {
+    size_t end = body.find('&', start);
+    if (end == std::string::npos) end = body.size();
+    std::string pair = body.substr(start, end - start);
+    size_t equalsAt = pair.find('=');
+    std::string parts[2] = { pair.substr(0, equalsAt), equalsAt == std::string::npos ? "" : pair.substr(equalsAt + 1) };
+    bool valid = true;
+    for (std::string& part : parts) {
+      std::string decoded;
+      for (size_t i = 0; i < part.size(); i++) {
+        if (part[i] == '+') {
+          decoded += ' ';
+        } else if (part[i] == '%') {
+          if (i + 2 >= part.size() || !isxdigit((unsigned char)part[i + 1]) || !isxdigit((unsigned char)part[i + 2])) {
+            valid = false;
+            break;
+          }
+          decoded += (char)strtol(part.substr(i + 1, 2).c_str(), nullptr, 16);
+          i += 2;
+        } else {
+          decoded += part[i];
+        }
+      }
+      part = decoded;
+    }
+    if (!valid) {
+      form.rejected++;
+    } else if (!parts[0].empty()) {
+      parseSettingsField(form, parts[0].data(), parts[0].size(), parts[1].data(), parts[1].size());
+    }
+    start = end + 1;
+  }
+  return form;
+}
+
+static SettingsForm parse(const std::string& body, bool& overran) {
+  // Guard bytes after the body must come back untouched
+  std::vector<char> buffer(body.begin(), body.end());
+  buffer.insert(buffer.end(), 16, '\x5a');
+  SettingsForm form;
+  beginSettingsForm(form);
+  parseSettingsForm(form, buffer.data(), body.size());
+  overran = false;
+  for (size_t i = body.size(); i < buffer.size(); i++) overran |= buffer[i] != '\x5a';
+  return form;
+}
+
+static bool withinBounds(const SettingsForm& form) {
+  if (form.intensity > 15 || form.timeDisplayDuration > 60 || form.orderLength > TZ_COUNT) return false;
+  bool seen[TZ_COUNT] = {};
+  for (uint8_t i = 0; i < form.orderLength; i++) {
+    if (form.order[i] >= TZ_COUNT || seen[form.order[i]]) return false;
+    seen[form.order[i]] = true;
+  }
+  for (int tz = 0; tz < TZ_COUNT; tz++) {
+    if (form.enabled[tz] > 1 || form.dwell[tz] > 60) return false;
+  }
+  return form.layout <= LAYOUT_ZONED && form.fleetRole <= FLEET_FOLLOWER;
+}
+
+static void fuzz() {
+  static const char* const PIECES[] = {
+    "tz", "dwell", "intensity", "timeDisplayDuration", "format", "layout", "fleet", "debug",
+    "=", "&", "%", "%2", "%41", "%zz", "+", "on", "12", "zoned", "leader", "follower", "off",
+    "0", "1", "5", "17", "18", "60", "61", "99999", "123456", "00015"
+  };
+  const size_t PIECE_COUNT = sizeof(PIECES) / sizeof(PIECES[0]);
+  std::mt19937 rng(19);
+  long mismatches = 0, overruns = 0, outOfBounds = 0;
+  const long RUNS = 100000;
+  for (long run = 0; run < RUNS; run++) {
+    std::string body;
+    size_t pieces = rng() % 24;
+    for (size_t i = 0; i < pieces; i++) {
+      if (rng() % 8 == 0) {
+        body += (char)(rng() % 256);  // Any byte at all
+      } else {
+        body += PIECES[rng() % PIECE_COUNT];
+      }
+    }
+    bool overran;
+    SettingsForm form = parse(body, overran);
+    mismatches += !sameForm(form, reference(body));
+    overruns += overran;
+    outOfBounds += !withinBounds(form);
+  }
+  printf("fuzz: %ld bodies, %ld differ from the reference, %ld overran, %ld out of bounds\n",
+         RUNS, mismatches, overruns, outOfBounds);
+  CHECK_EQ(mismatches, 0);
+  CHECK_EQ(overruns, 0);
+  CHECK_EQ(outOfBounds, 0);
+}
+
+// A page post with this many timezone fields: checkboxes and dwell times,
+// wrapping around the catalog as a larger one would not
+static std::string pagePost(int fields) {
+  std::string body = "intensity=7&format=24&layout=rotate&fleet=off&timeDisplayDuration=10";
+  for (int i = 0; i < fields; i++) {
+    int tz = i / 2 % TZ_COUNT;
+    body += i % 2 ? "&dwell" + std::to_string(tz) + "=" + std::to_string(1 + i % 60) : "&tz" + std::to_string(tz) + "=on";
+  }
+  return body;
+}
+
+// The old handler: the server splits every field into Strings, then one
+// hasArg("tz" + String(i)) per zone and arg(...).toInt() per number
+static SettingsForm parseWithStrings(const std::string& body) {
+  std::vector<String> names, values;
+  size_t start = 0;
+  while (start < body.size()) {
+    size_t end = body.find('&', start);
+    if (end == std::string::npos) end = body.size();
+    size_t equalsAt = body.find('=', start);
+    if (equalsAt > end) equalsAt = end;
+    names.push_back(String(body.substr(start, equalsAt - start)));
+    values.push_back(String(equalsAt < end ? body.substr(equalsAt + 1, end - equalsAt - 1) : std::string()));
+    start = end + 1;
+  }
+  auto find = [&](const String& name) -> int {
+    for (size_t i = 0; i < names.size(); i++) {
+      if (names[i] == name) return i;
+    }
+    return -1;
+  };
+  SettingsForm form;
+  beginSettingsForm(form);
+  for (int tz = 0; tz < TZ_COUNT; tz++) {
+    form.enabled[tz] = find(String("tz") + String(tz)) >= 0;
+    int dwell = find(String("dwell") + String(tz));
+    if (dwell >= 0) form.dwell[tz] = values[dwell].toInt();
+  }
+  int intensity = find("intensity");
+  if (intensity >= 0) form.intensity = values[intensity].toInt();
+  int duration = find("timeDisplayDuration");
+  if (duration >= 0) form.timeDisplayDuration = values[duration].toInt();
+  return form;
+}
+
+static void bench() {
+  const int FIELDS[] = { 6, 64, 512 };
+  for (int fields : FIELDS) {
+    std::string body = pagePost(fields);
+    std::vector<char> work(body.size());
+    SettingsForm form;
+    const long RUNS = 5000;
+
+    long before = allocations;
+    double inPlace = nanosPerCall(RUNS, [&](long) {
+      memcpy(work.data(), body.data(), body.size());
+      beginSettingsForm(form);
+      parseSettingsForm(form, work.data(), body.size());
+    });
+    double inPlaceAllocations = (double)(allocations - before) / RUNS;
+    CHECK_EQ(form.rejected, 0);
+
+    before = allocations;
+    double withStrings = nanosPerCall(RUNS, [&](long) { form = parseWithStrings(body); });
+    double stringAllocations = (double)(allocations - before) / RUNS;
+
+    printf("%3d fields, %5zu bytes: in place %8.0f ns, %.0f allocations; Strings %8.0f ns, %.0f allocations\n",
+           fields, body.size(), inPlace, inPlaceAllocations, withStrings, stringAllocations);
+    CHECK_EQ(inPlaceAllocations, 0);
+  }
+}
+
+int main() {
+  fuzz();
+  bench();
+  return checkResult();
+}
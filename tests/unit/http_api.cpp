@@ -0,0 +1,162 @@
+// Bytes per poll and handler time for the page and the JSON API, fresh and
+// revalidated with If-None-Match, against the whole sketch's web server
+#include <ESP8266WebServer.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include "ntpclock.h"
+#include "webserver.h"
+#include "sim.h"
+#include "check.h"
+
+void setup();
+void loop();
+extern ESP8266WebServer server;
+extern NtpClock ntpClock;
+extern WebServerManager webManager;
+
+static const uint64_t EPOCH = 1767225600ULL * 1000000;  // 2026-01-01 00:00 UTC
+static const IPAddress NTP_IP(10, 0, 1, 1);
+static const int RUNS = 200;
+
+struct Response {
+  int status;
+  size_t wireBytes;    // Status line, headers and body
+  size_t bodyBytes;
+  long contentLength;
+  std::string etag;
+  std::string body;
+  double handleNanos;  // Host time in server.handleClient()
+};
+
+// With served, the request goes through WebServerManager::handleClient(),
+// as loop() makes it, and served is what that returned
+static Response request(const char* path, const std::string& etag, bool* served = NULL) {
+  Response response = {};
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(server.hostPort());
+  if (connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+    close(fd);
+    return response;
+  }
+  std::string text = std::string("GET ") + path + " HTTP/1.1\r\nHost: clock\r\n";
+  if (!etag.empty()) text += "If-None-Match: " + etag + "\r\n";
+  text += "Connection: close\r\n\r\n";
+  if (write(fd, text.data(), text.size()) != (ssize_t)text.size()) {
+    close(fd);
+    return response;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  if (served) {
+    *served = webManager.handleClient();
+  } else {
+    server.handleClient();
+  }
+  response.handleNanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+  std::string raw;
+  char buf[4096];
+  ssize_t n;
+  while ((n = read(fd, buf, sizeof(buf))) > 0) raw.append(buf, n);
+  close(fd);
+
+  sscanf(raw.c_str(), "HTTP/1.1 %d", &response.status);
+  size_t head = raw.find("\r\n\r\n");
+  if (head == std::string::npos) return response;
+  std::string headers = raw.substr(0, head + 2);
+  response.wireBytes = raw.size();
+  response.body = raw.substr(head + 4);
+  response.bodyBytes = response.body.size();
+  response.contentLength = -1;
+  size_t at = headers.find("Content-Length: ");
+  if (at != std::string::npos) response.contentLength = atol(headers.c_str() + at + 16);
+  at = headers.find("ETag: ");
+  if (at != std::string::npos) response.etag = headers.substr(at + 6, headers.find("\r\n", at) - at - 6);
+  return response;
+}
+
+// The median of RUNS requests, after one to warm up
+static Response measure(const char* path, const std::string& etag) {
+  Response response = request(path, etag);
+  std::vector<double> nanos;
+  for (int i = 0; i < RUNS; i++) {
+    response = request(path, etag);
+    nanos.push_back(response.handleNanos);
+  }
+  std::sort(nanos.begin(), nanos.end());
+  response.handleNanos = nanos[RUNS / 2];
+  return response;
+}
+
+static void report(const char* path, const char* kind, const Response& response) {
+  printf("%-15s %-12s %3d %6zu bytes on the wire %6zu body %8.0f ns handler\n",
+         path, kind, response.status, response.wireBytes, response.bodyBytes, response.handleNanos);
+}
+
+int main() {
+  simReset();
+  simAddHost(NTP_SERVER, NTP_IP);
+  simAddNtpServer(NTP_IP, EPOCH, 50);
+  simSetNetworkDelay([] { return (uint64_t)2000; });
+  setup();
+  // Up, serving and synced; the clock does not move during the requests, so
+  // /api/state keeps its ETag too
+  while ((server.hostPort() == 0 || !ntpClock.isSynced()) && simTime() < 30000000) {
+    loop();
+    simAdvance(200);
+  }
+  CHECK(server.hostPort() != 0);
+  CHECK(ntpClock.isSynced());
+
+  const char* const PATHS[] = { "/", "/api/state", "/api/settings", "/api/timezones" };
+  size_t pageBytes = 0;
+  for (const char* path : PATHS) {
+    Response fresh = measure(path, "");
+    Response revalidated = measure(path, fresh.etag);
+    report(path, "fresh", fresh);
+    report(path, "revalidated", revalidated);
+
+    CHECK_EQ(fresh.status, 200);
+    CHECK_EQ(fresh.contentLength, (long)fresh.bodyBytes);
+    CHECK(!fresh.etag.empty());
+    CHECK_EQ(revalidated.status, 304);
+    CHECK_EQ(revalidated.bodyBytes, 0);
+    if (path[1] == '\0') {
+      pageBytes = fresh.wireBytes;
+    } else {
+      CHECK(fresh.body.front() == '{' && fresh.body.back() == '}');
+      // Polling the state or the settings costs a fraction of reloading the page
+      if (strcmp(path, "/api/timezones") != 0) CHECK(fresh.wireBytes * 4 < pageBytes);
+    }
+    CHECK(revalidated.wireBytes * 4 < pageBytes);
+  }
+
+  // Where settings are saved is on /api/state
+  Response state = request("/api/state", "");
+  CHECK(state.body.find("\"store\":\"flash\",\"storeFailures\":0") != std::string::npos);
+
+  // Every zone listed stays within the bound the response buffer is sized by
+  Response timezones = request("/api/timezones", "");
+  printf("/api/timezones: %zu of %zu bytes for %d zones\n", timezones.bodyBytes, TZ_JSON_MAX, TZ_COUNT);
+  CHECK(timezones.bodyBytes <= TZ_JSON_MAX);
+
+  // A scrape counts as served, back to back too, so it reaches the latency
+  // histogram and loop() looks for the next request at once
+  for (int i = 0; i < 2; i++) {
+    bool served = false;
+    Response metrics = request("/metrics", "", &served);
+    CHECK_EQ(metrics.status, 200);
+    CHECK(served);
+  }
+  bool served = true;
+  request("/nothing-here", "", &served);
+  CHECK(!served);
+  return checkResult();
+}
@@ -0,0 +1,109 @@
+// MatrixDriver for each module type MD_MAX72XX supports: the registers
+// remap() and writeDigit() latch into the chain, read back through the chain
+// model's description of the wiring. Built with MD_MAX72XX_REAL (see
+// CMakeLists.txt, MD_MAX72XX_DIR) it also checks them against the registers
+// the real library latches for the same rows with setRow() and update().
+#include <random>
+#include <MD_MAX72XX.h>
+#include "matrixdriver.h"
+#include "max7219.h"
+#include "sim.h"
+#include "check.h"
+
+static const uint8_t DEVICES = 4;
+static const uint8_t CS = 15;
+
+// Device rows, bit c = column c from the right of the device
+typedef uint8_t Rows[DEVICES][8];
+
+template <MD_MAX72XX::moduleType_t HARDWARE>
+static void pushDriver(const Rows& rows) {
+  typedef MatrixDriver<HARDWARE, DEVICES, CS> Driver;
+  uint8_t registers[DEVICES][8];
+  for (uint8_t device = 0; device < DEVICES; device++) Driver::remap(rows[device], registers[device]);
+  for (uint8_t digit = 0; digit < 8; digit++) Driver::writeDigit(digit, registers);
+}
+
+// The chain read through the wiring shows the rows
+static bool chainShows(const SimWiring& wiring, const Rows& rows) {
+  for (uint8_t device = 0; device < DEVICES; device++) {
+    for (uint8_t row = 0; row < 8; row++) {
+      for (uint8_t c = 0; c < 8; c++) {
+        uint16_t column = DEVICES * 8 - 1 - (device * 8 + c);
+        if (simMatrix.pixel(wiring, row, column) != (bool)(rows[device][row] >> c & 1)) return false;
+      }
+    }
+  }
+  return true;
+}
+
+#ifdef MD_MAX72XX_REAL
+static void latched(uint8_t (*registers)[8]) {
+  for (uint8_t device = 0; device < DEVICES; device++) {
+    for (uint8_t digit = 0; digit < 8; digit++) registers[device][digit] = simMatrix.digit(device, digit);
+  }
+}
+
+// The same rows through the library latch the same registers
+template <MD_MAX72XX::moduleType_t HARDWARE>
+static bool libraryAgrees(const Rows& rows) {
+  simMatrix.reset(DEVICES, CS);
+  MD_MAX72XX mx(HARDWARE, CS, DEVICES);
+  mx.begin();
+  mx.control(MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
+  for (uint8_t device = 0; device < DEVICES; device++) {
+    for (uint8_t row = 0; row < 8; row++) mx.setRow(device, row, rows[device][row]);
+  }
+  mx.update();
+  uint8_t library[DEVICES][8];
+  latched(library);
+
+  simMatrix.reset(DEVICES, CS);
+  pushDriver<HARDWARE>(rows);
+  uint8_t driver[DEVICES][8];
+  latched(driver);
+  return memcmp(library, driver, sizeof(driver)) == 0;
+}
+#endif
+
+template <MD_MAX72XX::moduleType_t HARDWARE>
+static void testWiring(const char* name, const SimWiring& wiring) {
+  std::mt19937 rng(HARDWARE + 1);
+  int failures = 0, frames = 0;
+  Rows rows;
+
+  // Every single pixel, then random frames
+  for (int frame = 0; frame < DEVICES * 64 + 200; frame++) {
+    if (frame < DEVICES * 64) {
+      memset(rows, 0, sizeof(rows));
+      rows[frame / 64][frame / 8 % 8] = 1 << (frame % 8);
+    } else {
+      for (uint8_t device = 0; device < DEVICES; device++) {
+        for (uint8_t row = 0; row < 8; row++) rows[device][row] = rng();
+      }
+    }
+    simMatrix.reset(DEVICES, CS);
+    pushDriver<HARDWARE>(rows);
+    bool ok = chainShows(wiring, rows);
+#ifdef MD_MAX72XX_REAL
+    ok &= libraryAgrees<HARDWARE>(rows);
+#endif
+    failures += !ok;
+    frames++;
+  }
+  printf("%-13s %d frames, %d wrong\n", name, frames, failures);
+  CHECK_EQ(failures, 0);
+}
+
+int main() {
+  simReset();
+  pinMode(CS, OUTPUT);
+  testWiring<MD_MAX72XX::FC16_HW>("FC16_HW", SIM_FC16);
+  testWiring<MD_MAX72XX::PAROLA_HW>("PAROLA_HW", SIM_PAROLA);
+  testWiring<MD_MAX72XX::GENERIC_HW>("GENERIC_HW", SIM_GENERIC);
+  testWiring<MD_MAX72XX::ICSTATION_HW>("ICSTATION_HW", SIM_ICSTATION);
+#ifdef MD_MAX72XX_REAL
+  printf("checked against MD_MAX72XX setRow() and update()\n");
+#endif
+  return checkResult();
+}
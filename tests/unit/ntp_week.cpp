@@ -0,0 +1,84 @@
+// A week of NtpClock against the loopback SNTP server: a crystal 40 ppm
+// slow, jittery and lossy paths, and a DNS name that only resolves after the
+// first minute. Reports packets sent and the clock's offset from true time.
+#include <WiFiUdp.h>
+#include <math.h>
+#include <random>
+#include "ntpclock.h"
+#include "sim.h"
+#include "check.h"
+
+static const uint64_t EPOCH = 1767225600ULL * 1000000;  // 2026-01-01 00:00 UTC
+static const IPAddress NTP_IP(10, 0, 1, 1);
+static const uint64_t HOUR = 3600000000ULL;
+static const uint64_t WEEK = 7 * 24 * HOUR;
+static const uint64_t SAMPLE = 60000000;  // Offset sampled every minute
+
+int main() {
+  simReset();
+  simSelectNode(simAddNode(-40, 0));
+  simAddNtpServer(NTP_IP, EPOCH, 50);
+  simSetDnsDelay(30000);
+  // One way: 2 ms plus an exponential tail averaging 5 ms, 2% lost
+  std::mt19937 rng(1);
+  std::exponential_distribution<double> tail(1.0 / 5000);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  simSetNetworkDelay([&] { return uniform(rng) < 0.02 ? SIM_DROP : (uint64_t)(2000 + tail(rng)); });
+
+  WiFiUDP udp;
+  NtpClock clock(udp, NTP_SERVER);
+  clock.begin();
+
+  double maxError = 0, sumSquares = 0;
+  long samples = 0;
+  uint64_t nextSample = SAMPLE;
+  unsigned long requestsAfterDay = 0;
+  bool blocked = false;
+  while (simTime() < WEEK) {
+    if (simTime() >= 60000000) simAddHost(NTP_SERVER, NTP_IP);
+    long wait = (long)(clock.getNextDeadline() - millis());
+    if (wait <= 0) {
+      uint64_t before = simTime();
+      clock.poll();
+      // poll() must never hold up the loop, DNS included
+      blocked |= simTime() != before;
+      delay(1);  // The rest of loop()
+      continue;
+    }
+    uint64_t until = simTime() + (uint64_t)wait * 1000;
+    if (until > nextSample) until = nextSample;
+    simAdvance(until - simTime());
+    if (simTime() >= nextSample) {
+      nextSample += SAMPLE;
+      if (simTime() == 24 * HOUR) requestsAfterDay = simNtpRequests();
+      // Judged once the first hour has settled the drift estimate
+      if (simTime() < HOUR) continue;
+      double error = (double)clock.nowMicros() - (double)(EPOCH + simTime());
+      maxError = fmax(maxError, fabs(error));
+      sumSquares += error * error;
+      samples++;
+    }
+  }
+
+  printf("requests %lu (%lu after the first day), replies %lu, timeouts %lu, steps %lu, DNS queries %lu\n",
+         clock.getRequestCount(), clock.getRequestCount() - requestsAfterDay, clock.getReplyCount(),
+         clock.getTimeoutCount(), clock.getStepCount(), simDnsQueries());
+  printf("offset after the first hour: max %.0f us, rms %.0f us; drift %ld ppb, poll interval %lu s\n",
+         maxError, sqrt(sumSquares / samples), clock.getDrift(), clock.getPollInterval() / 1000);
+
+  CHECK(!blocked);
+  CHECK(clock.isSynced());
+  // Failed lookups in the first minute are retried every NTP_RETRY_INTERVAL,
+  // and a timed-out request looks the name up again
+  CHECK(simDnsQueries() >= 60000 / NTP_RETRY_INTERVAL);
+  CHECK(simDnsQueries() <= 60000 / NTP_RETRY_INTERVAL + 2 + clock.getTimeoutCount());
+  // 40 ppm is 40000 ppb, crystal slow
+  CHECK(labs(clock.getDrift() - 40000) < 2000);
+  // Each sync trusts one exchange, so a one-way spike of a few tens of ms
+  // shows up as half of it
+  CHECK(maxError < 50000);
+  CHECK(sumSquares / samples < 10000.0 * 10000.0);
+  // Backed off to NTP_MAX_POLL: about 2 requests an hour, plus retries
+  CHECK(clock.getRequestCount() - requestsAfterDay < 6 * 24 * 3);
+  return checkResult();
+}
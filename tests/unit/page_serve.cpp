@@ -0,0 +1,153 @@
+// Serving the config page: peak heap during the request and the time to
+// its first byte, against the whole sketch's web server. The page is the
+// gzipped asset in flash (webassets.h), so no more of it than a socket
+// write's worth should ever be on the heap. The released firmware built
+// the whole page as one String in generateHTML() before sending any of it.
+#include <ESP8266WebServer.h>
+#include <arpa/inet.h>
+#include <malloc.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <thread>
+#include <vector>
+#include "ntpclock.h"
+#include "webassets.h"
+#include "sim.h"
+#include "check.h"
+
+void setup();
+void loop();
+extern ESP8266WebServer server;
+extern NtpClock ntpClock;
+
+static const uint64_t EPOCH = 1767225600ULL * 1000000;  // 2026-01-01 00:00 UTC
+static const IPAddress NTP_IP(10, 0, 1, 1);
+static const int RUNS = 100;
+
+// Live heap bytes through operator new, and the most there were since the
+// last reset
+static std::atomic<long> heapLive(0), heapPeak(0);
+
+void* operator new(size_t size) {
+  void* p = malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  long live = heapLive += malloc_usable_size(p);
+  if (live > heapPeak) heapPeak = live;
+  return p;
+}
+
+void operator delete(void* p) noexcept {
+  if (p) heapLive -= malloc_usable_size(p);
+  free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  operator delete(p);
+}
+
+struct Serve {
+  double firstByteMicros;  // From the start of handleClient()
+  double handleMicros;     // The whole of handleClient()
+  long peakHeap;           // Above the heap in use before the request
+  size_t wireBytes;
+  int status;
+};
+
+static Serve serve(const char* path, const char* headers) {
+  Serve result = {};
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(server.hostPort());
+  if (connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+    close(fd);
+    return result;
+  }
+  std::string text = std::string("GET ") + path + " HTTP/1.1\r\nHost: clock\r\n" + headers + "Connection: close\r\n\r\n";
+  if (write(fd, text.data(), text.size()) != (ssize_t)text.size()) {
+    close(fd);
+    return result;
+  }
+
+  // The first byte is seen by a reader blocked on the socket. Its wake-up
+  // is included, so this is an upper bound, and can come after the handler
+  // has returned
+  std::chrono::steady_clock::time_point firstByte;
+  std::thread reader([&] {
+    char c;
+    if (recv(fd, &c, 1, MSG_PEEK) == 1) firstByte = std::chrono::steady_clock::now();
+  });
+  long base = heapLive;
+  heapPeak = base;
+  auto start = std::chrono::steady_clock::now();
+  server.handleClient();
+  auto end = std::chrono::steady_clock::now();
+  result.peakHeap = heapPeak - base;
+  reader.join();
+  result.firstByteMicros = std::chrono::duration<double, std::micro>(firstByte - start).count();
+  result.handleMicros = std::chrono::duration<double, std::micro>(end - start).count();
+
+  std::string raw;
+  char buf[4096];
+  ssize_t n;
+  while ((n = read(fd, buf, sizeof(buf))) > 0) raw.append(buf, n);
+  close(fd);
+  sscanf(raw.c_str(), "HTTP/1.1 %d", &result.status);
+  result.wireBytes = raw.size();
+  return result;
+}
+
+// Medians of RUNS requests, after one to warm up
+static Serve measure(const char* path, const char* headers) {
+  serve(path, headers);
+  std::vector<double> firstByte, handle;
+  std::vector<long> peak;
+  Serve result = {};
+  for (int i = 0; i < RUNS; i++) {
+    result = serve(path, headers);
+    firstByte.push_back(result.firstByteMicros);
+    handle.push_back(result.handleMicros);
+    peak.push_back(result.peakHeap);
+  }
+  std::sort(firstByte.begin(), firstByte.end());
+  std::sort(handle.begin(), handle.end());
+  result.firstByteMicros = firstByte[RUNS / 2];
+  result.handleMicros = handle[RUNS / 2];
+  result.peakHeap = *std::max_element(peak.begin(), peak.end());
+  return result;
+}
+
+int main() {
+  simReset();
+  simAddHost(NTP_SERVER, NTP_IP);
+  simAddNtpServer(NTP_IP, EPOCH, 50);
+  simSetNetworkDelay([] { return (uint64_t)2000; });
+  setup();
+  while ((server.hostPort() == 0 || !ntpClock.isSynced()) && simTime() < 30000000) {
+    loop();
+    simAdvance(200);
+  }
+  CHECK(server.hostPort() != 0);
+
+  Serve page = measure("/", "");
+  Serve revalidated = measure("/", (std::string("If-None-Match: ") + INDEX_HTML_ETAG + "\r\n").c_str());
+  printf("/ fresh        %3d %5zu bytes on the wire, first byte %6.1f us, handler %6.1f us, peak heap %5ld bytes\n",
+         page.status, page.wireBytes, page.firstByteMicros, page.handleMicros, page.peakHeap);
+  printf("/ revalidated  %3d %5zu bytes on the wire, first byte %6.1f us, handler %6.1f us, peak heap %5ld bytes\n",
+         revalidated.status, revalidated.wireBytes, revalidated.firstByteMicros, revalidated.handleMicros,
+         revalidated.peakHeap);
+
+  CHECK_EQ(page.status, 200);
+  CHECK(page.wireBytes > INDEX_HTML_GZ_SIZE);
+  CHECK_EQ(revalidated.status, 304);
+  // The heap holds the request and the headers, never the page
+  CHECK(page.peakHeap < (long)INDEX_HTML_GZ_SIZE);
+  CHECK(page.firstByteMicros > 0);
+  return checkResult();
+}
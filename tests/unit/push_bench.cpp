@@ -0,0 +1,68 @@
+// Frame push cost at this build's chain length: host time per push(), bytes
+// on the bus and their SPI time, for the frames the clock actually pushes.
+// Also checks that what the chain latches is the framebuffer.
+#include <MD_MAX72XX.h>
+#include "framebuffer.h"
+#include "max7219.h"
+#include "sim.h"
+#include "check.h"
+
+static const double SPI_HZ = 8e6;  // The ESP8266's default SPI clock
+static const long PUSHES = 20000;
+
+// The chain through FC16 wiring against the framebuffer, pixel by pixel
+static bool chainMatches(FrameBuffer& fb) {
+  for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+    for (uint16_t x = 0; x < MATRIX_COLUMNS; x++) {
+      uint16_t column = MATRIX_COLUMNS - 1 - x;
+      bool lit = fb.deviceRow(column / 8, row) & (1 << (column % 8));
+      if (simMatrix.pixel(SIM_FC16, row, x) != lit) return false;
+    }
+  }
+  return true;
+}
+
+template <class F> static void report(const char* name, FrameBuffer& fb, F frame) {
+  simMatrix.clearCounters();
+  double nanos = nanosPerCall(PUSHES, [&](long i) {
+    frame(i);
+    fb.push();
+  });
+  double bytes = (double)simMatrix.getBytes() / PUSHES;
+  printf("%2u devices  %-12s %8.0f ns/push %7.1f bytes/push %7.1f us SPI\n",
+         MAX_DEVICES, name, nanos, bytes, bytes * 8 / SPI_HZ * 1e6);
+  CHECK(chainMatches(fb));
+}
+
+int main() {
+  simReset();
+  MD_MAX72XX mx(HARDWARE_TYPE, CS_PIN, MAX_DEVICES);
+  mx.begin();
+  FrameBuffer fb;
+  fb.begin(&mx);
+
+  // Nothing changed: the push should not touch the bus
+  fb.clear();
+  fb.drawText("12:34", false);
+  fb.push();
+  report("unchanged", fb, [](long) {});
+  CHECK_EQ(fb.getLastBytes(), 0);
+
+  // The colon blink: one or two digit registers per second
+  report("colon", fb, [&](long i) {
+    fb.clear();
+    fb.drawText("12:34", i % 2);
+  });
+
+  // A scroll step shifts every row of every device
+  fb.startScroll("Tehran 03:30  New York 19:00", SCROLL_LEFT);
+  report("scroll", fb, [&](long) {
+    if (fb.stepScroll()) fb.startScroll("Tehran 03:30  New York 19:00", SCROLL_LEFT);
+  });
+
+  // After invalidate() every register goes out again
+  report("invalidate", fb, [&](long) { fb.invalidate(); });
+  CHECK_EQ(fb.getLastRows(), MATRIX_ROWS);
+
+  return checkResult();
+}
@@ -0,0 +1,136 @@
+// Zone rotation at catalog sizes of 6, 256 and 4096: the ring the firmware
+// steps through (rotationring.h) against the catalog scan it replaced, for
+// the same count-then-step pass loop() makes, plus the cost of a rebuild.
+// The firmware's own catalog is TZ_COUNT zones; the larger sizes show the
+// step stays a lookup as the catalog grows.
+#include <vector>
+#include "rotationring.h"
+#include "timezone.h"
+#include "check.h"
+
+// The rotation before the ring: every count and step scans the catalog
+template <int N>
+struct CatalogScan {
+  char label[N][6];
+  bool enabled[N];
+
+  bool isEnabled(int i) { return enabled[i] && label[i][0] != '\0'; }
+  int count() {
+    int n = 0;
+    for (int i = 0; i < N; i++) n += isEnabled(i);
+    return n;
+  }
+  int next(int start) {
+    if (count() == 0) return start;
+    for (int i = 1; i <= N; i++) {
+      int tz = (start + i) % N;
+      if (isEnabled(tz)) return tz;
+    }
+    return start;
+  }
+};
+
+static volatile int sink;
+
+template <int N>
+static void bench(int enabled) {
+  static CatalogScan<N> scan;
+  static RotationRing<N> ring;
+  for (int i = 0; i < N; i++) {
+    snprintf(scan.label[i], sizeof(scan.label[i]), "Z%d", i % 10000);
+    scan.enabled[i] = false;
+  }
+  ring.clear();
+  for (int k = 0; k < enabled; k++) {
+    int tz = (long)k * N / enabled;
+    scan.enabled[tz] = true;
+    ring.enable(tz);
+  }
+
+  // In catalog order the ring visits what the scan did
+  ring.build((const uint16_t*)NULL);
+  CHECK_EQ(ring.getLength(), scan.count());
+  int fromScan = scan.next(N - 1), fromRing = ring.next(-1);
+  bool same = true;
+  for (int i = 0; i < 2 * enabled; i++) {
+    same &= fromScan == fromRing;
+    fromScan = scan.next(fromScan);
+    fromRing = ring.next(fromRing);
+  }
+  CHECK(same);
+
+  // A reversed order reverses the visits
+  std::vector<uint16_t> order(N);
+  for (int i = 0; i < N; i++) order[i] = N - 1 - i;
+  ring.build(order.data());
+  CHECK_EQ(ring.getLength(), enabled);
+  int last = (long)(enabled - 1) * N / enabled;
+  CHECK_EQ(ring.next(-1), last);
+  CHECK_EQ(ring.next(last), enabled > 1 ? (long)(enabled - 2) * N / enabled : last);
+
+  long steps = 100000000L / N + 100000;
+  int tz = -1;
+  double scanNs = nanosPerCall(steps, [&](long) { if (scan.count() > 1) tz = scan.next(tz < 0 ? 0 : tz); });
+  sink = tz;
+  tz = -1;
+  double ringNs = nanosPerCall(steps * 10, [&](long) { if (ring.getLength() > 1) tz = ring.next(tz); });
+  sink = tz;
+  double rebuildNs = nanosPerCall(1000, [&](long) { ring.build(order.data()); });
+  printf("%5d zones %4d on: scan %9.1f ns/step, ring %5.2f ns/step, rebuild %8.2f us\n",
+         N, enabled, scanNs, ringNs, rebuildNs / 1000);
+
+  // The ring beats the scan wherever there is more than a handful to scan
+  if (N >= 256) CHECK(ringNs * 10 < scanNs);
+}
+
+// Stepping 4096 zones must cost less than scanning 6 did
+template <int N>
+static double ringStep() {
+  static RotationRing<N> ring;
+  for (int k = 0; k < N / 4; k++) ring.enable(k * 4);
+  ring.build((const uint8_t*)NULL);
+  int tz = -1;
+  double ns = nanosPerCall(20000000, [&](long) { if (ring.getLength() > 1) tz = ring.next(tz); });
+  sink = tz;
+  return ns;
+}
+
+static void testTimezoneManager() {
+  // The firmware's manager is the same ring over the zone catalog
+  Settings settings;
+  memset(&settings, 0, sizeof(settings));
+  for (int i = 0; i < TZ_COUNT; i++) settings.order[i] = TZ_COUNT - 1 - i;
+  settings.enabled[1] = settings.enabled[3] = settings.enabled[7] = 1;
+  TimezoneManager tz;
+  tz.setRotation(settings);
+  CHECK_EQ(tz.getEnabledCount(), 3);
+  CHECK_EQ(tz.nextEnabledTZ(-1), 7);
+  CHECK_EQ(tz.nextEnabledTZ(7), 3);
+  CHECK_EQ(tz.nextEnabledTZ(3), 1);
+  CHECK_EQ(tz.nextEnabledTZ(1), 7);
+  CHECK_EQ(tz.nextEnabledTZ(2), 7);  // Off: restarts the rotation
+  CHECK(tz.isEnabled(3) && !tz.isEnabled(2) && !tz.isEnabled(TZ_COUNT));
+}
+
+int main() {
+  testTimezoneManager();
+  bench<6>(2);
+  bench<6>(6);
+  bench<256>(2);
+  bench<256>(64);
+  bench<4096>(2);
+  bench<4096>(1024);
+
+  CatalogScan<6> six;
+  for (int i = 0; i < 6; i++) {
+    snprintf(six.label[i], sizeof(six.label[i]), "Z%d", i);
+    six.enabled[i] = true;
+  }
+  int tz = 0;
+  double scanSix = nanosPerCall(20000000, [&](long) { if (six.count() > 1) tz = six.next(tz); });
+  sink = tz;
+  double ring4096 = ringStep<4096>();
+  printf("ring step at 4096 zones %.2f ns, scan step at 6 zones %.2f ns\n", ring4096, scanSix);
+  CHECK(ring4096 < scanSix);
+  return checkResult();
+}
@@ -0,0 +1,168 @@
+// Scroll engine at this build's chain length: every step of the left, right
+// and up scrolls checked on the chain against the laid-out text, then the
+// cost of a step against a device-by-device shift like the library's, and
+// the cost of rendering a frame of text from the glyph atlas against the
+// library's font
+#include <MD_MAX72XX.h>
+#include "framebuffer.h"
+#include "glyphatlas.h"
+#include "max7219.h"
+#include "sim.h"
+#include "check.h"
+
+static const char* const TEXT = "12:34";  // Fits on 4 devices, so it can be laid out in place
+static const long STEPS = 200000;
+
+static bool chainLit(uint8_t row, int x) {
+  return simMatrix.pixel(SIM_FC16, row, x);
+}
+
+static bool frameLit(FrameBuffer& fb, uint8_t row, int x) {
+  uint16_t column = MATRIX_COLUMNS - 1 - x;
+  return fb.deviceRow(column / 8, row) & (1 << (column % 8));
+}
+
+// Column shift the way MD_MAX72XX's transform does it: every row of every
+// device, carrying a bit into the next device
+struct DeviceScroll {
+  uint8_t rows[MAX_DEVICES][MATRIX_ROWS];
+
+  void shiftLeft(uint8_t incoming) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+      uint8_t carry = (incoming >> row) & 1;
+      for (uint8_t device = 0; device < MAX_DEVICES; device++) {
+        uint8_t bits = rows[device][row];
+        rows[device][row] = (uint8_t)(bits << 1) | carry;
+        carry = bits >> 7;
+      }
+    }
+  }
+};
+
+// A frame of centred text laid out as FrameBuffer::drawText() does, with
+// each glyph fetched by fetch(c, columns)
+template <class F> static void renderText(uint8_t* frame, const char* text, F fetch) {
+  uint8_t glyph[8];
+  int16_t width = 0;
+  for (const char* p = text; *p; p++) {
+    width += fetch(*p, glyph);
+    if (p[1]) width++;
+  }
+  memset(frame, 0, MATRIX_COLUMNS);
+  int16_t x = (MATRIX_COLUMNS - width) / 2;
+  for (const char* p = text; *p; p++) {
+    uint8_t glyphWidth = fetch(*p, glyph);
+    for (uint8_t i = 0; i < glyphWidth; i++, x++) {
+      if (x >= 0 && x < MATRIX_COLUMNS) frame[x] = glyph[i];
+    }
+    x++;
+  }
+}
+
+static void checkHorizontal(FrameBuffer& fb, FrameBuffer& text, uint16_t textWidth, ScrollEffect effect) {
+  uint16_t scrollWidth = textWidth + 1;  // Every glyph is followed by a blank column
+  fb.startScroll(TEXT, effect);
+  bool done = false;
+  int steps = 0;
+  bool matches = true;
+  while (!done) {
+    done = fb.stepScroll();
+    fb.push();
+    steps++;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+      for (int x = 0; x < MATRIX_COLUMNS; x++) {
+        // Which column of the text is at x after this many steps
+        int t = effect == SCROLL_LEFT ? steps - MATRIX_COLUMNS + x : scrollWidth - steps + x;
+        bool expected = t >= 0 && t < textWidth && frameLit(text, row, t);
+        matches &= chainLit(row, x) == expected;
+      }
+    }
+  }
+  CHECK(matches);
+  CHECK_EQ(steps, scrollWidth + MATRIX_COLUMNS);
+}
+
+static void checkUp(FrameBuffer& fb, FrameBuffer& centred) {
+  fb.startScroll(TEXT, SCROLL_UP);
+  for (uint8_t step = 1; step <= 2 * MATRIX_ROWS; step++) {
+    bool done = fb.stepScroll();
+    fb.push();
+    CHECK_EQ(done, step == 2 * MATRIX_ROWS);
+    bool matches = true;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+      // Rises a row a step, in from the bottom and out of the top
+      int source = row + step - MATRIX_ROWS;
+      for (int x = 0; x < MATRIX_COLUMNS; x++) {
+        bool expected = source >= 0 && source < MATRIX_ROWS && frameLit(centred, source, x);
+        matches &= chainLit(row, x) == expected;
+      }
+    }
+    CHECK(matches);
+  }
+}
+
+int main() {
+  simReset();
+  MD_MAX72XX mx(HARDWARE_TYPE, CS_PIN, MAX_DEVICES);
+  mx.begin();
+  FrameBuffer fb;
+  fb.begin(&mx);
+
+  // The text laid out from column 0, and centred
+  FrameBuffer text, centred;
+  text.begin(&mx);
+  centred.begin(&mx);
+  uint16_t textWidth = text.textWidth(TEXT);
+  text.clear();
+  text.drawText(0, textWidth, TEXT, false);
+  centred.drawText(TEXT, false);
+
+  checkHorizontal(fb, text, textWidth, SCROLL_LEFT);
+  checkHorizontal(fb, text, textWidth, SCROLL_RIGHT);
+  checkUp(fb, centred);
+
+  // A step of a long text that keeps the whole chain busy
+  const char* longText = "Tehran 03:30 New York 19:00 Tokyo 09:00";
+  const ScrollEffect EFFECTS[] = { SCROLL_LEFT, SCROLL_RIGHT, SCROLL_UP };
+  const char* const NAMES[] = { "left", "right", "up" };
+  for (uint8_t e = 0; e < 3; e++) {
+    fb.startScroll(longText, EFFECTS[e]);
+    double step = nanosPerCall(STEPS, [&](long) {
+      if (fb.stepScroll()) fb.startScroll(longText, EFFECTS[e]);
+    });
+    double pushed = nanosPerCall(STEPS / 10, [&](long) {
+      if (fb.stepScroll()) fb.startScroll(longText, EFFECTS[e]);
+      fb.push();
+    });
+    printf("%2u devices, %u words a row: %-5s %6.1f ns/step, %7.1f ns/step with push\n",
+           MAX_DEVICES, ROW_WORDS, NAMES[e], step, pushed);
+  }
+
+  static DeviceScroll deviceScroll;
+  double perDevice = nanosPerCall(STEPS, [&](long i) { deviceScroll.shiftLeft((uint8_t)i); });
+  printf("%2u devices, device by device: left  %6.1f ns/step\n", MAX_DEVICES, perDevice);
+  CHECK_EQ(deviceScroll.rows[0][0] & 1, (STEPS - 1) & 1);  // The last column in
+
+  // Rendering the time and a label with its time: glyphs from the atlas,
+  // as FrameBuffer::getGlyph() takes them, against MD_MAX72XX::getChar()
+  // for every character as before the atlas
+  auto atlas = [&](char c, uint8_t* columns) -> uint8_t {
+    uint8_t slot = glyphSlot(c);
+    if (slot == GLYPH_NONE) return mx.getChar((uint8_t)c, 8, columns);
+    memcpy_P(columns, GLYPHS[slot].columns, GLYPH_MAX_WIDTH);
+    return pgm_read_byte(&GLYPHS[slot].width);
+  };
+  auto font = [&](char c, uint8_t* columns) -> uint8_t { return mx.getChar((uint8_t)c, 8, columns); };
+  static uint8_t frame[MATRIX_COLUMNS];
+  volatile uint8_t sink = 0;
+  for (const char* rendered : { TEXT, "IRST 03:30" }) {
+    double fromAtlas = nanosPerCall(STEPS / 10, [&](long) { renderText(frame, rendered, atlas); sink = sink + frame[0]; });
+    double fromFont = nanosPerCall(STEPS / 10, [&](long) { renderText(frame, rendered, font); sink = sink + frame[0]; });
+    double drawn = nanosPerCall(STEPS / 10, [&](long) { fb.drawText(rendered, false); });
+    printf("%2u devices, render \"%s\": atlas %6.1f ns/frame, library font %6.1f ns/frame, drawText() %6.1f ns/frame\n",
+           MAX_DEVICES, rendered, fromAtlas, fromFont, drawn);
+    CHECK(fromAtlas < fromFont);
+  }
+
+  return checkResult();
+}
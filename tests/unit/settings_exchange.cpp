@@ -0,0 +1,105 @@
+// SettingsExchange under real concurrency: a web-handler thread publishes
+// while a display thread acquires. Every snapshot the reader gets must be
+// one whole publish, and versions only move forward. The exchange is
+// single-producer, so there is exactly one writer thread.
+//
+// Two writer patterns: a flood of back-to-back publishes, which gets the
+// reader preempted halfway through a copy even on a single core, and bursts
+// with pauses like page round trips, which gives the reader many versions
+// to pick up. How many acquires the reader gets depends on scheduling, so
+// the checks only count on a few: the writer keeps going until the reader
+// has seen MIN_VERSIONS, within a time limit.
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "settingsexchange.h"
+#include "check.h"
+
+static const long MIN_VERSIONS = 3;
+
+struct StressResult {
+  unsigned long publishes;
+  long acquires;
+  long versions;  // Distinct versions seen
+  long torn;
+  long backwards;
+};
+
+// Every byte of a published snapshot carries its version, so a torn copy
+// mixes two values
+static Settings snapshot(uint32_t version) {
+  Settings settings;
+  memset(&settings, version & 0xFF, sizeof(settings));
+  return settings;
+}
+
+static bool whole(const Settings& settings) {
+  const uint8_t* bytes = (const uint8_t*)&settings;
+  for (size_t i = 1; i < sizeof(settings); i++) {
+    if (bytes[i] != bytes[0]) return false;
+  }
+  return true;
+}
+
+static StressResult stress(bool flood) {
+  SettingsExchange exchange;
+  std::atomic<bool> done(false);
+  std::atomic<long> seen(0);
+
+  std::thread writer([&] {
+    auto start = std::chrono::steady_clock::now();
+    auto end = start + std::chrono::milliseconds(300);
+    auto limit = start + std::chrono::seconds(10);
+    uint32_t version = 0;
+    for (;;) {
+      auto now = std::chrono::steady_clock::now();
+      if (now >= limit || (now >= end && seen >= MIN_VERSIONS)) break;
+      int burst = flood ? 64 : 1 + version % 61;
+      for (int i = 0; i < burst; i++) exchange.publish(snapshot(++version));
+      if (!flood) std::this_thread::sleep_for(std::chrono::microseconds(20));
+    }
+    done = true;
+  });
+
+  StressResult result = {};
+  uint32_t last = 0;
+  Settings settings;
+  while (!done) {
+    if (!exchange.acquire(settings)) continue;
+    result.acquires++;
+    // The bytes must be one publish, of the version acquire() reports
+    uint32_t version = exchange.getAcquired();
+    result.torn += !whole(settings) || (version & 0xFF) != *(const uint8_t*)&settings;
+    result.backwards += version <= last;
+    if (version != last) seen = ++result.versions;
+    last = version;
+  }
+  writer.join();
+
+  // Once the writer stops, the reader catches up with the newest publish
+  if (exchange.getAcquired() != exchange.getVersion()) {
+    CHECK(exchange.acquire(settings));
+    CHECK(whole(settings));
+  }
+  CHECK_EQ(exchange.getAcquired(), exchange.getVersion());
+  CHECK(!exchange.acquire(settings));
+  result.publishes = exchange.getVersion();
+  return result;
+}
+
+int main() {
+  StressResult total = {};
+  for (bool flood : { true, false }) {
+    StressResult result = stress(flood);
+    printf("%-6s %8lu publishes, %6ld acquires of %ld versions, %ld torn, %ld out of order\n",
+           flood ? "flood" : "bursts", result.publishes, result.acquires, result.versions, result.torn,
+           result.backwards);
+    CHECK(result.acquires > 0);
+    CHECK(result.versions >= MIN_VERSIONS);
+    total.torn += result.torn;
+    total.backwards += result.backwards;
+  }
+  CHECK_EQ(total.torn, 0);
+  CHECK_EQ(total.backwards, 0);
+  return checkResult();
+}
@@ -0,0 +1,157 @@
+// SettingsStore on the emulated flash: migration from the released EEPROM
+// image, replay across reboots, failed writes and the EEPROM fallback
+#include <EEPROM.h>
+#include "settingsstore.h"
+#include "sim.h"
+#include "check.h"
+
+static Settings defaults() {
+  Settings settings;
+  memset(&settings, 0, sizeof(settings));
+  settings.intensity = 5;
+  settings.timeDisplayDuration = 10;
+  settings.enabled[2] = settings.enabled[4] = 1;
+  for (int i = 0; i < TZ_COUNT; i++) settings.order[i] = i;
+  return settings;
+}
+
+// The released firmware's EEPROM.put() of its Settings struct
+static void writeReleasedImage(const uint8_t enabled[6], uint8_t intensity, uint8_t use12Hour, uint16_t duration) {
+  uint8_t image[12] = { 0x42 };
+  memcpy(image + 1, enabled, 6);
+  image[7] = intensity;
+  image[8] = use12Hour;
+  image[9] = 0;
+  image[10] = duration & 0xFF;
+  image[11] = duration >> 8;
+  EEPROM.begin(EEPROM_SIZE);
+  for (int i = 0; i < 12; i++) EEPROM.write(i, image[i]);
+  EEPROM.end();
+}
+
+static void testMigratesReleasedImage() {
+  simReset();
+  const uint8_t enabled[6] = { 1, 0, 1, 1, 0, 1 };
+  writeReleasedImage(enabled, 12, 1, 25);
+
+  SettingsStore store;
+  Settings settings = defaults();
+  CHECK(store.begin(settings));
+  for (int i = 0; i < TZ_COUNT; i++) CHECK_EQ(settings.enabled[i], i < 6 ? enabled[i] : 0);
+  CHECK_EQ(settings.intensity, 12);
+  CHECK_EQ(settings.use12Hour, 1);
+  CHECK_EQ(settings.timeDisplayDuration, 25);
+
+  // Migrated once: the next boot replays the store
+  SettingsStore again;
+  Settings replayed = defaults();
+  CHECK(again.begin(replayed));
+  CHECK(memcmp(&replayed, &settings, sizeof(settings)) == 0);
+}
+
+static void testIgnoresOtherImages() {
+  simReset();
+  const uint8_t enabled[6] = { 1, 1, 1, 1, 1, 1 };
+  writeReleasedImage(enabled, 12, 1, 25);
+  EEPROM.begin(EEPROM_SIZE);
+  EEPROM.write(0, 0x43);
+  EEPROM.end();
+
+  SettingsStore store;
+  Settings settings = defaults();
+  CHECK(store.begin(settings));
+  Settings expected = defaults();
+  CHECK(memcmp(&settings, &expected, sizeof(settings)) == 0);
+}
+
+static void testSaveReplays() {
+  simReset();
+  SettingsStore store;
+  Settings settings = defaults();
+  CHECK(store.begin(settings));
+  for (int i = 0; i < 500; i++) {
+    settings.intensity = i % 16;
+    settings.dwell[i % TZ_COUNT] = i % 60;
+    CHECK(store.save(settings));
+    store.process();
+  }
+  SettingsStore again;
+  Settings replayed = defaults();
+  CHECK(again.begin(replayed));
+  CHECK(memcmp(&replayed, &settings, sizeof(settings)) == 0);
+}
+
+static void testFailedSaveIsRetried() {
+  simReset();
+  SettingsStore store;
+  Settings settings = defaults();
+  CHECK(store.begin(settings));
+
+  // Neither the record nor the snapshot gets written
+  simFailFlashWrites(0);
+  settings.intensity = 9;
+  CHECK(!store.save(settings));
+  CHECK_EQ(store.getFailedSaves(), 1);
+
+  // The same settings again must still go out once flash works
+  simFailFlashWrites(-1);
+  CHECK(store.save(settings));
+  SettingsStore again;
+  Settings replayed = defaults();
+  CHECK(again.begin(replayed));
+  CHECK_EQ(replayed.intensity, 9);
+}
+
+static void testEepromFallback() {
+  simReset();
+  simSetFsSize(0);
+  const uint8_t enabled[6] = { 0, 1, 0, 0, 0, 0 };
+  writeReleasedImage(enabled, 3, 0, 15);
+
+  // No FS area: reported, migrated, and saves still persist
+  SettingsStore store;
+  Settings settings = defaults();
+  CHECK(!store.begin(settings));
+  CHECK(store.getMode() == STORE_EEPROM);
+  CHECK_EQ(settings.intensity, 3);
+  CHECK_EQ(settings.timeDisplayDuration, 15);
+  settings.intensity = 11;
+  settings.dwell[7] = 30;
+  CHECK(store.save(settings));
+
+  SettingsStore again;
+  Settings replayed = defaults();
+  CHECK(!again.begin(replayed));
+  CHECK(memcmp(&replayed, &settings, sizeof(settings)) == 0);
+
+  // The released image stays where it was
+  EEPROM.begin(EEPROM_SIZE);
+  CHECK_EQ(EEPROM.read(0), 0x42);
+  CHECK_EQ(EEPROM.read(7), 3);
+  EEPROM.end();
+
+  // A failed commit leaves the saved settings in place, and is retried
+  simFailFlashWrites(0);
+  settings.intensity = 2;
+  CHECK(!again.save(settings));
+  CHECK_EQ(again.getFailedSaves(), 1);
+  simFailFlashWrites(-1);
+  CHECK(again.save(settings));
+
+  // Reflashed with an FS area: the journal starts from the fallback
+  simSetFsSize(0x1FA000);
+  SettingsStore journal;
+  Settings moved = defaults();
+  CHECK(journal.begin(moved));
+  CHECK(journal.getMode() == STORE_FLASH);
+  CHECK(memcmp(&moved, &settings, sizeof(settings)) == 0);
+}
+
+int main() {
+  testMigratesReleasedImage();
+  testIgnoresOtherImages();
+  testSaveReplays();
+  testFailedSaveIsRetried();
+  testEepromFallback();
+  return checkResult();
+}
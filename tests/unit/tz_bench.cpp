@@ -0,0 +1,79 @@
+// Offset lookups per second: TimezoneManager::getOffsetAt() against the
+// lookup it replaced, which ran gmtime() and the US DST rules on every call.
+// Both are asked what the display asks, the enabled zones in turn at
+// instants a second apart. Then the two paths of getOffsetAt() on their
+// own: a hit in the cached transition interval, and a miss that binary
+// searches the zone's transitions in flash.
+#include <time.h>
+#include "timezone.h"
+#include "check.h"
+
+static const time_t START = 1767225600;  // 2026-01-01 00:00 UTC
+static const long LOOKUPS = 2000000;
+
+// The released firmware's zone table and getCurrentOffset()
+static const struct {
+  long standardOffset;
+  bool usesDST;
+} RELEASED[] = { { 0, false }, { -21600, true }, { -18000, true }, { -28800, true }, { 12600, false } };
+
+static bool releasedDSTActive(time_t now) {
+  if (now == 0) return false;
+  struct tm* timeinfo = gmtime(&now);
+  int month = timeinfo->tm_mon + 1;
+  int day = timeinfo->tm_mday;
+  int wday = timeinfo->tm_wday;
+  if (month > 3 && month < 11) {
+    return true;
+  } else if (month == 3) {
+    int march1Wday = (wday - ((day - 1) % 7) + 7) % 7;
+    int firstSunday = march1Wday == 0 ? 1 : (8 - march1Wday);
+    return day >= firstSunday + 7;
+  } else if (month == 11) {
+    int nov1Wday = (wday - ((day - 1) % 7) + 7) % 7;
+    int firstSunday = nov1Wday == 0 ? 1 : (8 - nov1Wday);
+    return day < firstSunday;
+  }
+  return false;
+}
+
+static long releasedOffset(int tzIndex, time_t now) {
+  long offset = RELEASED[tzIndex].standardOffset;
+  if (RELEASED[tzIndex].usesDST && releasedDSTActive(now)) offset += 3600;
+  return offset;
+}
+
+static volatile long sink;
+
+int main() {
+  TimezoneManager tz;
+  tz.init();
+
+  // The default rotation, EST and IRST. Both paths agree at noon UTC; the
+  // released rules switched at midnight UTC rather than 2:00 local.
+  const int ZONES[] = { 2, 4 };
+  for (long i = 0; i < 400; i++) {
+    time_t t = START + 43200 + i * 86400;
+    for (int zone : ZONES) CHECK_EQ(tz.getOffsetAt(zone, t), releasedOffset(zone, t));
+  }
+
+  long sum = 0;
+  double cached = nanosPerCall(LOOKUPS, [&](long i) { sum += tz.getOffsetAt(ZONES[i & 1], START + i / 2); });
+  double released = nanosPerCall(LOOKUPS, [&](long i) { sum += releasedOffset(ZONES[i & 1], START + i / 2); });
+  sink = sum;
+  printf("getOffsetAt %.1f ns (%.1fM lookups/s), gmtime + US rules %.1f ns (%.1fM lookups/s), %.1fx\n",
+         cached, 1e3 / cached, released, 1e3 / released, released / cached);
+  CHECK(cached * 2 < released);
+
+  // EST has a transition twice a year to 2100; every other lookup jumps
+  // 50 years, so each one leaves the cached interval
+  const int EST = 2;
+  const time_t FAR = 50L * 365 * 86400;
+  sum = 0;
+  double hit = nanosPerCall(LOOKUPS, [&](long i) { sum += tz.getOffsetAt(EST, START + (i & 1)); });
+  double miss = nanosPerCall(LOOKUPS, [&](long i) { sum += tz.getOffsetAt(EST, START + (i & 1) * FAR); });
+  sink = sum;
+  printf("cached transition hit %.1f ns, binary search miss %.1f ns\n", hit, miss);
+  CHECK(hit < miss);
+  return checkResult();
+}
@@ -0,0 +1,74 @@
+// TimezoneManager::getOffsetAt() against glibc's localtime_r() over the
+// range tools/gen_tzdb.py generates, 1970 to 2100: at every transition
+// glibc knows of, a second either side of it, and at random instants in
+// both directions so the offset cache is hit and missed
+#include <stdlib.h>
+#include <random>
+#include "timezone.h"
+#include "check.h"
+
+// IANA names of the catalog in tools/gen_tzdb.py, in the same order
+static const struct {
+  const char* label;
+  const char* name;
+} ZONES[] = {
+  { "UTC", "Etc/UTC" }, { "CST", "America/Chicago" }, { "EST", "America/New_York" },
+  { "PST", "America/Los_Angeles" }, { "IRST", "Asia/Tehran" }, { "UK", "Europe/London" },
+  { "CET", "Europe/Berlin" }, { "EET", "Europe/Athens" }, { "MSK", "Europe/Moscow" },
+  { "GST", "Asia/Dubai" }, { "IST", "Asia/Kolkata" }, { "JST", "Asia/Tokyo" },
+  { "AWST", "Australia/Perth" }, { "ACST", "Australia/Adelaide" }, { "AEST", "Australia/Sydney" },
+  { "NZST", "Pacific/Auckland" }, { "BRT", "America/Sao_Paulo" }, { "ART", "America/Argentina/Buenos_Aires" },
+};
+static_assert(sizeof(ZONES) / sizeof(ZONES[0]) == TZ_COUNT, "ZONES must list the whole catalog");
+
+static const time_t RANGE_END = 4133980800LL;  // 2101-01-01 00:00 UTC
+static const time_t DAY = 86400;
+
+static long glibcOffset(time_t t) {
+  struct tm local;
+  localtime_r(&t, &local);
+  return local.tm_gmtoff;
+}
+
+int main() {
+  TimezoneManager tz;
+  tz.init();
+  std::mt19937_64 random(1);
+  long transitions = 0;
+
+  for (int zone = 0; zone < TZ_COUNT; zone++) {
+    CHECK(strcmp(tz.getTimezoneName(zone), ZONES[zone].label) == 0);
+    setenv("TZ", ZONES[zone].name, 1);
+    tzset();
+    int failures = checkFailures;
+
+    // Walk forward a day at a time and bisect every change of offset
+    long previous = glibcOffset(0);
+    CHECK_EQ(tz.getOffsetAt(zone, 0), previous);
+    for (time_t day = DAY; day < RANGE_END && checkFailures - failures < 5; day += DAY) {
+      long offset = glibcOffset(day);
+      if (offset == previous) continue;
+      time_t before = day - DAY, after = day;
+      while (after - before > 1) {
+        time_t middle = before + (after - before) / 2;
+        if (glibcOffset(middle) == previous) before = middle; else after = middle;
+      }
+      CHECK_EQ(tz.getOffsetAt(zone, after - 1), previous);
+      CHECK_EQ(tz.getOffsetAt(zone, after), offset);
+      CHECK_EQ(tz.getOffsetAt(zone, after + 1), offset);
+      previous = offset;
+      transitions++;
+    }
+
+    // Random jumps, backwards as often as forwards
+    for (int i = 0; i < 20000 && checkFailures - failures < 5; i++) {
+      time_t t = random() % RANGE_END;
+      CHECK_EQ(tz.getOffsetAt(zone, t), glibcOffset(t));
+    }
+    if (checkFailures != failures) fprintf(stderr, "zone %s differs from glibc\n", ZONES[zone].name);
+  }
+
+  printf("%ld transitions checked in %d zones\n", transitions, TZ_COUNT);
+  CHECK(transitions > 1000);
+  return checkResult();
+}
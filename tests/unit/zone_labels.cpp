@@ -0,0 +1,68 @@
+// Side-by-side layout: regions too narrow for "label time" show the label
+// for WAIT_DURATION and the time for the rest of each period, whatever the
+// time display duration
+#include <MD_MAX72XX.h>
+#include "display.h"
+#include "sim.h"
+#include "check.h"
+
+static const char* const LABELS[] = { "EST", "IRST" };
+static const char* const TIMES[] = { "19:00", "03:30" };
+
+// The frame renderZones() draws when every region shows its label
+static bool showsLabels(DisplayManager& display) {
+  static MD_MAX72XX mx(HARDWARE_TYPE, CS_PIN, MAX_DEVICES);  // Glyphs only, never pushed
+  FrameBuffer labels;
+  labels.begin(&mx);
+  labels.clear();
+  for (uint8_t i = 0; i < 2; i++) {
+    int16_t left = (uint32_t)MATRIX_COLUMNS * i / 2;
+    uint16_t width = (uint32_t)MATRIX_COLUMNS * (i + 1) / 2 - left;
+    labels.drawText(left, width, LABELS[i], false);
+  }
+  FrameBuffer& frame = display.getFrameBuffer();
+  for (uint8_t device = 0; device < MAX_DEVICES; device++) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+      if (frame.deviceRow(device, row) != labels.deviceRow(device, row)) return false;
+    }
+  }
+  return true;
+}
+
+static void checkDuration(unsigned long duration) {
+  simReset();
+  DisplayManager display;
+  display.begin(5);
+  display.setTimeDisplayDuration(duration);
+  display.clearZones();
+  for (uint8_t i = 0; i < 2; i++) display.addZone(LABELS[i], TIMES[i]);
+  display.setState(SHOW_ZONES);
+
+  unsigned long period = duration > 2 * WAIT_DURATION ? duration : 2 * WAIT_DURATION;
+  unsigned long labelMillis = 0, timeMillis = 0;
+  unsigned long longestTime = 0, timeRun = 0;
+  const unsigned long STEP = 10;
+  for (unsigned long t = 0; t < 3 * period; t += STEP) {
+    display.renderZones();
+    if (showsLabels(display)) {
+      labelMillis += STEP;
+      timeRun = 0;
+    } else {
+      timeMillis += STEP;
+      timeRun += STEP;
+      if (timeRun > longestTime) longestTime = timeRun;
+    }
+    simAdvance(STEP * 1000);
+  }
+  CHECK_EQ(labelMillis, 3 * WAIT_DURATION);
+  CHECK_EQ(timeMillis, 3 * (period - WAIT_DURATION));
+  CHECK(longestTime >= WAIT_DURATION);
+}
+
+int main() {
+  // 0 and anything up to 2 * WAIT_DURATION used to show only labels, or
+  // divide by zero
+  const unsigned long DURATIONS[] = { 0, 1000, WAIT_DURATION, 2 * WAIT_DURATION, 2 * WAIT_DURATION + 10, 10000, 60000 };
+  for (unsigned long duration : DURATIONS) checkDuration(duration);
+  return checkResult();
+}
@@ -0,0 +1,62 @@
+#include "timeformat.h"
+#include "calendar.h"
+
+static char* putTwoDigits(char* p, uint8_t value) {
+  *p++ = '0' + value / 10;
+  *p++ = '0' + value % 10;
+  return p;
+}
+
+size_t formatTime(char* buf, size_t size, time_t utc, long offset, uint8_t flags) {
+  size_t needed = 5;                                 // HH:MM
+  if (flags & TIME_FORMAT_SECONDS) needed += 3;      // :SS
+  if (flags & TIME_FORMAT_12H) needed += 3;          // " AM"
+  if (flags & TIME_FORMAT_DATE) needed += 11;        // "YYYY-MM-DD "
+  if (buf == nullptr || size == 0) return 0;
+  if (size <= needed) {
+    buf[0] = '\0';
+    return 0;
+  }
+  
+  int64_t local = (int64_t)utc + offset;
+  int32_t days = floorDiv(local, 86400);
+  uint32_t secondOfDay = (uint32_t)(local - (int64_t)days * 86400);
+  uint8_t hour = secondOfDay / 3600;
+  uint8_t minute = (secondOfDay / 60) % 60;
+  uint8_t second = secondOfDay % 60;
+  
+  char* p = buf;
+  if (flags & TIME_FORMAT_DATE) {
+    int32_t year;
+    uint8_t month, day;
+    civilFromDays(days, year, month, day);
+    if (year < 0 || year > 9999) year = 0;
+    p = putTwoDigits(p, year / 100);
+    p = putTwoDigits(p, year % 100);
+    *p++ = '-';
+    p = putTwoDigits(p, month);
+    *p++ = '-';
+    p = putTwoDigits(p, day);
+    *p++ = ' ';
+  }
+  
+  bool isPM = hour >= 12;
+  if (flags & TIME_FORMAT_12H) {
+    hour %= 12;
+    if (hour == 0) hour = 12;
+  }
+  p = putTwoDigits(p, hour);
+  *p++ = ':';
+  p = putTwoDigits(p, minute);
+  if (flags & TIME_FORMAT_SECONDS) {
+    *p++ = ':';
+    p = putTwoDigits(p, second);
+  }
+  if (flags & TIME_FORMAT_12H) {
+    *p++ = ' ';
+    *p++ = isPM ? 'P' : 'A';
+    *p++ = 'M';
+  }
+  *p = '\0';
+  return p - buf;
+}
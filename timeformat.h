@@ -0,0 +1,20 @@
+#ifndef TIMEFORMAT_H
+#define TIMEFORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+// Flags for formatTime()
+const uint8_t TIME_FORMAT_12H = 0x01;     // 12-hour clock with " AM"/" PM" suffix
+const uint8_t TIME_FORMAT_SECONDS = 0x02; // Append ":SS"
+const uint8_t TIME_FORMAT_DATE = 0x04;    // Prefix "YYYY-MM-DD "
+
+// Longest output is "YYYY-MM-DD HH:MM:SS PM" plus the terminating NUL
+const size_t TIME_FORMAT_MAX = 23;
+
+// Formats utc + offset (seconds) into buf without touching the heap.
+// Returns the string length, or 0 (and an empty string) if buf is too small.
+size_t formatTime(char* buf, size_t size, time_t utc, long offset, uint8_t flags);
+
+#endif
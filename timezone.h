@@ -2,30 +2,40 @@
 #define TIMEZONE_H
 
 #include "config.h"
+#include "tzdb.h"
+#include "rotationring.h"
 #include <Arduino.h>
-
-struct TimezoneInfo {
-  const char* name;
-  long standardOffset;  // Offset in seconds (without DST)
-  bool usesDST;         // Whether this timezone uses daylight saving
-};
+#include <time.h>
 
 class TimezoneManager {
 public:
   TimezoneManager();
   
   void init();
-  long getCurrentOffset(int tzIndex);
-  const char* getTimezoneName(int index);
-  bool isDST(int tzIndex);
-  int getEnabledCount();
+  long getOffsetAt(int tzIndex, time_t utc);
+  const char* getTimezoneName(int index);  // Valid until the next call
+  bool isEnabled(int index);
+  int getEnabledCount() { return rotation.getLength(); }
   int nextEnabledTZ(int start);
+  uint8_t getDwell(int index);
   
-  bool tzEnabled[TZ_COUNT];
+  // Takes the enabled zones, rotation order and dwell times from settings.
+  // The rotation ring is rebuilt here, so the display path never scans the
+  // zone table.
+  void setRotation(const Settings& settings);
   
 private:
-  bool isDSTActive(); // Check if DST is currently active (US rules)
-  TimezoneInfo timezones[TZ_COUNT];
+  void refreshOffset(int tzIndex, time_t utc);
+  
+  RotationRing<TZ_COUNT> rotation;  // Enabled zones, in display order
+  uint8_t dwell[TZ_COUNT];
+  
+  char label[TZDB_LABEL_SIZE];  // Last label read from flash
+  
+  // Per-zone offset cache, valid for UTC instants in [validFrom, validUntil)
+  long cachedOffset[TZ_COUNT];
+  time_t validFrom[TZ_COUNT];
+  time_t validUntil[TZ_COUNT];
 };
 
 #endif
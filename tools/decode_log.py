@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+"""Decode a /log dump from the clock into text lines.
+
+The clock keeps debug messages as binary records (see debuglog.h): a
+message ID, four 32-bit arguments and the millis() timestamp. The format
+strings are read from the LOG_MESSAGES list in debuglog.h, so this tool
+must come from the same source tree as the firmware that made the dump.
+
+Usage: curl -s http://<clock-ip>/log | python3 tools/decode_log.py
+       python3 tools/decode_log.py log.bin
+"""
+
+import os
+import re
+import struct
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+HEADER = struct.Struct("<4sI")
+RECORD = struct.Struct("<IB3x4I")
+CONVERSION = re.compile(r"%[-+ #0]*\d*(?:\.\d+)?(?:hh|h|ll|l|z)?([diouxXcs%])")
+
+
+def load_formats():
+    with open(os.path.join(ROOT, "debuglog.h")) as f:
+        source = f.read()
+    return [fmt.encode().decode("unicode_escape")
+            for fmt in re.findall(r'X\(\s*LOG_\w+\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)', source)]
+
+
+def render(fmt, args):
+    values = []
+    for match in CONVERSION.finditer(fmt):
+        kind = match.group(1)
+        if kind == "%":
+            continue
+        value = args[len(values)] if len(values) < len(args) else 0
+        if kind in "di" and value >= 1 << 31:
+            value -= 1 << 32
+        values.append(value)
+    return fmt % tuple(values)
+
+
+def main():
+    data = open(sys.argv[1], "rb").read() if len(sys.argv) > 1 else sys.stdin.buffer.read()
+    if len(data) < HEADER.size:
+        sys.exit("empty dump")
+    magic, seq = HEADER.unpack_from(data)
+    if magic != b"MZLG":
+        sys.exit("not a /log dump")
+    formats = load_formats()
+    for offset in range(HEADER.size, len(data) - RECORD.size + 1, RECORD.size):
+        millis, message, *args = RECORD.unpack_from(data, offset)
+        if message < len(formats):
+            text = render(formats[message], args)
+        else:
+            text = f"unknown message {message} {args}"
+        print(f"{seq:6d} [{millis}] {text}")
+        seq += 1
+
+
+if __name__ == "__main__":
+    main()
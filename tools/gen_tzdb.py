@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+"""Compile a subset of the IANA tz database into tzdb.h / tzdb.cpp.
+
+Each zone becomes a sorted list of UTC transition instants (uint32 seconds)
+with the UTC offset that applies from that instant on, stored in quarter
+hours. The tables live in PROGMEM; TimezoneManager binary searches them.
+
+Usage: python3 tools/gen_tzdb.py [--from 1970] [--to 2100] [--out .]
+Requires Python 3.9+ (zoneinfo) and the system tz database.
+"""
+
+import argparse
+import os
+from datetime import datetime, timezone
+from zoneinfo import ZoneInfo
+
+# (display label, IANA zone). Indexes are what Settings.enabled refers to,
+# so append new zones at the end to keep stored settings meaningful.
+ZONES = [
+    ("UTC", "Etc/UTC"),
+    ("CST", "America/Chicago"),
+    ("EST", "America/New_York"),
+    ("PST", "America/Los_Angeles"),
+    ("IRST", "Asia/Tehran"),
+    ("UK", "Europe/London"),
+    ("CET", "Europe/Berlin"),
+    ("EET", "Europe/Athens"),
+    ("MSK", "Europe/Moscow"),
+    ("GST", "Asia/Dubai"),
+    ("IST", "Asia/Kolkata"),
+    ("JST", "Asia/Tokyo"),
+    ("AWST", "Australia/Perth"),
+    ("ACST", "Australia/Adelaide"),
+    ("AEST", "Australia/Sydney"),
+    ("NZST", "Pacific/Auckland"),
+    ("BRT", "America/Sao_Paulo"),
+    ("ART", "America/Argentina/Buenos_Aires"),
+]
+
+LABEL_SIZE = 6      # including the terminating NUL
+SCAN_STEP = 6 * 3600
+ZONE_STRUCT_SIZE = LABEL_SIZE + 2 + 2 + 1 + 1  # see TzdbZone in tzdb.h
+TRANSITION_SIZE = 4 + 1
+RAM_PER_ZONE = 4 + 8 + 8 + 1 + 2 + 2  # offset cache, dwell, rotation ring and slot
+
+
+def offset_at(zone, t):
+    return int(datetime.fromtimestamp(t, zone).utcoffset().total_seconds())
+
+
+def transitions(name, start, end):
+    zone = ZoneInfo(name)
+    initial = offset_at(zone, start)
+    result = []
+    t = start
+    current = initial
+    while t < end:
+        nxt = min(t + SCAN_STEP, end)
+        off = offset_at(zone, nxt)
+        if off != current:
+            lo, hi = t, nxt  # offset(lo) == current, offset(hi) != current
+            while hi - lo > 1:
+                mid = (lo + hi) // 2
+                if offset_at(zone, mid) == current:
+                    lo = mid
+                else:
+                    hi = mid
+            result.append((hi, offset_at(zone, hi)))
+            current = offset_at(zone, hi)
+            t = hi
+            continue
+        t = nxt
+    return initial, result
+
+
+def quarter_hours(offset, name):
+    if offset % 900:
+        raise SystemExit(f"{name}: offset {offset}s is not a multiple of 15 minutes")
+    return offset // 900
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--from", dest="first", type=int, default=1970)
+    parser.add_argument("--to", dest="last", type=int, default=2100)
+    parser.add_argument("--out", default=os.path.join(os.path.dirname(__file__), ".."))
+    args = parser.parse_args()
+
+    start = int(datetime(args.first, 1, 1, tzinfo=timezone.utc).timestamp())
+    end = int(datetime(args.last + 1, 1, 1, tzinfo=timezone.utc).timestamp())
+    if start < 0 or end > 0xFFFFFFFF:
+        raise SystemExit("year range must stay within 1970..2105")
+
+    zones, times, offsets = [], [], []
+    for label, name in ZONES:
+        if len(label) >= LABEL_SIZE:
+            raise SystemExit(f"label {label!r} is too long")
+        initial, trans = transitions(name, start, end)
+        zones.append((label, name, len(times), len(trans), quarter_hours(initial, name)))
+        for t, off in trans:
+            times.append(t)
+            offsets.append(quarter_hours(off, name))
+    if len(times) > 0xFFFF:
+        raise SystemExit("too many transitions for 16-bit indexes")
+
+    header = f"""#ifndef TZDB_H
+#define TZDB_H
+
+// Generated by tools/gen_tzdb.py ({args.first}-{args.last}) - do not edit.
+
+#include <Arduino.h>
+
+const int TZDB_LABEL_SIZE = {LABEL_SIZE};
+const int TZDB_ZONE_COUNT = {len(zones)};
+
+struct TzdbZone {{
+  char label[TZDB_LABEL_SIZE];  // Display name
+  uint16_t firstTransition;     // Index into tzdbTransitionTimes/Offsets
+  uint16_t transitionCount;
+  int8_t initialOffset;         // Quarter hours, before the first transition
+  uint8_t reserved;
+}};
+
+extern const TzdbZone tzdbZones[TZDB_ZONE_COUNT] PROGMEM;
+extern const uint32_t tzdbTransitionTimes[] PROGMEM;  // UTC seconds, sorted per zone
+extern const int8_t tzdbTransitionOffsets[] PROGMEM;  // Quarter hours from that instant on
+
+#endif
+"""
+
+    lines = [
+        '#include "tzdb.h"',
+        "",
+        f"// Generated by tools/gen_tzdb.py ({args.first}-{args.last}) - do not edit.",
+        "",
+        "const TzdbZone tzdbZones[TZDB_ZONE_COUNT] PROGMEM = {",
+    ]
+    for label, name, first, count, initial in zones:
+        lines.append(f'  {{"{label}", {first}, {count}, {initial}, 0}}, // {name}')
+    lines += ["};", ""]
+
+    def table(decl, values, per_line, fmt):
+        out = [decl + " = {"]
+        if not values:
+            values = [0]
+        for i in range(0, len(values), per_line):
+            out.append("  " + ", ".join(fmt(v) for v in values[i:i + per_line]) + ",")
+        out += ["};", ""]
+        return out
+
+    lines += table("const uint32_t tzdbTransitionTimes[] PROGMEM", times, 6, lambda v: f"{v}UL")
+    lines += table("const int8_t tzdbTransitionOffsets[] PROGMEM", offsets, 16, str)
+
+    with open(os.path.join(args.out, "tzdb.h"), "w") as f:
+        f.write(header)
+    with open(os.path.join(args.out, "tzdb.cpp"), "w") as f:
+        f.write("\n".join(lines))
+
+    print(f"{'zone':34} {'trans':>5} {'flash B':>8} {'RAM B':>6}")
+    for label, name, first, count, initial in zones:
+        flash = ZONE_STRUCT_SIZE + count * TRANSITION_SIZE
+        print(f"{label + ' ' + name:34} {count:5} {flash:8} {RAM_PER_ZONE:6}")
+    total_flash = len(zones) * ZONE_STRUCT_SIZE + len(times) * TRANSITION_SIZE
+    print(f"total: {len(zones)} zones, {len(times)} transitions, "
+          f"{total_flash} B flash, {len(zones) * RAM_PER_ZONE} B RAM")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+"""Gzip the files in web/ into webassets.h as PROGMEM byte arrays.
+
+Each asset gets a <NAME>_GZ array, a <NAME>_GZ_SIZE length and a
+<NAME>_ETAG derived from its content, so the web server can answer
+conditional requests with 304 and serve the page with long cache headers.
+
+Usage: python3 tools/gen_web_assets.py
+"""
+
+import gzip
+import hashlib
+import os
+import re
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+ASSETS = ["index.html"]
+
+
+def symbol(name):
+    return re.sub(r"[^A-Za-z0-9]", "_", name).upper()
+
+
+def main():
+    out = [
+        "#ifndef WEBASSETS_H",
+        "#define WEBASSETS_H",
+        "",
+        "// Generated by tools/gen_web_assets.py from web/ - do not edit.",
+        "",
+        "#include <Arduino.h>",
+        "",
+    ]
+    for name in ASSETS:
+        with open(os.path.join(ROOT, "web", name), "rb") as f:
+            raw = f.read()
+        data = gzip.compress(raw, compresslevel=9, mtime=0)
+        sym = symbol(name)
+        etag = hashlib.sha1(raw).hexdigest()[:16]
+        out.append(f"// web/{name}: {len(raw)} bytes, {len(data)} gzipped")
+        out.append(f'#define {sym}_ETAG "\\"{etag}\\""')
+        out.append(f"const size_t {sym}_GZ_SIZE = {len(data)};")
+        out.append(f"static const uint8_t {sym}_GZ[] PROGMEM = {{")
+        for i in range(0, len(data), 16):
+            out.append("  " + ", ".join(f"0x{b:02x}" for b in data[i:i + 16]) + ",")
+        out.append("};")
+        out.append("")
+        print(f"web/{name}: {len(raw)} -> {len(data)} bytes")
+    out.append("#endif")
+    out.append("")
+    with open(os.path.join(ROOT, "webassets.h"), "w") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+"""Drive a clock's web server with HTTP load and report the stutter it causes.
+
+Requests go out open-loop at a fixed rate, in the given mix of routes,
+from a few worker threads. /metrics is scraped before and after the run;
+the difference gives the clock's own view over exactly that run.
+Printed results:
+- client-side latency percentiles per route
+- percentiles of the clock's HTTP handling time
+- percentiles of animation frame lateness (how far past its slot a scroll
+  frame ran)
+- late and dropped frame counts
+
+Frames are only counted while something scrolls, so run this with the
+"Rotate Timezones" layout and at least two zones enabled. Compare a run
+at --rate 0 (idle baseline) against runs under load.
+/save posts the clock's current settings back unchanged. Every save
+still goes through the settings store, so keep its share of the mix
+modest on a real device.
+
+Usage: python3 tools/http_load.py <clock-ip> [--rate 10] [--duration 60]
+                                  [--mix "/=1,/api/state=4,/save=1"]
+"""
+
+import argparse
+import http.client
+import json
+import re
+import threading
+import time
+import urllib.parse
+
+HISTOGRAMS = [
+    ("frame lateness", "clock_animation_frame_lateness_seconds"),
+    ("http handling", "clock_http_handle_duration_seconds"),
+    ("loop iteration", "clock_loop_duration_seconds"),
+]
+COUNTERS = [
+    "clock_animation_frames_total",
+    "clock_animation_late_frames_total",
+    "clock_animation_dropped_frames_total",
+]
+QUANTILES = [0.5, 0.9, 0.99]
+HISTOGRAM_TOP_MS = 131  # Largest finite bucket on the clock (metrics.h)
+SAMPLE = re.compile(r'^(\w+)(?:\{le="([^"]+)"\})? (\S+)$')
+
+
+def request(host, method, path, body=None, headers=None, timeout=10):
+    conn = http.client.HTTPConnection(host, timeout=timeout)
+    try:
+        conn.request(method, path, body=body, headers=headers or {})
+        response = conn.getresponse()
+        data = response.read()
+        return response.status, data
+    finally:
+        conn.close()
+
+
+def scrape(host):
+    status, data = request(host, "GET", "/metrics")
+    if status != 200:
+        raise SystemExit(f"/metrics returned {status}; is METRICS_ENABLED set?")
+    samples = {}
+    for line in data.decode().splitlines():
+        match = SAMPLE.match(line)
+        if match:
+            name, le, value = match.groups()
+            samples[(name, le)] = float(value)
+    return samples
+
+
+def histogram_delta(before, after, name):
+    bounds = sorted(float(le) for (n, le) in after if n == name + "_bucket" and le != "+Inf")
+    cumulative = [after[(name + "_bucket", f"{b:.6f}")] - before.get((name + "_bucket", f"{b:.6f}"), 0)
+                  for b in bounds]
+    total = after.get((name + "_count", None), 0) - before.get((name + "_count", None), 0)
+    return bounds, cumulative, total
+
+
+def histogram_quantile(bounds, cumulative, total, q):
+    # Upper bound of the bucket the quantile falls in, like Prometheus without interpolation
+    if total <= 0:
+        return None
+    rank = q * total
+    for bound, count in zip(bounds, cumulative):
+        if count >= rank:
+            return bound
+    return float("inf")
+
+
+def percentile(values, q):
+    if not values:
+        return None
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(q * len(ordered)))]
+
+
+def ms(seconds):
+    if seconds is None:
+        return "-"
+    if seconds == float("inf"):
+        return f">{HISTOGRAM_TOP_MS:.0f}"
+    return f"{seconds * 1000:.1f}"
+
+
+def settings_form(host):
+    # The page's own form fields, filled with what the clock has now
+    _, data = request(host, "GET", "/api/settings")
+    settings = json.loads(data)
+    _, data = request(host, "GET", "/api/timezones")
+    fields = []
+    # Listed in rotation order; posting them in that order keeps it
+    for tz in json.loads(data)["timezones"]:
+        if tz["enabled"]:
+            fields.append((f"tz{tz['id']}", "on"))
+        fields.append((f"dwell{tz['id']}", tz.get("dwell") or ""))
+    fields += [
+        ("intensity", settings["intensity"]),
+        ("timeDisplayDuration", settings["timeDisplayDuration"]),
+        ("format", "12" if settings["use12Hour"] else "24"),
+        ("layout", settings["layout"]),
+    ]
+    if "fleet" in settings:
+        fields.append(("fleet", settings["fleet"]))
+    if settings["debug"]:
+        fields.append(("debug", "on"))
+    return urllib.parse.urlencode(fields)
+
+
+def parse_mix(text):
+    mix = []
+    for part in text.split(","):
+        path, _, weight = part.partition("=")
+        mix.append((path.strip(), int(weight or 1)))
+    return mix
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("host", help="clock address, e.g. 192.168.1.50")
+    parser.add_argument("--rate", type=float, default=5, help="requests per second (0 for an idle baseline)")
+    parser.add_argument("--duration", type=float, default=60, help="seconds to run")
+    parser.add_argument("--mix", default="/=1,/api/state=4,/save=1", help="route=weight list")
+    parser.add_argument("--workers", type=int, default=4, help="concurrent connections at most")
+    args = parser.parse_args()
+
+    mix = parse_mix(args.mix)
+    schedule = [path for path, weight in mix for _ in range(weight)]
+    save_body = settings_form(args.host) if any(path == "/save" for path, _ in mix) else None
+
+    latencies = {path: [] for path, _ in mix}
+    errors = {path: 0 for path, _ in mix}
+    lock = threading.Lock()
+    slots = threading.Semaphore(args.workers)
+    skipped = 0
+
+    def run(path):
+        try:
+            start = time.perf_counter()
+            if path == "/save":
+                status, _ = request(args.host, "POST", path, save_body,
+                                    {"Content-Type": "application/x-www-form-urlencoded"})
+            else:
+                status, _ = request(args.host, "GET", path)
+            elapsed = time.perf_counter() - start
+            with lock:
+                if status < 400:
+                    latencies[path].append(elapsed)
+                else:
+                    errors[path] += 1
+        except OSError:
+            with lock:
+                errors[path] += 1
+        finally:
+            slots.release()
+
+    before = scrape(args.host)
+    started = time.monotonic()
+    sent = 0
+    threads = []
+    while True:
+        now = time.monotonic() - started
+        if now >= args.duration:
+            break
+        if args.rate <= 0:
+            time.sleep(min(1.0, args.duration - now))
+            continue
+        due = sent / args.rate
+        if due > now:
+            time.sleep(due - now)
+            continue
+        path = schedule[sent % len(schedule)]
+        sent += 1
+        # Open loop: a request that finds every worker busy is counted, not queued
+        if not slots.acquire(blocking=False):
+            skipped += 1
+            continue
+        thread = threading.Thread(target=run, args=(path,), daemon=True)
+        thread.start()
+        threads.append(thread)
+    for thread in threads:
+        thread.join()
+    after = scrape(args.host)
+
+    print(f"{args.rate:g} req/s for {args.duration:g} s, mix {args.mix}, "
+          f"{sent - skipped} sent, {skipped} skipped (all workers busy)")
+    print()
+    print(f"{'route':<16} {'ok':>6} {'err':>5} " + " ".join(f"{'p' + str(int(q * 100)):>8}" for q in QUANTILES) + f" {'max':>8}  (ms, client)")
+    for path, _ in mix:
+        values = latencies[path]
+        cells = " ".join(f"{ms(percentile(values, q)):>8}" for q in QUANTILES)
+        print(f"{path:<16} {len(values):>6} {errors[path]:>5} {cells} {ms(max(values) if values else None):>8}")
+    print()
+    print(f"{'clock':<16} {'count':>12} " + " ".join(f"{'p' + str(int(q * 100)):>8}" for q in QUANTILES) + "  (ms, bucket upper bound)")
+    for label, name in HISTOGRAMS:
+        bounds, cumulative, total = histogram_delta(before, after, name)
+        cells = " ".join(f"{ms(histogram_quantile(bounds, cumulative, total, q)):>8}" for q in QUANTILES)
+        print(f"{label:<16} {int(total):>12} {cells}")
+    print()
+    for name in COUNTERS:
+        print(f"{name:<40} {int(after.get((name, None), 0) - before.get((name, None), 0)):>8}")
+    frames = after.get((COUNTERS[0], None), 0) - before.get((COUNTERS[0], None), 0)
+    if frames == 0:
+        print("\nNo animation frames ran; use the rotate layout with two or more zones enabled.")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,22 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "framebuffer.h"
+
+// Hooks for the host simulator (tests/sim), compiled in with TRACE_ENABLED:
+// traceFrame() after every pushed frame and traceLoopCost() with the time
+// spent in each loop() iteration. The simulator writes them to a trace file
+// for replay and analysis; the firmware has no implementation, so the
+// device build keeps TRACE_ENABLED at 0 and these are no-ops.
+
+#if TRACE_ENABLED
+void traceFrame(FrameBuffer& frame);
+void traceLoopCost(unsigned long busyMicros);
+#else
+inline void traceFrame(FrameBuffer&) {}
+inline void traceLoopCost(unsigned long) {}
+#endif
+
+#endif
@@ -0,0 +1,612 @@
+#include "tzdb.h"
+
+// Generated by tools/gen_tzdb.py (1970-2100) - do not edit.
+
+const TzdbZone tzdbZones[TZDB_ZONE_COUNT] PROGMEM = {
+  {"UTC", 0, 0, 0, 0}, // Etc/UTC
+  {"CST", 0, 262, -24, 0}, // America/Chicago
+  {"EST", 262, 262, -20, 0}, // America/New_York
+  {"PST", 524, 262, -32, 0}, // America/Los_Angeles
+  {"IRST", 786, 69, 14, 0}, // Asia/Tehran
+  {"UK", 855, 259, 4, 0}, // Europe/London
+  {"CET", 1114, 242, 4, 0}, // Europe/Berlin
+  {"EET", 1356, 252, 8, 0}, // Europe/Athens
+  {"MSK", 1608, 62, 12, 0}, // Europe/Moscow
+  {"GST", 1670, 0, 16, 0}, // Asia/Dubai
+  {"IST", 1670, 0, 22, 0}, // Asia/Kolkata
+  {"JST", 1670, 0, 36, 0}, // Asia/Tokyo
+  {"AWST", 1670, 12, 32, 0}, // Australia/Perth
+  {"ACST", 1682, 259, 38, 0}, // Australia/Adelaide
+  {"AEST", 1941, 259, 40, 0}, // Australia/Sydney
+  {"NZST", 2200, 253, 48, 0}, // Pacific/Auckland
+  {"BRT", 2453, 68, -12, 0}, // America/Sao_Paulo
+  {"ART", 2521, 16, -12, 0}, // America/Argentina/Buenos_Aires
+};
+
+const uint32_t tzdbTransitionTimes[] PROGMEM = {
+  9964800UL, 25686000UL, 41414400UL, 57740400UL, 73468800UL, 89190000UL,
+  104918400UL, 120639600UL, 126691200UL, 152089200UL, 162374400UL, 183538800UL,
+  199267200UL, 215593200UL, 230716800UL, 247042800UL, 262771200UL, 278492400UL,
+  294220800UL, 309942000UL, 325670400UL, 341391600UL, 357120000UL, 372841200UL,
+  388569600UL, 404895600UL, 420019200UL, 436345200UL, 452073600UL, 467794800UL,
+  483523200UL, 499244400UL, 514972800UL, 530694000UL, 544608000UL, 562143600UL,
+  576057600UL, 594198000UL, 607507200UL, 625647600UL, 638956800UL, 657097200UL,
+  671011200UL, 688546800UL, 702460800UL, 719996400UL, 733910400UL, 752050800UL,
+  765360000UL, 783500400UL, 796809600UL, 814950000UL, 828864000UL, 846399600UL,
+  860313600UL, 877849200UL, 891763200UL, 909298800UL, 923212800UL, 941353200UL,
+  954662400UL, 972802800UL, 986112000UL, 1004252400UL, 1018166400UL, 1035702000UL,
+  1049616000UL, 1067151600UL, 1081065600UL, 1099206000UL, 1112515200UL, 1130655600UL,
+  1143964800UL, 1162105200UL, 1173600000UL, 1194159600UL, 1205049600UL, 1225609200UL,
+  1236499200UL, 1257058800UL, 1268553600UL, 1289113200UL, 1300003200UL, 1320562800UL,
+  1331452800UL, 1352012400UL, 1362902400UL, 1383462000UL, 1394352000UL, 1414911600UL,
+  1425801600UL, 1446361200UL, 1457856000UL, 1478415600UL, 1489305600UL, 1509865200UL,
+  1520755200UL, 1541314800UL, 1552204800UL, 1572764400UL, 1583654400UL, 1604214000UL,
+  1615708800UL, 1636268400UL, 1647158400UL, 1667718000UL, 1678608000UL, 1699167600UL,
+  1710057600UL, 1730617200UL, 1741507200UL, 1762066800UL, 1772956800UL, 1793516400UL,
+  1805011200UL, 1825570800UL, 1836460800UL, 1857020400UL, 1867910400UL, 1888470000UL,
+  1899360000UL, 1919919600UL, 1930809600UL, 1951369200UL, 1962864000UL, 1983423600UL,
+  1994313600UL, 2014873200UL, 2025763200UL, 2046322800UL, 2057212800UL, 2077772400UL,
+  2088662400UL, 2109222000UL, 2120112000UL, 2140671600UL, 2152166400UL, 2172726000UL,
+  2183616000UL, 2204175600UL, 2215065600UL, 2235625200UL, 2246515200UL, 2267074800UL,
+  2277964800UL, 2298524400UL, 2309414400UL, 2329974000UL, 2341468800UL, 2362028400UL,
+  2372918400UL, 2393478000UL, 2404368000UL, 2424927600UL, 2435817600UL, 2456377200UL,
+  2467267200UL, 2487826800UL, 2499321600UL, 2519881200UL, 2530771200UL, 2551330800UL,
+  2562220800UL, 2582780400UL, 2593670400UL, 2614230000UL, 2625120000UL, 2645679600UL,
+  2656569600UL, 2677129200UL, 2688624000UL, 2709183600UL, 2720073600UL, 2740633200UL,
+  2751523200UL, 2772082800UL, 2782972800UL, 2803532400UL, 2814422400UL, 2834982000UL,
+  2846476800UL, 2867036400UL, 2877926400UL, 2898486000UL, 2909376000UL, 2929935600UL,
+  2940825600UL, 2961385200UL, 2972275200UL, 2992834800UL, 3003724800UL, 3024284400UL,
+  3035779200UL, 3056338800UL, 3067228800UL, 3087788400UL, 3098678400UL, 3119238000UL,
+  3130128000UL, 3150687600UL, 3161577600UL, 3182137200UL, 3193027200UL, 3213586800UL,
+  3225081600UL, 3245641200UL, 3256531200UL, 3277090800UL, 3287980800UL, 3308540400UL,
+  3319430400UL, 3339990000UL, 3350880000UL, 3371439600UL, 3382934400UL, 3403494000UL,
+  3414384000UL, 3434943600UL, 3445833600UL, 3466393200UL, 3477283200UL, 3497842800UL,
+  3508732800UL, 3529292400UL, 3540182400UL, 3560742000UL, 3572236800UL, 3592796400UL,
+  3603686400UL, 3624246000UL, 3635136000UL, 3655695600UL, 3666585600UL, 3687145200UL,
+  3698035200UL, 3718594800UL, 3730089600UL, 3750649200UL, 3761539200UL, 3782098800UL,
+  3792988800UL, 3813548400UL, 3824438400UL, 3844998000UL, 3855888000UL, 3876447600UL,
+  3887337600UL, 3907897200UL, 3919392000UL, 3939951600UL, 3950841600UL, 3971401200UL,
+  3982291200UL, 4002850800UL, 4013740800UL, 4034300400UL, 4045190400UL, 4065750000UL,
+  4076640000UL, 4097199600UL, 4108694400UL, 4129254000UL, 9961200UL, 25682400UL,
+  41410800UL, 57736800UL, 73465200UL, 89186400UL, 104914800UL, 120636000UL,
+  126687600UL, 152085600UL, 162370800UL, 183535200UL, 199263600UL, 215589600UL,
+  230713200UL, 247039200UL, 262767600UL, 278488800UL, 294217200UL, 309938400UL,
+  325666800UL, 341388000UL, 357116400UL, 372837600UL, 388566000UL, 404892000UL,
+  420015600UL, 436341600UL, 452070000UL, 467791200UL, 483519600UL, 499240800UL,
+  514969200UL, 530690400UL, 544604400UL, 562140000UL, 576054000UL, 594194400UL,
+  607503600UL, 625644000UL, 638953200UL, 657093600UL, 671007600UL, 688543200UL,
+  702457200UL, 719992800UL, 733906800UL, 752047200UL, 765356400UL, 783496800UL,
+  796806000UL, 814946400UL, 828860400UL, 846396000UL, 860310000UL, 877845600UL,
+  891759600UL, 909295200UL, 923209200UL, 941349600UL, 954658800UL, 972799200UL,
+  986108400UL, 1004248800UL, 1018162800UL, 1035698400UL, 1049612400UL, 1067148000UL,
+  1081062000UL, 1099202400UL, 1112511600UL, 1130652000UL, 1143961200UL, 1162101600UL,
+  1173596400UL, 1194156000UL, 1205046000UL, 1225605600UL, 1236495600UL, 1257055200UL,
+  1268550000UL, 1289109600UL, 1299999600UL, 1320559200UL, 1331449200UL, 1352008800UL,
+  1362898800UL, 1383458400UL, 1394348400UL, 1414908000UL, 1425798000UL, 1446357600UL,
+  1457852400UL, 1478412000UL, 1489302000UL, 1509861600UL, 1520751600UL, 1541311200UL,
+  1552201200UL, 1572760800UL, 1583650800UL, 1604210400UL, 1615705200UL, 1636264800UL,
+  1647154800UL, 1667714400UL, 1678604400UL, 1699164000UL, 1710054000UL, 1730613600UL,
+  1741503600UL, 1762063200UL, 1772953200UL, 1793512800UL, 1805007600UL, 1825567200UL,
+  1836457200UL, 1857016800UL, 1867906800UL, 1888466400UL, 1899356400UL, 1919916000UL,
+  1930806000UL, 1951365600UL, 1962860400UL, 1983420000UL, 1994310000UL, 2014869600UL,
+  2025759600UL, 2046319200UL, 2057209200UL, 2077768800UL, 2088658800UL, 2109218400UL,
+  2120108400UL, 2140668000UL, 2152162800UL, 2172722400UL, 2183612400UL, 2204172000UL,
+  2215062000UL, 2235621600UL, 2246511600UL, 2267071200UL, 2277961200UL, 2298520800UL,
+  2309410800UL, 2329970400UL, 2341465200UL, 2362024800UL, 2372914800UL, 2393474400UL,
+  2404364400UL, 2424924000UL, 2435814000UL, 2456373600UL, 2467263600UL, 2487823200UL,
+  2499318000UL, 2519877600UL, 2530767600UL, 2551327200UL, 2562217200UL, 2582776800UL,
+  2593666800UL, 2614226400UL, 2625116400UL, 2645676000UL, 2656566000UL, 2677125600UL,
+  2688620400UL, 2709180000UL, 2720070000UL, 2740629600UL, 2751519600UL, 2772079200UL,
+  2782969200UL, 2803528800UL, 2814418800UL, 2834978400UL, 2846473200UL, 2867032800UL,
+  2877922800UL, 2898482400UL, 2909372400UL, 2929932000UL, 2940822000UL, 2961381600UL,
+  2972271600UL, 2992831200UL, 3003721200UL, 3024280800UL, 3035775600UL, 3056335200UL,
+  3067225200UL, 3087784800UL, 3098674800UL, 3119234400UL, 3130124400UL, 3150684000UL,
+  3161574000UL, 3182133600UL, 3193023600UL, 3213583200UL, 3225078000UL, 3245637600UL,
+  3256527600UL, 3277087200UL, 3287977200UL, 3308536800UL, 3319426800UL, 3339986400UL,
+  3350876400UL, 3371436000UL, 3382930800UL, 3403490400UL, 3414380400UL, 3434940000UL,
+  3445830000UL, 3466389600UL, 3477279600UL, 3497839200UL, 3508729200UL, 3529288800UL,
+  3540178800UL, 3560738400UL, 3572233200UL, 3592792800UL, 3603682800UL, 3624242400UL,
+  3635132400UL, 3655692000UL, 3666582000UL, 3687141600UL, 3698031600UL, 3718591200UL,
+  3730086000UL, 3750645600UL, 3761535600UL, 3782095200UL, 3792985200UL, 3813544800UL,
+  3824434800UL, 3844994400UL, 3855884400UL, 3876444000UL, 3887334000UL, 3907893600UL,
+  3919388400UL, 3939948000UL, 3950838000UL, 3971397600UL, 3982287600UL, 4002847200UL,
+  4013737200UL, 4034296800UL, 4045186800UL, 4065746400UL, 4076636400UL, 4097196000UL,
+  4108690800UL, 4129250400UL, 9972000UL, 25693200UL, 41421600UL, 57747600UL,
+  73476000UL, 89197200UL, 104925600UL, 120646800UL, 126698400UL, 152096400UL,
+  162381600UL, 183546000UL, 199274400UL, 215600400UL, 230724000UL, 247050000UL,
+  262778400UL, 278499600UL, 294228000UL, 309949200UL, 325677600UL, 341398800UL,
+  357127200UL, 372848400UL, 388576800UL, 404902800UL, 420026400UL, 436352400UL,
+  452080800UL, 467802000UL, 483530400UL, 499251600UL, 514980000UL, 530701200UL,
+  544615200UL, 562150800UL, 576064800UL, 594205200UL, 607514400UL, 625654800UL,
+  638964000UL, 657104400UL, 671018400UL, 688554000UL, 702468000UL, 720003600UL,
+  733917600UL, 752058000UL, 765367200UL, 783507600UL, 796816800UL, 814957200UL,
+  828871200UL, 846406800UL, 860320800UL, 877856400UL, 891770400UL, 909306000UL,
+  923220000UL, 941360400UL, 954669600UL, 972810000UL, 986119200UL, 1004259600UL,
+  1018173600UL, 1035709200UL, 1049623200UL, 1067158800UL, 1081072800UL, 1099213200UL,
+  1112522400UL, 1130662800UL, 1143972000UL, 1162112400UL, 1173607200UL, 1194166800UL,
+  1205056800UL, 1225616400UL, 1236506400UL, 1257066000UL, 1268560800UL, 1289120400UL,
+  1300010400UL, 1320570000UL, 1331460000UL, 1352019600UL, 1362909600UL, 1383469200UL,
+  1394359200UL, 1414918800UL, 1425808800UL, 1446368400UL, 1457863200UL, 1478422800UL,
+  1489312800UL, 1509872400UL, 1520762400UL, 1541322000UL, 1552212000UL, 1572771600UL,
+  1583661600UL, 1604221200UL, 1615716000UL, 1636275600UL, 1647165600UL, 1667725200UL,
+  1678615200UL, 1699174800UL, 1710064800UL, 1730624400UL, 1741514400UL, 1762074000UL,
+  1772964000UL, 1793523600UL, 1805018400UL, 1825578000UL, 1836468000UL, 1857027600UL,
+  1867917600UL, 1888477200UL, 1899367200UL, 1919926800UL, 1930816800UL, 1951376400UL,
+  1962871200UL, 1983430800UL, 1994320800UL, 2014880400UL, 2025770400UL, 2046330000UL,
+  2057220000UL, 2077779600UL, 2088669600UL, 2109229200UL, 2120119200UL, 2140678800UL,
+  2152173600UL, 2172733200UL, 2183623200UL, 2204182800UL, 2215072800UL, 2235632400UL,
+  2246522400UL, 2267082000UL, 2277972000UL, 2298531600UL, 2309421600UL, 2329981200UL,
+  2341476000UL, 2362035600UL, 2372925600UL, 2393485200UL, 2404375200UL, 2424934800UL,
+  2435824800UL, 2456384400UL, 2467274400UL, 2487834000UL, 2499328800UL, 2519888400UL,
+  2530778400UL, 2551338000UL, 2562228000UL, 2582787600UL, 2593677600UL, 2614237200UL,
+  2625127200UL, 2645686800UL, 2656576800UL, 2677136400UL, 2688631200UL, 2709190800UL,
+  2720080800UL, 2740640400UL, 2751530400UL, 2772090000UL, 2782980000UL, 2803539600UL,
+  2814429600UL, 2834989200UL, 2846484000UL, 2867043600UL, 2877933600UL, 2898493200UL,
+  2909383200UL, 2929942800UL, 2940832800UL, 2961392400UL, 2972282400UL, 2992842000UL,
+  3003732000UL, 3024291600UL, 3035786400UL, 3056346000UL, 3067236000UL, 3087795600UL,
+  3098685600UL, 3119245200UL, 3130135200UL, 3150694800UL, 3161584800UL, 3182144400UL,
+  3193034400UL, 3213594000UL, 3225088800UL, 3245648400UL, 3256538400UL, 3277098000UL,
+  3287988000UL, 3308547600UL, 3319437600UL, 3339997200UL, 3350887200UL, 3371446800UL,
+  3382941600UL, 3403501200UL, 3414391200UL, 3434950800UL, 3445840800UL, 3466400400UL,
+  3477290400UL, 3497850000UL, 3508740000UL, 3529299600UL, 3540189600UL, 3560749200UL,
+  3572244000UL, 3592803600UL, 3603693600UL, 3624253200UL, 3635143200UL, 3655702800UL,
+  3666592800UL, 3687152400UL, 3698042400UL, 3718602000UL, 3730096800UL, 3750656400UL,
+  3761546400UL, 3782106000UL, 3792996000UL, 3813555600UL, 3824445600UL, 3845005200UL,
+  3855895200UL, 3876454800UL, 3887344800UL, 3907904400UL, 3919399200UL, 3939958800UL,
+  3950848800UL, 3971408400UL, 3982298400UL, 4002858000UL, 4013748000UL, 4034307600UL,
+  4045197600UL, 4065757200UL, 4076647200UL, 4097206800UL, 4108701600UL, 4129261200UL,
+  227820600UL, 246223800UL, 259617600UL, 271108800UL, 279576000UL, 296598600UL,
+  306531000UL, 322432200UL, 338499000UL, 673216200UL, 685481400UL, 701209800UL,
+  717103800UL, 732745800UL, 748639800UL, 764281800UL, 780175800UL, 795817800UL,
+  811711800UL, 827353800UL, 843247800UL, 858976200UL, 874870200UL, 890512200UL,
+  906406200UL, 922048200UL, 937942200UL, 953584200UL, 969478200UL, 985206600UL,
+  1001100600UL, 1016742600UL, 1032636600UL, 1048278600UL, 1064172600UL, 1079814600UL,
+  1095708600UL, 1111437000UL, 1127331000UL, 1206045000UL, 1221939000UL, 1237667400UL,
+  1253561400UL, 1269203400UL, 1285097400UL, 1300739400UL, 1316633400UL, 1332275400UL,
+  1348169400UL, 1363897800UL, 1379791800UL, 1395433800UL, 1411327800UL, 1426969800UL,
+  1442863800UL, 1458505800UL, 1474399800UL, 1490128200UL, 1506022200UL, 1521664200UL,
+  1537558200UL, 1553200200UL, 1569094200UL, 1584736200UL, 1600630200UL, 1616358600UL,
+  1632252600UL, 1647894600UL, 1663788600UL, 57722400UL, 69818400UL, 89172000UL,
+  101268000UL, 120621600UL, 132717600UL, 152071200UL, 164167200UL, 183520800UL,
+  196221600UL, 214970400UL, 227671200UL, 246420000UL, 259120800UL, 278474400UL,
+  290570400UL, 309924000UL, 322020000UL, 341373600UL, 354675600UL, 372819600UL,
+  386125200UL, 404269200UL, 417574800UL, 435718800UL, 449024400UL, 467773200UL,
+  481078800UL, 499222800UL, 512528400UL, 530672400UL, 543978000UL, 562122000UL,
+  575427600UL, 593571600UL, 606877200UL, 625626000UL, 638326800UL, 657075600UL,
+  670381200UL, 688525200UL, 701830800UL, 719974800UL, 733280400UL, 751424400UL,
+  764730000UL, 782874000UL, 796179600UL, 814323600UL, 828234000UL, 846378000UL,
+  859683600UL, 877827600UL, 891133200UL, 909277200UL, 922582800UL, 941331600UL,
+  954032400UL, 972781200UL, 985482000UL, 1004230800UL, 1017536400UL, 1035680400UL,
+  1048986000UL, 1067130000UL, 1080435600UL, 1099184400UL, 1111885200UL, 1130634000UL,
+  1143334800UL, 1162083600UL, 1174784400UL, 1193533200UL, 1206838800UL, 1224982800UL,
+  1238288400UL, 1256432400UL, 1269738000UL, 1288486800UL, 1301187600UL, 1319936400UL,
+  1332637200UL, 1351386000UL, 1364691600UL, 1382835600UL, 1396141200UL, 1414285200UL,
+  1427590800UL, 1445734800UL, 1459040400UL, 1477789200UL, 1490490000UL, 1509238800UL,
+  1521939600UL, 1540688400UL, 1553994000UL, 1572138000UL, 1585443600UL, 1603587600UL,
+  1616893200UL, 1635642000UL, 1648342800UL, 1667091600UL, 1679792400UL, 1698541200UL,
+  1711846800UL, 1729990800UL, 1743296400UL, 1761440400UL, 1774746000UL, 1792890000UL,
+  1806195600UL, 1824944400UL, 1837645200UL, 1856394000UL, 1869094800UL, 1887843600UL,
+  1901149200UL, 1919293200UL, 1932598800UL, 1950742800UL, 1964048400UL, 1982797200UL,
+  1995498000UL, 2014246800UL, 2026947600UL, 2045696400UL, 2058397200UL, 2077146000UL,
+  2090451600UL, 2108595600UL, 2121901200UL, 2140045200UL, 2153350800UL, 2172099600UL,
+  2184800400UL, 2203549200UL, 2216250000UL, 2234998800UL, 2248304400UL, 2266448400UL,
+  2279754000UL, 2297898000UL, 2311203600UL, 2329347600UL, 2342653200UL, 2361402000UL,
+  2374102800UL, 2392851600UL, 2405552400UL, 2424301200UL, 2437606800UL, 2455750800UL,
+  2469056400UL, 2487200400UL, 2500506000UL, 2519254800UL, 2531955600UL, 2550704400UL,
+  2563405200UL, 2582154000UL, 2595459600UL, 2613603600UL, 2626909200UL, 2645053200UL,
+  2658358800UL, 2676502800UL, 2689808400UL, 2708557200UL, 2721258000UL, 2740006800UL,
+  2752707600UL, 2771456400UL, 2784762000UL, 2802906000UL, 2816211600UL, 2834355600UL,
+  2847661200UL, 2866410000UL, 2879110800UL, 2897859600UL, 2910560400UL, 2929309200UL,
+  2942010000UL, 2960758800UL, 2974064400UL, 2992208400UL, 3005514000UL, 3023658000UL,
+  3036963600UL, 3055712400UL, 3068413200UL, 3087162000UL, 3099862800UL, 3118611600UL,
+  3131917200UL, 3150061200UL, 3163366800UL, 3181510800UL, 3194816400UL, 3212960400UL,
+  3226266000UL, 3245014800UL, 3257715600UL, 3276464400UL, 3289165200UL, 3307914000UL,
+  3321219600UL, 3339363600UL, 3352669200UL, 3370813200UL, 3384118800UL, 3402867600UL,
+  3415568400UL, 3434317200UL, 3447018000UL, 3465766800UL, 3479072400UL, 3497216400UL,
+  3510522000UL, 3528666000UL, 3541971600UL, 3560115600UL, 3573421200UL, 3592170000UL,
+  3604870800UL, 3623619600UL, 3636320400UL, 3655069200UL, 3668374800UL, 3686518800UL,
+  3699824400UL, 3717968400UL, 3731274000UL, 3750022800UL, 3762723600UL, 3781472400UL,
+  3794173200UL, 3812922000UL, 3825622800UL, 3844371600UL, 3857677200UL, 3875821200UL,
+  3889126800UL, 3907270800UL, 3920576400UL, 3939325200UL, 3952026000UL, 3970774800UL,
+  3983475600UL, 4002224400UL, 4015530000UL, 4033674000UL, 4046979600UL, 4065123600UL,
+  4078429200UL, 4096573200UL, 4109878800UL, 4128627600UL, 323830800UL, 338950800UL,
+  354675600UL, 370400400UL, 386125200UL, 401850000UL, 417574800UL, 433299600UL,
+  449024400UL, 465354000UL, 481078800UL, 496803600UL, 512528400UL, 528253200UL,
+  543978000UL, 559702800UL, 575427600UL, 591152400UL, 606877200UL, 622602000UL,
+  638326800UL, 654656400UL, 670381200UL, 686106000UL, 701830800UL, 717555600UL,
+  733280400UL, 749005200UL, 764730000UL, 780454800UL, 796179600UL, 811904400UL,
+  828234000UL, 846378000UL, 859683600UL, 877827600UL, 891133200UL, 909277200UL,
+  922582800UL, 941331600UL, 954032400UL, 972781200UL, 985482000UL, 1004230800UL,
+  1017536400UL, 1035680400UL, 1048986000UL, 1067130000UL, 1080435600UL, 1099184400UL,
+  1111885200UL, 1130634000UL, 1143334800UL, 1162083600UL, 1174784400UL, 1193533200UL,
+  1206838800UL, 1224982800UL, 1238288400UL, 1256432400UL, 1269738000UL, 1288486800UL,
+  1301187600UL, 1319936400UL, 1332637200UL, 1351386000UL, 1364691600UL, 1382835600UL,
+  1396141200UL, 1414285200UL, 1427590800UL, 1445734800UL, 1459040400UL, 1477789200UL,
+  1490490000UL, 1509238800UL, 1521939600UL, 1540688400UL, 1553994000UL, 1572138000UL,
+  1585443600UL, 1603587600UL, 1616893200UL, 1635642000UL, 1648342800UL, 1667091600UL,
+  1679792400UL, 1698541200UL, 1711846800UL, 1729990800UL, 1743296400UL, 1761440400UL,
+  1774746000UL, 1792890000UL, 1806195600UL, 1824944400UL, 1837645200UL, 1856394000UL,
+  1869094800UL, 1887843600UL, 1901149200UL, 1919293200UL, 1932598800UL, 1950742800UL,
+  1964048400UL, 1982797200UL, 1995498000UL, 2014246800UL, 2026947600UL, 2045696400UL,
+  2058397200UL, 2077146000UL, 2090451600UL, 2108595600UL, 2121901200UL, 2140045200UL,
+  2153350800UL, 2172099600UL, 2184800400UL, 2203549200UL, 2216250000UL, 2234998800UL,
+  2248304400UL, 2266448400UL, 2279754000UL, 2297898000UL, 2311203600UL, 2329347600UL,
+  2342653200UL, 2361402000UL, 2374102800UL, 2392851600UL, 2405552400UL, 2424301200UL,
+  2437606800UL, 2455750800UL, 2469056400UL, 2487200400UL, 2500506000UL, 2519254800UL,
+  2531955600UL, 2550704400UL, 2563405200UL, 2582154000UL, 2595459600UL, 2613603600UL,
+  2626909200UL, 2645053200UL, 2658358800UL, 2676502800UL, 2689808400UL, 2708557200UL,
+  2721258000UL, 2740006800UL, 2752707600UL, 2771456400UL, 2784762000UL, 2802906000UL,
+  2816211600UL, 2834355600UL, 2847661200UL, 2866410000UL, 2879110800UL, 2897859600UL,
+  2910560400UL, 2929309200UL, 2942010000UL, 2960758800UL, 2974064400UL, 2992208400UL,
+  3005514000UL, 3023658000UL, 3036963600UL, 3055712400UL, 3068413200UL, 3087162000UL,
+  3099862800UL, 3118611600UL, 3131917200UL, 3150061200UL, 3163366800UL, 3181510800UL,
+  3194816400UL, 3212960400UL, 3226266000UL, 3245014800UL, 3257715600UL, 3276464400UL,
+  3289165200UL, 3307914000UL, 3321219600UL, 3339363600UL, 3352669200UL, 3370813200UL,
+  3384118800UL, 3402867600UL, 3415568400UL, 3434317200UL, 3447018000UL, 3465766800UL,
+  3479072400UL, 3497216400UL, 3510522000UL, 3528666000UL, 3541971600UL, 3560115600UL,
+  3573421200UL, 3592170000UL, 3604870800UL, 3623619600UL, 3636320400UL, 3655069200UL,
+  3668374800UL, 3686518800UL, 3699824400UL, 3717968400UL, 3731274000UL, 3750022800UL,
+  3762723600UL, 3781472400UL, 3794173200UL, 3812922000UL, 3825622800UL, 3844371600UL,
+  3857677200UL, 3875821200UL, 3889126800UL, 3907270800UL, 3920576400UL, 3939325200UL,
+  3952026000UL, 3970774800UL, 3983475600UL, 4002224400UL, 4015530000UL, 4033674000UL,
+  4046979600UL, 4065123600UL, 4078429200UL, 4096573200UL, 4109878800UL, 4128627600UL,
+  166485600UL, 186184800UL, 198028800UL, 213753600UL, 228873600UL, 244080000UL,
+  260323200UL, 275446800UL, 291798000UL, 307407600UL, 323388000UL, 338936400UL,
+  354675600UL, 370400400UL, 386125200UL, 401850000UL, 417574800UL, 433299600UL,
+  449024400UL, 465354000UL, 481078800UL, 496803600UL, 512528400UL, 528253200UL,
+  543978000UL, 559702800UL, 575427600UL, 591152400UL, 606877200UL, 622602000UL,
+  638326800UL, 654656400UL, 670381200UL, 686106000UL, 701830800UL, 717555600UL,
+  733280400UL, 749005200UL, 764730000UL, 780454800UL, 796179600UL, 811904400UL,
+  828234000UL, 846378000UL, 859683600UL, 877827600UL, 891133200UL, 909277200UL,
+  922582800UL, 941331600UL, 954032400UL, 972781200UL, 985482000UL, 1004230800UL,
+  1017536400UL, 1035680400UL, 1048986000UL, 1067130000UL, 1080435600UL, 1099184400UL,
+  1111885200UL, 1130634000UL, 1143334800UL, 1162083600UL, 1174784400UL, 1193533200UL,
+  1206838800UL, 1224982800UL, 1238288400UL, 1256432400UL, 1269738000UL, 1288486800UL,
+  1301187600UL, 1319936400UL, 1332637200UL, 1351386000UL, 1364691600UL, 1382835600UL,
+  1396141200UL, 1414285200UL, 1427590800UL, 1445734800UL, 1459040400UL, 1477789200UL,
+  1490490000UL, 1509238800UL, 1521939600UL, 1540688400UL, 1553994000UL, 1572138000UL,
+  1585443600UL, 1603587600UL, 1616893200UL, 1635642000UL, 1648342800UL, 1667091600UL,
+  1679792400UL, 1698541200UL, 1711846800UL, 1729990800UL, 1743296400UL, 1761440400UL,
+  1774746000UL, 1792890000UL, 1806195600UL, 1824944400UL, 1837645200UL, 1856394000UL,
+  1869094800UL, 1887843600UL, 1901149200UL, 1919293200UL, 1932598800UL, 1950742800UL,
+  1964048400UL, 1982797200UL, 1995498000UL, 2014246800UL, 2026947600UL, 2045696400UL,
+  2058397200UL, 2077146000UL, 2090451600UL, 2108595600UL, 2121901200UL, 2140045200UL,
+  2153350800UL, 2172099600UL, 2184800400UL, 2203549200UL, 2216250000UL, 2234998800UL,
+  2248304400UL, 2266448400UL, 2279754000UL, 2297898000UL, 2311203600UL, 2329347600UL,
+  2342653200UL, 2361402000UL, 2374102800UL, 2392851600UL, 2405552400UL, 2424301200UL,
+  2437606800UL, 2455750800UL, 2469056400UL, 2487200400UL, 2500506000UL, 2519254800UL,
+  2531955600UL, 2550704400UL, 2563405200UL, 2582154000UL, 2595459600UL, 2613603600UL,
+  2626909200UL, 2645053200UL, 2658358800UL, 2676502800UL, 2689808400UL, 2708557200UL,
+  2721258000UL, 2740006800UL, 2752707600UL, 2771456400UL, 2784762000UL, 2802906000UL,
+  2816211600UL, 2834355600UL, 2847661200UL, 2866410000UL, 2879110800UL, 2897859600UL,
+  2910560400UL, 2929309200UL, 2942010000UL, 2960758800UL, 2974064400UL, 2992208400UL,
+  3005514000UL, 3023658000UL, 3036963600UL, 3055712400UL, 3068413200UL, 3087162000UL,
+  3099862800UL, 3118611600UL, 3131917200UL, 3150061200UL, 3163366800UL, 3181510800UL,
+  3194816400UL, 3212960400UL, 3226266000UL, 3245014800UL, 3257715600UL, 3276464400UL,
+  3289165200UL, 3307914000UL, 3321219600UL, 3339363600UL, 3352669200UL, 3370813200UL,
+  3384118800UL, 3402867600UL, 3415568400UL, 3434317200UL, 3447018000UL, 3465766800UL,
+  3479072400UL, 3497216400UL, 3510522000UL, 3528666000UL, 3541971600UL, 3560115600UL,
+  3573421200UL, 3592170000UL, 3604870800UL, 3623619600UL, 3636320400UL, 3655069200UL,
+  3668374800UL, 3686518800UL, 3699824400UL, 3717968400UL, 3731274000UL, 3750022800UL,
+  3762723600UL, 3781472400UL, 3794173200UL, 3812922000UL, 3825622800UL, 3844371600UL,
+  3857677200UL, 3875821200UL, 3889126800UL, 3907270800UL, 3920576400UL, 3939325200UL,
+  3952026000UL, 3970774800UL, 3983475600UL, 4002224400UL, 4015530000UL, 4033674000UL,
+  4046979600UL, 4065123600UL, 4078429200UL, 4096573200UL, 4109878800UL, 4128627600UL,
+  354920400UL, 370728000UL, 386456400UL, 402264000UL, 417992400UL, 433800000UL,
+  449614800UL, 465346800UL, 481071600UL, 496796400UL, 512521200UL, 528246000UL,
+  543970800UL, 559695600UL, 575420400UL, 591145200UL, 606870000UL, 622594800UL,
+  638319600UL, 654649200UL, 686102400UL, 695779200UL, 701823600UL, 717548400UL,
+  733273200UL, 748998000UL, 764722800UL, 780447600UL, 796172400UL, 811897200UL,
+  828226800UL, 846370800UL, 859676400UL, 877820400UL, 891126000UL, 909270000UL,
+  922575600UL, 941324400UL, 954025200UL, 972774000UL, 985474800UL, 1004223600UL,
+  1017529200UL, 1035673200UL, 1048978800UL, 1067122800UL, 1080428400UL, 1099177200UL,
+  1111878000UL, 1130626800UL, 1143327600UL, 1162076400UL, 1174777200UL, 1193526000UL,
+  1206831600UL, 1224975600UL, 1238281200UL, 1256425200UL, 1269730800UL, 1288479600UL,
+  1301180400UL, 1414274400UL, 152042400UL, 162928800UL, 436298400UL, 447184800UL,
+  690314400UL, 699386400UL, 1165082400UL, 1174759200UL, 1193508000UL, 1206813600UL,
+  1224957600UL, 1238263200UL, 57688200UL, 67969800UL, 89137800UL, 100024200UL,
+  120587400UL, 131473800UL, 152037000UL, 162923400UL, 183486600UL, 194977800UL,
+  215541000UL, 226427400UL, 246990600UL, 257877000UL, 278440200UL, 289326600UL,
+  309889800UL, 320776200UL, 341339400UL, 352225800UL, 372789000UL, 384280200UL,
+  404843400UL, 415729800UL, 436293000UL, 447179400UL, 467742600UL, 478629000UL,
+  499192200UL, 511288200UL, 530037000UL, 542737800UL, 562091400UL, 574792200UL,
+  594145800UL, 606241800UL, 625595400UL, 637691400UL, 657045000UL, 667931400UL,
+  688494600UL, 701195400UL, 719944200UL, 731435400UL, 751998600UL, 764094600UL,
+  783448200UL, 796149000UL, 814897800UL, 828203400UL, 846347400UL, 859653000UL,
+  877797000UL, 891102600UL, 909246600UL, 922552200UL, 941301000UL, 954001800UL,
+  972750600UL, 985451400UL, 1004200200UL, 1017505800UL, 1035649800UL, 1048955400UL,
+  1067099400UL, 1080405000UL, 1099153800UL, 1111854600UL, 1130603400UL, 1143909000UL,
+  1162053000UL, 1174753800UL, 1193502600UL, 1207413000UL, 1223137800UL, 1238862600UL,
+  1254587400UL, 1270312200UL, 1286037000UL, 1301761800UL, 1317486600UL, 1333211400UL,
+  1349541000UL, 1365265800UL, 1380990600UL, 1396715400UL, 1412440200UL, 1428165000UL,
+  1443889800UL, 1459614600UL, 1475339400UL, 1491064200UL, 1506789000UL, 1522513800UL,
+  1538843400UL, 1554568200UL, 1570293000UL, 1586017800UL, 1601742600UL, 1617467400UL,
+  1633192200UL, 1648917000UL, 1664641800UL, 1680366600UL, 1696091400UL, 1712421000UL,
+  1728145800UL, 1743870600UL, 1759595400UL, 1775320200UL, 1791045000UL, 1806769800UL,
+  1822494600UL, 1838219400UL, 1853944200UL, 1869669000UL, 1885998600UL, 1901723400UL,
+  1917448200UL, 1933173000UL, 1948897800UL, 1964622600UL, 1980347400UL, 1996072200UL,
+  2011797000UL, 2027521800UL, 2043246600UL, 2058971400UL, 2075301000UL, 2091025800UL,
+  2106750600UL, 2122475400UL, 2138200200UL, 2153925000UL, 2169649800UL, 2185374600UL,
+  2201099400UL, 2216824200UL, 2233153800UL, 2248878600UL, 2264603400UL, 2280328200UL,
+  2296053000UL, 2311777800UL, 2327502600UL, 2343227400UL, 2358952200UL, 2374677000UL,
+  2390401800UL, 2406126600UL, 2422456200UL, 2438181000UL, 2453905800UL, 2469630600UL,
+  2485355400UL, 2501080200UL, 2516805000UL, 2532529800UL, 2548254600UL, 2563979400UL,
+  2579704200UL, 2596033800UL, 2611758600UL, 2627483400UL, 2643208200UL, 2658933000UL,
+  2674657800UL, 2690382600UL, 2706107400UL, 2721832200UL, 2737557000UL, 2753281800UL,
+  2769611400UL, 2785336200UL, 2801061000UL, 2816785800UL, 2832510600UL, 2848235400UL,
+  2863960200UL, 2879685000UL, 2895409800UL, 2911134600UL, 2926859400UL, 2942584200UL,
+  2958913800UL, 2974638600UL, 2990363400UL, 3006088200UL, 3021813000UL, 3037537800UL,
+  3053262600UL, 3068987400UL, 3084712200UL, 3100437000UL, 3116766600UL, 3132491400UL,
+  3148216200UL, 3163941000UL, 3179665800UL, 3195390600UL, 3211115400UL, 3226840200UL,
+  3242565000UL, 3258289800UL, 3274014600UL, 3289739400UL, 3306069000UL, 3321793800UL,
+  3337518600UL, 3353243400UL, 3368968200UL, 3384693000UL, 3400417800UL, 3416142600UL,
+  3431867400UL, 3447592200UL, 3463317000UL, 3479646600UL, 3495371400UL, 3511096200UL,
+  3526821000UL, 3542545800UL, 3558270600UL, 3573995400UL, 3589720200UL, 3605445000UL,
+  3621169800UL, 3636894600UL, 3653224200UL, 3668949000UL, 3684673800UL, 3700398600UL,
+  3716123400UL, 3731848200UL, 3747573000UL, 3763297800UL, 3779022600UL, 3794747400UL,
+  3810472200UL, 3826197000UL, 3842526600UL, 3858251400UL, 3873976200UL, 3889701000UL,
+  3905425800UL, 3921150600UL, 3936875400UL, 3952600200UL, 3968325000UL, 3984049800UL,
+  4000379400UL, 4016104200UL, 4031829000UL, 4047553800UL, 4063278600UL, 4079003400UL,
+  4094728200UL, 4110453000UL, 4126177800UL, 57686400UL, 67968000UL, 89136000UL,
+  100022400UL, 120585600UL, 131472000UL, 152035200UL, 162921600UL, 183484800UL,
+  194976000UL, 215539200UL, 226425600UL, 246988800UL, 257875200UL, 278438400UL,
+  289324800UL, 309888000UL, 320774400UL, 341337600UL, 352224000UL, 372787200UL,
+  386697600UL, 404841600UL, 415728000UL, 436291200UL, 447177600UL, 467740800UL,
+  478627200UL, 499190400UL, 511286400UL, 530035200UL, 542736000UL, 562089600UL,
+  574790400UL, 594144000UL, 606240000UL, 625593600UL, 636480000UL, 657043200UL,
+  667929600UL, 688492800UL, 699379200UL, 719942400UL, 731433600UL, 751996800UL,
+  762883200UL, 783446400UL, 794332800UL, 814896000UL, 828201600UL, 846345600UL,
+  859651200UL, 877795200UL, 891100800UL, 909244800UL, 922550400UL, 941299200UL,
+  954000000UL, 967305600UL, 985449600UL, 1004198400UL, 1017504000UL, 1035648000UL,
+  1048953600UL, 1067097600UL, 1080403200UL, 1099152000UL, 1111852800UL, 1130601600UL,
+  1143907200UL, 1162051200UL, 1174752000UL, 1193500800UL, 1207411200UL, 1223136000UL,
+  1238860800UL, 1254585600UL, 1270310400UL, 1286035200UL, 1301760000UL, 1317484800UL,
+  1333209600UL, 1349539200UL, 1365264000UL, 1380988800UL, 1396713600UL, 1412438400UL,
+  1428163200UL, 1443888000UL, 1459612800UL, 1475337600UL, 1491062400UL, 1506787200UL,
+  1522512000UL, 1538841600UL, 1554566400UL, 1570291200UL, 1586016000UL, 1601740800UL,
+  1617465600UL, 1633190400UL, 1648915200UL, 1664640000UL, 1680364800UL, 1696089600UL,
+  1712419200UL, 1728144000UL, 1743868800UL, 1759593600UL, 1775318400UL, 1791043200UL,
+  1806768000UL, 1822492800UL, 1838217600UL, 1853942400UL, 1869667200UL, 1885996800UL,
+  1901721600UL, 1917446400UL, 1933171200UL, 1948896000UL, 1964620800UL, 1980345600UL,
+  1996070400UL, 2011795200UL, 2027520000UL, 2043244800UL, 2058969600UL, 2075299200UL,
+  2091024000UL, 2106748800UL, 2122473600UL, 2138198400UL, 2153923200UL, 2169648000UL,
+  2185372800UL, 2201097600UL, 2216822400UL, 2233152000UL, 2248876800UL, 2264601600UL,
+  2280326400UL, 2296051200UL, 2311776000UL, 2327500800UL, 2343225600UL, 2358950400UL,
+  2374675200UL, 2390400000UL, 2406124800UL, 2422454400UL, 2438179200UL, 2453904000UL,
+  2469628800UL, 2485353600UL, 2501078400UL, 2516803200UL, 2532528000UL, 2548252800UL,
+  2563977600UL, 2579702400UL, 2596032000UL, 2611756800UL, 2627481600UL, 2643206400UL,
+  2658931200UL, 2674656000UL, 2690380800UL, 2706105600UL, 2721830400UL, 2737555200UL,
+  2753280000UL, 2769609600UL, 2785334400UL, 2801059200UL, 2816784000UL, 2832508800UL,
+  2848233600UL, 2863958400UL, 2879683200UL, 2895408000UL, 2911132800UL, 2926857600UL,
+  2942582400UL, 2958912000UL, 2974636800UL, 2990361600UL, 3006086400UL, 3021811200UL,
+  3037536000UL, 3053260800UL, 3068985600UL, 3084710400UL, 3100435200UL, 3116764800UL,
+  3132489600UL, 3148214400UL, 3163939200UL, 3179664000UL, 3195388800UL, 3211113600UL,
+  3226838400UL, 3242563200UL, 3258288000UL, 3274012800UL, 3289737600UL, 3306067200UL,
+  3321792000UL, 3337516800UL, 3353241600UL, 3368966400UL, 3384691200UL, 3400416000UL,
+  3416140800UL, 3431865600UL, 3447590400UL, 3463315200UL, 3479644800UL, 3495369600UL,
+  3511094400UL, 3526819200UL, 3542544000UL, 3558268800UL, 3573993600UL, 3589718400UL,
+  3605443200UL, 3621168000UL, 3636892800UL, 3653222400UL, 3668947200UL, 3684672000UL,
+  3700396800UL, 3716121600UL, 3731846400UL, 3747571200UL, 3763296000UL, 3779020800UL,
+  3794745600UL, 3810470400UL, 3826195200UL, 3842524800UL, 3858249600UL, 3873974400UL,
+  3889699200UL, 3905424000UL, 3921148800UL, 3936873600UL, 3952598400UL, 3968323200UL,
+  3984048000UL, 4000377600UL, 4016102400UL, 4031827200UL, 4047552000UL, 4063276800UL,
+  4079001600UL, 4094726400UL, 4110451200UL, 4126176000UL, 152632800UL, 162309600UL,
+  183477600UL, 194968800UL, 215532000UL, 226418400UL, 246981600UL, 257868000UL,
+  278431200UL, 289317600UL, 309880800UL, 320767200UL, 341330400UL, 352216800UL,
+  372780000UL, 384271200UL, 404834400UL, 415720800UL, 436284000UL, 447170400UL,
+  467733600UL, 478620000UL, 499183200UL, 510069600UL, 530632800UL, 541519200UL,
+  562082400UL, 573573600UL, 594136800UL, 605023200UL, 623772000UL, 637682400UL,
+  655221600UL, 669132000UL, 686671200UL, 700581600UL, 718120800UL, 732636000UL,
+  749570400UL, 764085600UL, 781020000UL, 795535200UL, 812469600UL, 826984800UL,
+  844524000UL, 858434400UL, 875973600UL, 889884000UL, 907423200UL, 921938400UL,
+  938872800UL, 953388000UL, 970322400UL, 984837600UL, 1002376800UL, 1016287200UL,
+  1033826400UL, 1047736800UL, 1065276000UL, 1079791200UL, 1096725600UL, 1111240800UL,
+  1128175200UL, 1142690400UL, 1159624800UL, 1174140000UL, 1191074400UL, 1207404000UL,
+  1222524000UL, 1238853600UL, 1253973600UL, 1270303200UL, 1285423200UL, 1301752800UL,
+  1316872800UL, 1333202400UL, 1348927200UL, 1365256800UL, 1380376800UL, 1396706400UL,
+  1411826400UL, 1428156000UL, 1443276000UL, 1459605600UL, 1474725600UL, 1491055200UL,
+  1506175200UL, 1522504800UL, 1538229600UL, 1554559200UL, 1569679200UL, 1586008800UL,
+  1601128800UL, 1617458400UL, 1632578400UL, 1648908000UL, 1664028000UL, 1680357600UL,
+  1695477600UL, 1712412000UL, 1727532000UL, 1743861600UL, 1758981600UL, 1775311200UL,
+  1790431200UL, 1806760800UL, 1821880800UL, 1838210400UL, 1853330400UL, 1869660000UL,
+  1885384800UL, 1901714400UL, 1916834400UL, 1933164000UL, 1948284000UL, 1964613600UL,
+  1979733600UL, 1996063200UL, 2011183200UL, 2027512800UL, 2042632800UL, 2058962400UL,
+  2074687200UL, 2091016800UL, 2106136800UL, 2122466400UL, 2137586400UL, 2153916000UL,
+  2169036000UL, 2185365600UL, 2200485600UL, 2216815200UL, 2232540000UL, 2248869600UL,
+  2263989600UL, 2280319200UL, 2295439200UL, 2311768800UL, 2326888800UL, 2343218400UL,
+  2358338400UL, 2374668000UL, 2389788000UL, 2406117600UL, 2421842400UL, 2438172000UL,
+  2453292000UL, 2469621600UL, 2484741600UL, 2501071200UL, 2516191200UL, 2532520800UL,
+  2547640800UL, 2563970400UL, 2579090400UL, 2596024800UL, 2611144800UL, 2627474400UL,
+  2642594400UL, 2658924000UL, 2674044000UL, 2690373600UL, 2705493600UL, 2721823200UL,
+  2736943200UL, 2753272800UL, 2768997600UL, 2785327200UL, 2800447200UL, 2816776800UL,
+  2831896800UL, 2848226400UL, 2863346400UL, 2879676000UL, 2894796000UL, 2911125600UL,
+  2926245600UL, 2942575200UL, 2958300000UL, 2974629600UL, 2989749600UL, 3006079200UL,
+  3021199200UL, 3037528800UL, 3052648800UL, 3068978400UL, 3084098400UL, 3100428000UL,
+  3116152800UL, 3132482400UL, 3147602400UL, 3163932000UL, 3179052000UL, 3195381600UL,
+  3210501600UL, 3226831200UL, 3241951200UL, 3258280800UL, 3273400800UL, 3289730400UL,
+  3305455200UL, 3321784800UL, 3336904800UL, 3353234400UL, 3368354400UL, 3384684000UL,
+  3399804000UL, 3416133600UL, 3431253600UL, 3447583200UL, 3462703200UL, 3479637600UL,
+  3494757600UL, 3511087200UL, 3526207200UL, 3542536800UL, 3557656800UL, 3573986400UL,
+  3589106400UL, 3605436000UL, 3620556000UL, 3636885600UL, 3652610400UL, 3668940000UL,
+  3684060000UL, 3700389600UL, 3715509600UL, 3731839200UL, 3746959200UL, 3763288800UL,
+  3778408800UL, 3794738400UL, 3809858400UL, 3826188000UL, 3841912800UL, 3858242400UL,
+  3873362400UL, 3889692000UL, 3904812000UL, 3921141600UL, 3936261600UL, 3952591200UL,
+  3967711200UL, 3984040800UL, 3999765600UL, 4016095200UL, 4031215200UL, 4047544800UL,
+  4062664800UL, 4078994400UL, 4094114400UL, 4110444000UL, 4125564000UL, 499748400UL,
+  511236000UL, 530593200UL, 540266400UL, 562129200UL, 571197600UL, 592974000UL,
+  602042400UL, 624423600UL, 634701600UL, 656478000UL, 666756000UL, 687927600UL,
+  697600800UL, 719982000UL, 728445600UL, 750826800UL, 761709600UL, 782276400UL,
+  793159200UL, 813726000UL, 824004000UL, 844570800UL, 856058400UL, 876106800UL,
+  888717600UL, 908074800UL, 919562400UL, 938919600UL, 951616800UL, 970974000UL,
+  982461600UL, 1003028400UL, 1013911200UL, 1036292400UL, 1045360800UL, 1066532400UL,
+  1076810400UL, 1099364400UL, 1108864800UL, 1129431600UL, 1140314400UL, 1162695600UL,
+  1172368800UL, 1192330800UL, 1203213600UL, 1224385200UL, 1234663200UL, 1255834800UL,
+  1266717600UL, 1287284400UL, 1298167200UL, 1318734000UL, 1330221600UL, 1350788400UL,
+  1361066400UL, 1382238000UL, 1392516000UL, 1413687600UL, 1424570400UL, 1445137200UL,
+  1456020000UL, 1476586800UL, 1487469600UL, 1508036400UL, 1518919200UL, 1541300400UL,
+  1550368800UL, 128142000UL, 136605600UL, 596948400UL, 605066400UL, 624423600UL,
+  636516000UL, 656478000UL, 667965600UL, 687927600UL, 699415200UL, 719377200UL,
+  731469600UL, 1198983600UL, 1205632800UL, 1224385200UL, 1237082400UL,
+};
+
+const int8_t tzdbTransitionOffsets[] PROGMEM = {
+  -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24,
+  -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24,
+  -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24,
+  -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24,
+  -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24,
+  -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24,
+  -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24,
+  -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24,
+  -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24,
+  -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24,
+  -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24,
+  -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24,
+  -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24,
+  -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24,
+  -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24,
+  -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24, -20, -24,
+  -20, -24, -20, -24, -20, -24, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20,
+  -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20,
+  -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20,
+  -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20,
+  -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20,
+  -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20,
+  -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20,
+  -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20,
+  -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20,
+  -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20,
+  -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20,
+  -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20,
+  -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20,
+  -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20,
+  -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20,
+  -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20,
+  -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -16, -20, -28, -32, -28, -32,
+  -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32,
+  -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32,
+  -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32,
+  -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32,
+  -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32,
+  -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32,
+  -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32,
+  -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32,
+  -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32,
+  -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32,
+  -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32,
+  -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32,
+  -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32,
+  -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32,
+  -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32,
+  -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32, -28, -32,
+  -28, -32, 18, 16, 20, 16, 14, 18, 14, 18, 14, 18, 14, 18, 14, 18,
+  14, 18, 14, 18, 14, 18, 14, 18, 14, 18, 14, 18, 14, 18, 14, 18,
+  14, 18, 14, 18, 14, 18, 14, 18, 14, 18, 14, 18, 14, 18, 14, 18,
+  14, 18, 14, 18, 14, 18, 14, 18, 14, 18, 14, 18, 14, 18, 14, 18,
+  14, 18, 14, 18, 14, 18, 14, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 8, 4, 8, 4, 8, 4,
+  8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4,
+  8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4,
+  8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4,
+  8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4,
+  8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4,
+  8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4,
+  8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4,
+  8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4,
+  8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4,
+  8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4,
+  8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4,
+  8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4,
+  8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4,
+  8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4,
+  8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 8, 4, 12, 8, 12, 8,
+  12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8,
+  12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8,
+  12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8,
+  12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8,
+  12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8,
+  12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8,
+  12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8,
+  12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8,
+  12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8,
+  12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8,
+  12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8,
+  12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8,
+  12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8,
+  12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8,
+  12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8, 12, 8,
+  12, 8, 12, 8, 12, 8, 12, 8, 16, 12, 16, 12, 16, 12, 16, 12,
+  16, 12, 16, 12, 16, 12, 16, 12, 16, 12, 16, 12, 8, 12, 16, 12,
+  16, 12, 16, 12, 16, 12, 16, 12, 16, 12, 16, 12, 16, 12, 16, 12,
+  16, 12, 16, 12, 16, 12, 16, 12, 16, 12, 16, 12, 16, 12, 16, 12,
+  16, 12, 16, 12, 16, 12, 36, 32, 36, 32, 36, 32, 36, 32, 36, 32,
+  36, 32, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38,
+  42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38,
+  42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38,
+  42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38,
+  42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38,
+  42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38,
+  42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38,
+  42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38,
+  42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38,
+  42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38,
+  42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38,
+  42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38,
+  42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38,
+  42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38,
+  42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38,
+  42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38, 42, 38,
+  42, 38, 42, 38, 42, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44,
+  40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44,
+  40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44,
+  40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44,
+  40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44,
+  40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44,
+  40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44,
+  40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44,
+  40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44,
+  40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44,
+  40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44,
+  40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44,
+  40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44,
+  40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44,
+  40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44,
+  40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44, 40, 44,
+  40, 44, 40, 44, 40, 44, 40, 44, 52, 48, 52, 48, 52, 48, 52, 48,
+  52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48,
+  52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48,
+  52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48,
+  52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48,
+  52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48,
+  52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48,
+  52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48,
+  52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48,
+  52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48,
+  52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48,
+  52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48,
+  52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48,
+  52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48,
+  52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48,
+  52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48, 52, 48,
+  52, 48, 52, 48, 52, -8, -12, -8, -12, -8, -12, -8, -12, -8, -12, -8,
+  -12, -8, -12, -8, -12, -8, -12, -8, -12, -8, -12, -8, -12, -8, -12, -8,
+  -12, -8, -12, -8, -12, -8, -12, -8, -12, -8, -12, -8, -12, -8, -12, -8,
+  -12, -8, -12, -8, -12, -8, -12, -8, -12, -8, -12, -8, -12, -8, -12, -8,
+  -12, -8, -12, -8, -12, -8, -12, -8, -12, -8, -12, -8, -12, -8, -12, -8,
+  -12, -8, -12, -8, -12, -8, -12, -8, -12,
+};
@@ -0,0 +1,23 @@
+#ifndef TZDB_H
+#define TZDB_H
+
+// Generated by tools/gen_tzdb.py (1970-2100) - do not edit.
+
+#include <Arduino.h>
+
+const int TZDB_LABEL_SIZE = 6;
+const int TZDB_ZONE_COUNT = 18;
+
+struct TzdbZone {
+  char label[TZDB_LABEL_SIZE];  // Display name
+  uint16_t firstTransition;     // Index into tzdbTransitionTimes/Offsets
+  uint16_t transitionCount;
+  int8_t initialOffset;         // Quarter hours, before the first transition
+  uint8_t reserved;
+};
+
+extern const TzdbZone tzdbZones[TZDB_ZONE_COUNT] PROGMEM;
+extern const uint32_t tzdbTransitionTimes[] PROGMEM;  // UTC seconds, sorted per zone
+extern const int8_t tzdbTransitionOffsets[] PROGMEM;  // Quarter hours from that instant on
+
+#endif
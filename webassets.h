@@ -0,0 +1,202 @@
+#ifndef WEBASSETS_H
+#define WEBASSETS_H
+
+// Generated by tools/gen_web_assets.py from web/ - do not edit.
+
+#include <Arduino.h>
+
+// web/index.html: 13252 bytes, 2997 gzipped
+#define INDEX_HTML_ETAG "\"cc1f5063c3472230\""
+const size_t INDEX_HTML_GZ_SIZE = 2997;
+static const uint8_t INDEX_HTML_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x5b, 0xdd, 0x72, 0xdb, 0xb8,
+  0x15, 0xbe, 0xcf, 0x53, 0x60, 0x99, 0xd9, 0x4a, 0x6a, 0x44, 0x4a, 0x94, 0x2d, 0x39, 0x91, 0x25,
+  0xb5, 0xbb, 0x89, 0xd3, 0x4d, 0xc7, 0xd9, 0x78, 0x62, 0x67, 0x3b, 0xdb, 0x4c, 0x2e, 0x20, 0x12,
+  0x94, 0xb0, 0xa6, 0x08, 0x15, 0x04, 0x65, 0xcb, 0xbb, 0x79, 0x83, 0x76, 0x3a, 0xd3, 0x5e, 0xb5,
+  0x37, 0x7d, 0x8b, 0x4e, 0xaf, 0xfa, 0x30, 0x7d, 0x81, 0xf6, 0x11, 0x7a, 0x00, 0xfe, 0x88, 0xff,
+  0xa2, 0xf2, 0xd3, 0xa4, 0xf6, 0xc4, 0x22, 0x09, 0xf0, 0xe0, 0xfc, 0x7e, 0xe7, 0x1c, 0x40, 0x99,
+  0x7c, 0xf1, 0xe4, 0xc5, 0xe3, 0xab, 0xef, 0x2f, 0xce, 0xd0, 0x52, 0xac, 0xdc, 0xd9, 0xbd, 0x89,
+  0xfc, 0x40, 0x2e, 0xf6, 0x16, 0x53, 0x8d, 0x78, 0x9a, 0x7c, 0x40, 0xb0, 0x3d, 0xbb, 0x87, 0xe0,
+  0x67, 0xb2, 0x22, 0x02, 0x23, 0x6b, 0x89, 0xb9, 0x4f, 0xc4, 0x54, 0x7b, 0x75, 0xf5, 0x54, 0x7f,
+  0xa8, 0xa5, 0x87, 0x3c, 0xbc, 0x22, 0x53, 0x6d, 0x43, 0xc9, 0xcd, 0x9a, 0x71, 0xa1, 0x21, 0x8b,
+  0x79, 0x82, 0x78, 0x30, 0xf5, 0x86, 0xda, 0x62, 0x39, 0xb5, 0xc9, 0x86, 0x5a, 0x44, 0x57, 0x37,
+  0x5d, 0x44, 0x3d, 0x2a, 0x28, 0x76, 0x75, 0xdf, 0xc2, 0x2e, 0x99, 0x9a, 0x46, 0x3f, 0x26, 0x25,
+  0xa8, 0x70, 0xc9, 0xec, 0x79, 0xe0, 0x0a, 0xaa, 0xff, 0x96, 0x79, 0x04, 0x3d, 0xc7, 0x82, 0xd3,
+  0x5b, 0xf4, 0xd8, 0x65, 0xd6, 0xf5, 0xa4, 0x17, 0x0e, 0x87, 0x53, 0x7d, 0xb1, 0x8d, 0xaf, 0xe5,
+  0xcf, 0xcf, 0xd1, 0x8f, 0xc9, 0xb5, 0xfc, 0x59, 0x61, 0xbe, 0xa0, 0xde, 0x18, 0xf5, 0x4f, 0x33,
+  0x8f, 0xd7, 0xd8, 0xb6, 0xa9, 0xb7, 0x28, 0x3c, 0x9f, 0xb3, 0x5b, 0xdd, 0xa7, 0x77, 0x6a, 0x68,
+  0xce, 0xb8, 0x4d, 0xb8, 0x0e, 0x8f, 0x76, 0x73, 0xde, 0x26, 0x57, 0xf7, 0x76, 0xaf, 0xd8, 0xdb,
+  0xdc, 0xa2, 0x0e, 0x08, 0xad, 0x3b, 0x78, 0x45, 0xdd, 0xed, 0x18, 0xb5, 0x2e, 0xc9, 0x82, 0x11,
+  0xf4, 0xea, 0x59, 0xab, 0x8b, 0xae, 0xf0, 0x92, 0xad, 0x70, 0x17, 0xfd, 0x8a, 0x78, 0x64, 0x03,
+  0x9f, 0xdf, 0x11, 0x6e, 0x63, 0x0f, 0x2e, 0x7c, 0xec, 0xf9, 0xba, 0x4f, 0x38, 0x75, 0x72, 0xfc,
+  0x60, 0xeb, 0x7a, 0xc1, 0x59, 0xe0, 0xd9, 0x63, 0xe4, 0x52, 0x8f, 0x60, 0xae, 0x2f, 0x38, 0xb6,
+  0x29, 0xa8, 0xb4, 0x6d, 0x1e, 0x0d, 0x6d, 0xb2, 0xe8, 0xa2, 0xfb, 0xa3, 0xd1, 0x09, 0x21, 0x18,
+  0xf5, 0xbf, 0x84, 0xeb, 0x93, 0xd1, 0xf1, 0x1c, 0x0f, 0x90, 0xd9, 0xef, 0x7f, 0xd9, 0xc9, 0x92,
+  0x5a, 0x51, 0x4f, 0x5f, 0x12, 0xba, 0x58, 0x8a, 0xb1, 0x1c, 0xde, 0x2c, 0x2b, 0x34, 0x32, 0xe8,
+  0xaf, 0x6f, 0xb3, 0x43, 0x36, 0xf5, 0xd7, 0x2e, 0x06, 0x51, 0x1c, 0x97, 0xe4, 0x86, 0x7e, 0x08,
+  0x7c, 0x41, 0x9d, 0xad, 0x1e, 0x99, 0x79, 0x8c, 0x2c, 0xf8, 0x4b, 0x78, 0x76, 0x12, 0x76, 0xe9,
+  0xc2, 0xd3, 0xa9, 0x20, 0x2b, 0xbf, 0x38, 0xa1, 0x44, 0xa3, 0x86, 0xa4, 0x86, 0x41, 0x5a, 0x9e,
+  0xd3, 0x6b, 0x5a, 0x1b, 0x37, 0x4b, 0x20, 0x98, 0x37, 0x9e, 0x32, 0x98, 0xd4, 0x4f, 0xe0, 0x97,
+  0x09, 0xa2, 0xac, 0xbb, 0xc4, 0x36, 0xbb, 0x01, 0xc3, 0xab, 0x71, 0x34, 0x92, 0x7f, 0xf8, 0x62,
+  0x8e, 0xdb, 0xfd, 0xae, 0xfa, 0x35, 0x8e, 0x3a, 0x15, 0x8a, 0x39, 0x2e, 0xd0, 0x5b, 0xe1, 0xdb,
+  0xd0, 0x95, 0xc7, 0x40, 0xa7, 0x30, 0x1a, 0x8d, 0x48, 0x53, 0xe4, 0xf4, 0xe1, 0xd1, 0x15, 0x16,
+  0x94, 0x81, 0x5b, 0xfa, 0x2e, 0xb5, 0xc9, 0x33, 0x0f, 0xf5, 0x8d, 0xa1, 0x8f, 0x08, 0xf6, 0x89,
+  0xce, 0x02, 0x51, 0xab, 0x9c, 0x5f, 0x5e, 0x93, 0xad, 0xc3, 0x21, 0xca, 0xfc, 0xe4, 0xe5, 0x9c,
+  0xf3, 0x71, 0xb6, 0xca, 0x3d, 0x92, 0x3f, 0x6c, 0x8d, 0x2d, 0x2a, 0xb6, 0x05, 0x8f, 0x97, 0x3f,
+  0x82, 0x83, 0xfb, 0x39, 0x8c, 0xaf, 0xc6, 0xe1, 0xa5, 0x8b, 0x05, 0xf9, 0xbe, 0xad, 0x4b, 0x05,
+  0xe5, 0x94, 0xf1, 0x36, 0x73, 0x27, 0x58, 0xdd, 0x42, 0x66, 0xd3, 0x85, 0xfa, 0x95, 0x8b, 0x94,
+  0xc8, 0xbf, 0x34, 0x73, 0x6b, 0x5a, 0xcc, 0x65, 0x7c, 0x1c, 0x47, 0xc1, 0x69, 0x49, 0xf4, 0x43,
+  0x08, 0x0b, 0xc1, 0x60, 0xcd, 0xa3, 0x82, 0x8d, 0x04, 0xb9, 0x15, 0xba, 0xf2, 0xcf, 0x72, 0xd7,
+  0x55, 0x91, 0x0c, 0x80, 0x40, 0xc0, 0x9d, 0xc8, 0xaa, 0xe4, 0xdd, 0xd8, 0x9d, 0x06, 0xe0, 0x46,
+  0xf2, 0xdf, 0x71, 0xde, 0x9d, 0xcc, 0x4e, 0xbd, 0xaf, 0xfb, 0xc4, 0x92, 0xae, 0x50, 0x0a, 0x5b,
+  0x35, 0x8c, 0xd7, 0x84, 0x6b, 0x3a, 0x4a, 0xee, 0x3b, 0x0f, 0x9d, 0x47, 0x0e, 0xae, 0x8d, 0x13,
+  0xb3, 0x24, 0x4e, 0xd4, 0x04, 0x97, 0x38, 0x10, 0xd1, 0x52, 0x22, 0x9f, 0x81, 0xab, 0x15, 0x55,
+  0x5c, 0x23, 0x8f, 0xae, 0x30, 0xba, 0x0c, 0x17, 0x43, 0x6d, 0x9a, 0x46, 0x41, 0x9f, 0x6a, 0xf4,
+  0x26, 0x42, 0xa8, 0x39, 0x73, 0xed, 0xd3, 0x52, 0x3b, 0x1f, 0x1d, 0x1d, 0xd5, 0x1a, 0xd9, 0x1c,
+  0x1e, 0x80, 0x5f, 0x07, 0x43, 0x53, 0x46, 0xbc, 0xf1, 0x78, 0x4e, 0xc0, 0x9b, 0x49, 0xc1, 0x23,
+  0x23, 0x30, 0xd4, 0xfe, 0xf5, 0xd7, 0xbf, 0xfc, 0xfb, 0x1f, 0x7f, 0xd4, 0x4a, 0xf9, 0xe5, 0x31,
+  0x14, 0xaf, 0x6f, 0xf7, 0xa0, 0xe1, 0x92, 0x58, 0xd7, 0x12, 0xba, 0xa4, 0x51, 0xd7, 0xb9, 0xb5,
+  0x12, 0xd9, 0x16, 0x9c, 0xe6, 0x14, 0x26, 0x9f, 0xe8, 0x20, 0xd9, 0x5a, 0x46, 0x19, 0x20, 0xb4,
+  0x1b, 0xac, 0x3c, 0x90, 0x92, 0x93, 0x35, 0xc1, 0xa2, 0x8d, 0x03, 0xc1, 0x74, 0x87, 0x8a, 0xae,
+  0x4c, 0x0c, 0x00, 0x64, 0x6d, 0x73, 0x08, 0x9c, 0x74, 0x91, 0xe9, 0xf0, 0x4e, 0x2e, 0x1e, 0x17,
+  0x78, 0x5d, 0xa6, 0xd6, 0x48, 0x0e, 0xc1, 0xd6, 0x07, 0x49, 0x21, 0x95, 0x5d, 0x25, 0xc4, 0x81,
+  0x06, 0xca, 0x04, 0x82, 0x59, 0x1b, 0x08, 0xfb, 0xd3, 0xc5, 0xc3, 0x02, 0x36, 0x48, 0x84, 0xa2,
+  0x21, 0x4e, 0x63, 0xd7, 0x05, 0x8c, 0x3e, 0x0a, 0x31, 0x3a, 0xe7, 0x97, 0x01, 0xf7, 0xa5, 0x63,
+  0xae, 0x19, 0x6d, 0x90, 0xd9, 0xd2, 0x5a, 0x18, 0x2f, 0xd9, 0xa6, 0x36, 0xc7, 0xdd, 0x27, 0x8f,
+  0x88, 0x45, 0x9c, 0x12, 0xb6, 0x4a, 0xc0, 0xba, 0x80, 0xd5, 0xd9, 0x6c, 0x27, 0xc3, 0xf8, 0xe1,
+  0xa1, 0xe0, 0x94, 0x35, 0x1a, 0xf5, 0xd6, 0x81, 0x78, 0x2d, 0xb6, 0x6b, 0xa8, 0xf0, 0xe2, 0x11,
+  0xed, 0x4d, 0x8e, 0xff, 0x28, 0xeb, 0x15, 0x61, 0x29, 0xae, 0x3d, 0x06, 0xfd, 0x0a, 0x47, 0x2a,
+  0x0d, 0x88, 0x5a, 0x0d, 0x2b, 0x07, 0xb1, 0xa4, 0x57, 0xe8, 0x55, 0x59, 0x60, 0xbf, 0x54, 0x2e,
+  0x9e, 0x13, 0x37, 0x1f, 0xc1, 0x75, 0x2b, 0xa6, 0x51, 0x2c, 0x8f, 0x61, 0x95, 0x20, 0x25, 0x3d,
+  0x3b, 0x93, 0x12, 0x1b, 0xaa, 0xdb, 0xb0, 0x6f, 0x88, 0xeb, 0x96, 0xeb, 0xf8, 0xd8, 0x18, 0xe6,
+  0xd7, 0xdf, 0x15, 0x2b, 0xe5, 0x98, 0x0e, 0x2c, 0xec, 0xe0, 0xdc, 0xb6, 0xed, 0xda, 0x88, 0x38,
+  0x3e, 0x2c, 0xa6, 0xe7, 0x01, 0x00, 0xb0, 0x67, 0xac, 0xc0, 0xa9, 0xf5, 0x02, 0x4e, 0x45, 0x36,
+  0x0e, 0x53, 0xca, 0xa8, 0x8a, 0x39, 0x0f, 0x6a, 0xfd, 0xea, 0x18, 0x2e, 0x8e, 0xd6, 0xe5, 0xfe,
+  0x83, 0xe2, 0x72, 0x09, 0x73, 0x2a, 0xea, 0x8a, 0x93, 0x93, 0x93, 0x4a, 0xfb, 0xf7, 0x8d, 0x47,
+  0x69, 0x0b, 0x94, 0x51, 0x56, 0x56, 0x2c, 0x85, 0xee, 0x0c, 0x7e, 0x0e, 0xf7, 0xe9, 0x3a, 0x4d,
+  0xa7, 0xcc, 0x65, 0x13, 0x0c, 0x9d, 0xcb, 0x1e, 0xa9, 0x36, 0x43, 0x16, 0x90, 0x2e, 0x16, 0x75,
+  0x38, 0x1c, 0xd6, 0xa4, 0xe4, 0x61, 0xbf, 0xdf, 0x9c, 0xc5, 0x34, 0x56, 0x78, 0xc1, 0x6a, 0x4e,
+  0x78, 0x15, 0x52, 0x14, 0xeb, 0xe3, 0x1d, 0xa4, 0x0f, 0xaa, 0x1c, 0x65, 0xd0, 0xdc, 0x8b, 0x0b,
+  0xd2, 0xd6, 0xc5, 0x6f, 0x1a, 0xf3, 0x23, 0x3a, 0x4a, 0x39, 0x0a, 0xfc, 0xdf, 0x4f, 0xfa, 0xb1,
+  0xc3, 0xac, 0xc0, 0xcf, 0xe9, 0x00, 0xaa, 0x7d, 0xd9, 0xd6, 0x95, 0x7a, 0x7e, 0x6a, 0xf9, 0x86,
+  0xc0, 0x26, 0x45, 0x66, 0xf5, 0x65, 0x42, 0x31, 0xc3, 0xaa, 0xec, 0x5e, 0x09, 0xca, 0x0d, 0xb3,
+  0x7b, 0xb8, 0xf2, 0x47, 0x4b, 0xed, 0xaa, 0xba, 0xfe, 0xd0, 0xf9, 0xbd, 0x16, 0xe4, 0x1b, 0x26,
+  0xff, 0x7d, 0xfe, 0x58, 0xaf, 0xab, 0xfd, 0x05, 0x80, 0xd3, 0x97, 0xbf, 0x1f, 0xc8, 0x31, 0x0a,
+  0x49, 0x5c, 0x3d, 0x2e, 0xc4, 0x65, 0x36, 0x1d, 0x3f, 0xfc, 0xd8, 0xd9, 0x38, 0xc5, 0xdb, 0xc1,
+  0xa9, 0xb8, 0x34, 0xdd, 0x1e, 0xae, 0x80, 0xb1, 0x4a, 0x64, 0xc4, 0x46, 0x0f, 0xca, 0x59, 0xa8,
+  0xc9, 0x32, 0x35, 0x4d, 0x4b, 0x19, 0x1f, 0x73, 0x91, 0xef, 0xf4, 0x76, 0x4e, 0x0e, 0x29, 0xa0,
+  0xa4, 0xd1, 0xab, 0x49, 0x8d, 0x07, 0xe0, 0x9c, 0x61, 0x1e, 0xda, 0x6d, 0x7d, 0x80, 0xe0, 0x50,
+  0x0d, 0x72, 0xaa, 0x5c, 0x0d, 0xd6, 0x6b, 0xc2, 0xad, 0xc2, 0x34, 0x97, 0x08, 0x58, 0x41, 0xf7,
+  0xe5, 0xbe, 0x81, 0x52, 0xc4, 0x3e, 0xb0, 0x01, 0x25, 0xea, 0x6b, 0x4e, 0xc1, 0x4f, 0xb7, 0x35,
+  0xb1, 0xf3, 0x9e, 0xdb, 0x65, 0x91, 0xd1, 0x4b, 0x70, 0xa5, 0x32, 0x6f, 0x15, 0x0b, 0x6e, 0x65,
+  0x53, 0x55, 0x71, 0x9b, 0xfd, 0x01, 0xf4, 0x56, 0x83, 0x51, 0x17, 0x0d, 0x8e, 0x8e, 0xbb, 0xa0,
+  0xb1, 0xe3, 0x4e, 0x63, 0x21, 0x4b, 0x61, 0xe2, 0x1d, 0xdb, 0x80, 0x51, 0x84, 0xa4, 0x15, 0x5c,
+  0x8d, 0x0e, 0xe0, 0x0a, 0x43, 0x27, 0xbc, 0x21, 0x8d, 0xd8, 0xea, 0x37, 0x20, 0x0b, 0x9d, 0x35,
+  0xf3, 0xec, 0x7a, 0x9b, 0xde, 0x1f, 0x59, 0x27, 0xc3, 0x13, 0xfb, 0xbd, 0x2d, 0x75, 0x58, 0xe9,
+  0x95, 0xe1, 0x6e, 0x3f, 0x66, 0x0f, 0xf1, 0x68, 0x30, 0x7a, 0xf8, 0x0e, 0x4d, 0x5b, 0xc9, 0xda,
+  0xf2, 0x95, 0xfa, 0xad, 0xa1, 0xc1, 0xde, 0xdc, 0xec, 0x0b, 0x2c, 0x0a, 0x85, 0xc7, 0xbe, 0x8d,
+  0xaf, 0x0c, 0x2c, 0x55, 0x2b, 0x6f, 0x50, 0xb5, 0x77, 0x54, 0x89, 0x4a, 0x19, 0x55, 0xd9, 0xc7,
+  0xc4, 0xb6, 0x71, 0x39, 0xa6, 0x9b, 0xc3, 0xe1, 0xc9, 0xe0, 0xb8, 0x62, 0x27, 0x27, 0x8b, 0x86,
+  0x65, 0xdb, 0xa4, 0x2b, 0x62, 0x53, 0x8c, 0xda, 0xf9, 0x2d, 0xda, 0x4e, 0x4e, 0x0f, 0x95, 0x7b,
+  0xcd, 0x7b, 0x36, 0xd9, 0xb2, 0x1b, 0xa1, 0x39, 0x92, 0x75, 0x1b, 0x36, 0x35, 0x3b, 0x33, 0xa6,
+  0xc3, 0x9b, 0x2f, 0x52, 0x5d, 0xeb, 0xc5, 0xed, 0xa6, 0x6e, 0x53, 0x1e, 0xee, 0x56, 0x8d, 0x51,
+  0xb8, 0x46, 0xfd, 0x36, 0xeb, 0xa4, 0x17, 0x9d, 0xa5, 0x4c, 0x7a, 0xe1, 0x81, 0xcf, 0x44, 0x1e,
+  0x6d, 0x44, 0xc7, 0x2c, 0x36, 0xdd, 0x20, 0xcb, 0xc5, 0xbe, 0x0f, 0xad, 0x7f, 0xac, 0x31, 0x6d,
+  0x77, 0xec, 0x32, 0x59, 0x9a, 0xb3, 0xff, 0xfc, 0xed, 0xf7, 0x7f, 0x40, 0x95, 0x67, 0x36, 0x30,
+  0xa1, 0x68, 0xa5, 0x89, 0xf2, 0xef, 0x15, 0x11, 0x4b, 0x66, 0x4f, 0xb5, 0x8b, 0x17, 0x97, 0x57,
+  0x1a, 0xc2, 0x8a, 0xe5, 0xa9, 0xd6, 0xf3, 0xf1, 0x86, 0x68, 0x88, 0xc2, 0x80, 0x0f, 0x19, 0x02,
+  0xec, 0xe0, 0x3f, 0x85, 0xd9, 0xa9, 0x45, 0xf3, 0x8c, 0x45, 0x7b, 0x73, 0xb9, 0x19, 0x15, 0xb3,
+  0xc2, 0x1d, 0x3c, 0x6d, 0x76, 0x45, 0x57, 0xe4, 0x0e, 0xd8, 0xf5, 0x27, 0x3d, 0x98, 0x54, 0xff,
+  0xaa, 0xec, 0x12, 0xb5, 0xd9, 0x99, 0x87, 0xe7, 0x2e, 0x14, 0x0b, 0xea, 0x2d, 0xc4, 0x19, 0x84,
+  0x17, 0x81, 0xaa, 0x02, 0x89, 0x25, 0x41, 0xca, 0xf9, 0x91, 0xbf, 0x64, 0x37, 0x9e, 0x81, 0x2e,
+  0x15, 0x66, 0xf8, 0x48, 0x36, 0xbd, 0xd0, 0x96, 0x61, 0xef, 0x1a, 0x05, 0x3e, 0x51, 0xf3, 0x22,
+  0x47, 0x46, 0x76, 0xc0, 0xd5, 0x49, 0x00, 0x82, 0xaa, 0x83, 0xdd, 0x18, 0x0d, 0x78, 0xc8, 0x3a,
+  0x57, 0xa8, 0x1f, 0x11, 0xcb, 0x50, 0x26, 0x7a, 0x91, 0x64, 0xc9, 0xa3, 0x0f, 0xab, 0xd3, 0x27,
+  0x91, 0x74, 0x97, 0x91, 0xdd, 0x1a, 0x88, 0x95, 0xea, 0x9e, 0x4a, 0xd6, 0x52, 0xb3, 0xc3, 0xd2,
+  0x0c, 0x3c, 0x46, 0xce, 0x16, 0x44, 0x56, 0x20, 0xdb, 0xdd, 0x5a, 0xcf, 0xe2, 0x47, 0xa8, 0xdd,
+  0xd7, 0xcd, 0x61, 0x67, 0xd2, 0x53, 0xf3, 0x2b, 0x68, 0xa9, 0xe5, 0x50, 0xa6, 0x41, 0x53, 0x9a,
+  0xdc, 0x11, 0x8e, 0x4e, 0x32, 0x53, 0x0f, 0x56, 0x14, 0xbc, 0xb2, 0xaf, 0xc9, 0x53, 0x9f, 0xa9,
+  0x66, 0x0e, 0x35, 0xc4, 0xc9, 0xef, 0x02, 0x08, 0x31, 0xbb, 0x91, 0xd2, 0xdf, 0x4f, 0x60, 0x69,
+  0xe1, 0x48, 0xd2, 0x27, 0x91, 0xcb, 0x84, 0xae, 0x8b, 0x62, 0xf9, 0xe3, 0xc7, 0xa8, 0x1d, 0xa6,
+  0x2a, 0x1f, 0x12, 0xbb, 0x3e, 0xea, 0xbf, 0xa3, 0x1e, 0xca, 0xd6, 0x8b, 0x34, 0x52, 0x3a, 0xa4,
+  0x74, 0x63, 0x46, 0xba, 0x19, 0xf5, 0x0f, 0xd4, 0xcd, 0xc7, 0x77, 0x48, 0x32, 0x0f, 0x16, 0x87,
+  0xb8, 0x63, 0x66, 0x67, 0x4b, 0x6b, 0xa0, 0xbc, 0x64, 0x3f, 0x54, 0xa9, 0xcf, 0x96, 0xeb, 0xc5,
+  0x0a, 0x0b, 0x6f, 0xf6, 0xdb, 0x38, 0x9a, 0x17, 0xc2, 0x0b, 0x0a, 0x59, 0x3e, 0x67, 0x0b, 0xc8,
+  0xb5, 0x8b, 0x4a, 0x23, 0x7e, 0x0a, 0x65, 0x2a, 0xb7, 0x93, 0x50, 0x8c, 0x45, 0x03, 0x4d, 0xa6,
+  0xf2, 0x54, 0x95, 0x0e, 0x0a, 0xb3, 0x6b, 0x94, 0x5e, 0x50, 0x7c, 0xd8, 0xc2, 0x29, 0xad, 0x3b,
+  0x8a, 0xa7, 0xc1, 0x71, 0xac, 0xf8, 0xf0, 0x5e, 0x43, 0x1b, 0xec, 0x06, 0x70, 0x0b, 0x03, 0x35,
+  0x34, 0x53, 0x86, 0x48, 0xe8, 0xcc, 0x06, 0xc7, 0xfa, 0x37, 0x2c, 0xe0, 0xf5, 0x31, 0x54, 0xae,
+  0x83, 0x8f, 0x20, 0x99, 0x39, 0xa8, 0x90, 0x0c, 0x06, 0x0e, 0x91, 0x4c, 0x4e, 0x37, 0x07, 0x4a,
+  0x32, 0xd4, 0xfe, 0xea, 0x79, 0xef, 0xe2, 0x79, 0xe7, 0x5d, 0x24, 0xfc, 0x14, 0xbe, 0x77, 0x8e,
+  0xb7, 0x2c, 0xf8, 0xcc, 0xdc, 0xce, 0x55, 0x3c, 0xbd, 0x54, 0x75, 0x40, 0x6c, 0xa0, 0xf0, 0x59,
+  0x62, 0xa0, 0xb0, 0x48, 0x68, 0x68, 0xa4, 0x0c, 0xbd, 0x59, 0xf8, 0x89, 0x52, 0x65, 0xca, 0x27,
+  0xf6, 0xc5, 0x90, 0x3d, 0x59, 0xe1, 0xd9, 0x15, 0xd2, 0xde, 0xa9, 0xb1, 0x43, 0x84, 0x0d, 0xa9,
+  0xcd, 0x2e, 0xa9, 0x4d, 0xd0, 0x1c, 0xea, 0x06, 0xf8, 0xfc, 0x7f, 0xf1, 0xc8, 0xa7, 0x2e, 0x21,
+  0x02, 0x5d, 0x6e, 0x3d, 0xeb, 0x33, 0x03, 0x43, 0xc9, 0xd7, 0x0b, 0xc7, 0x49, 0x20, 0x43, 0xde,
+  0x27, 0x26, 0x62, 0x30, 0xd0, 0x10, 0x32, 0x62, 0x3a, 0x33, 0xf8, 0xf3, 0xe9, 0x81, 0x50, 0x72,
+  0x73, 0x0e, 0xdd, 0x89, 0x2c, 0x54, 0xca, 0x04, 0x73, 0xc3, 0xb1, 0x03, 0x64, 0x8b, 0xa8, 0xcd,
+  0xc2, 0xcf, 0xcf, 0x43, 0xc2, 0xa7, 0xcc, 0x85, 0x76, 0xa0, 0x4a, 0x46, 0x27, 0x1e, 0x3d, 0x40,
+  0xca, 0x84, 0xe2, 0x2c, 0xbe, 0xfa, 0x5f, 0x05, 0x58, 0x78, 0x2c, 0x18, 0x09, 0xea, 0x07, 0xf3,
+  0x15, 0x95, 0x5f, 0x0b, 0x0c, 0x35, 0x25, 0xb7, 0x43, 0x53, 0x5b, 0x4a, 0x1a, 0xf4, 0x90, 0x7f,
+  0xfa, 0x27, 0xba, 0x84, 0xc6, 0x2f, 0x55, 0xac, 0x85, 0x04, 0x52, 0xbd, 0x66, 0x4f, 0xa6, 0xb1,
+  0x43, 0xbb, 0xc9, 0x1b, 0xea, 0xd0, 0x7c, 0xef, 0xd8, 0x84, 0xb5, 0x64, 0xe3, 0x47, 0x32, 0xf7,
+  0xe7, 0xbf, 0xa3, 0xdf, 0xd0, 0xa7, 0x14, 0x3d, 0x66, 0x9e, 0x43, 0x17, 0x51, 0xf5, 0x5b, 0xcf,
+  0x61, 0x4a, 0x3f, 0x13, 0xdf, 0xe2, 0x74, 0x2d, 0x76, 0xf3, 0x7a, 0x3d, 0xf4, 0x9d, 0x34, 0xa9,
+  0x8f, 0x30, 0x27, 0xc8, 0xa1, 0xae, 0x6c, 0x2b, 0xa1, 0x93, 0x54, 0x5f, 0xe1, 0x92, 0x6d, 0xe2,
+  0xaf, 0x2f, 0x5f, 0x7c, 0x8b, 0xbe, 0xba, 0x78, 0x86, 0x7c, 0x06, 0xf7, 0xd4, 0x47, 0x6b, 0xbc,
+  0x20, 0xc8, 0xc2, 0xb2, 0x5f, 0x84, 0x0f, 0x28, 0x3a, 0xed, 0x34, 0xb1, 0x17, 0xd0, 0x75, 0x73,
+  0x76, 0x83, 0xd6, 0xd0, 0x83, 0x4a, 0x10, 0x3e, 0x45, 0x54, 0xc0, 0x3b, 0x2e, 0xb6, 0x92, 0x06,
+  0xd5, 0xa5, 0xbe, 0x40, 0x40, 0xa8, 0x30, 0xa0, 0x52, 0x14, 0x48, 0xb3, 0xdb, 0x7a, 0x0a, 0xbc,
+  0xf0, 0x9b, 0x49, 0x92, 0xd2, 0x4b, 0x76, 0xd3, 0x16, 0x77, 0xf9, 0xcd, 0x13, 0x4e, 0x44, 0xc0,
+  0x3d, 0xd4, 0xaa, 0xa9, 0x9c, 0x6b, 0x8a, 0x64, 0x71, 0xd7, 0x42, 0x0f, 0x90, 0xb8, 0x33, 0xa8,
+  0xdc, 0x78, 0x6f, 0x25, 0xfd, 0x45, 0xee, 0x31, 0xdc, 0x15, 0xfc, 0x10, 0x78, 0x31, 0x48, 0xd4,
+  0x86, 0xff, 0x02, 0xb5, 0x50, 0xb4, 0x7f, 0xdf, 0x42, 0x63, 0xd4, 0x6a, 0x75, 0xe4, 0x6b, 0xb3,
+  0x4c, 0xf7, 0x94, 0x23, 0x39, 0x8b, 0x6e, 0xe5, 0x82, 0xf2, 0x41, 0x1c, 0x0a, 0x65, 0x4b, 0xb5,
+  0x4a, 0x7b, 0xa4, 0x48, 0x58, 0x75, 0x38, 0x9f, 0xd4, 0xf9, 0xf2, 0x26, 0x27, 0x52, 0xa1, 0x2f,
+  0x52, 0x3a, 0x5f, 0x32, 0x17, 0xa0, 0x46, 0xa5, 0x92, 0x4a, 0xf1, 0xc2, 0x73, 0x7f, 0x29, 0x5c,
+  0x14, 0xf5, 0x11, 0xe5, 0xf0, 0x79, 0xa8, 0x98, 0x9d, 0xb4, 0xe5, 0x9c, 0x67, 0xfc, 0x3b, 0xbc,
+  0x49, 0x58, 0x8f, 0x8e, 0xe9, 0x35, 0xa4, 0xf2, 0xd8, 0x54, 0x3b, 0xc3, 0xdc, 0xa5, 0xe0, 0x37,
+  0xe0, 0x0e, 0xb1, 0x2b, 0x68, 0xb3, 0x9f, 0xdd, 0x7f, 0x34, 0x1a, 0xf6, 0x4f, 0x13, 0x0f, 0x0f,
+  0x9d, 0xb9, 0x95, 0xde, 0x79, 0x4b, 0x2e, 0x6d, 0x66, 0x05, 0x2b, 0xe2, 0x09, 0x63, 0x41, 0xc4,
+  0x99, 0x4b, 0xe4, 0xe5, 0xd7, 0xdb, 0x67, 0x76, 0xbb, 0x95, 0xec, 0x4e, 0xb4, 0x3a, 0x06, 0xb6,
+  0xed, 0xb3, 0x0d, 0x8c, 0x9c, 0x83, 0x1b, 0x12, 0x8f, 0xf0, 0x76, 0xcb, 0x72, 0xa9, 0x75, 0xdd,
+  0xea, 0xee, 0xdc, 0xad, 0x4d, 0xf2, 0x6e, 0x46, 0x1d, 0xd4, 0xfe, 0x82, 0x18, 0x02, 0x73, 0x20,
+  0x6d, 0x28, 0xfe, 0xe5, 0xfb, 0xf1, 0xd6, 0x9d, 0xdf, 0x6e, 0x45, 0xc2, 0xb4, 0x3a, 0x9d, 0xc8,
+  0x27, 0xb3, 0x3b, 0x5d, 0x1b, 0xcc, 0x55, 0x5c, 0x4c, 0x51, 0x42, 0x65, 0x0d, 0x11, 0xe7, 0x89,
+  0x6f, 0x99, 0x9d, 0xdb, 0x32, 0x96, 0x6b, 0xc1, 0x54, 0x63, 0xcd, 0xc9, 0x86, 0xb2, 0xc0, 0x8f,
+  0x24, 0xb9, 0xa4, 0x73, 0x17, 0xd0, 0xa8, 0x83, 0xd4, 0x58, 0xf2, 0xae, 0x01, 0xab, 0x13, 0x2e,
+  0xbe, 0x56, 0xdf, 0x02, 0x93, 0xef, 0x75, 0x51, 0xcd, 0xcb, 0x29, 0xb5, 0xc1, 0x75, 0x72, 0x73,
+  0x01, 0xd1, 0x4e, 0x7d, 0x62, 0x60, 0xd7, 0x6d, 0xbf, 0xce, 0x9e, 0xd1, 0x10, 0x61, 0x2d, 0xdb,
+  0xad, 0x1e, 0x5e, 0xd3, 0x5e, 0xbc, 0x07, 0x06, 0x4a, 0x84, 0x70, 0xf5, 0xda, 0x3b, 0x7d, 0x71,
+  0xd0, 0x57, 0x1c, 0x8a, 0xdc, 0xf8, 0xc1, 0x67, 0x5e, 0xbb, 0x73, 0x0a, 0x4b, 0x74, 0x2b, 0x69,
+  0xa5, 0x2d, 0xd2, 0x90, 0x58, 0x42, 0xeb, 0x4d, 0xe1, 0x15, 0x1b, 0x0b, 0x9c, 0x37, 0x99, 0xd4,
+  0x78, 0xcc, 0x31, 0xa8, 0x5d, 0x4e, 0x79, 0xdd, 0x7f, 0x53, 0xb4, 0x8a, 0xfa, 0xaa, 0xf9, 0x14,
+  0xdc, 0x38, 0xb7, 0xcf, 0x2b, 0xe7, 0x9b, 0x6f, 0x8c, 0x84, 0x51, 0x03, 0x14, 0x7c, 0x06, 0x78,
+  0x97, 0x5a, 0xb6, 0x08, 0x47, 0xea, 0x5b, 0x46, 0x92, 0xe0, 0x83, 0x69, 0x1a, 0xb4, 0x72, 0xbb,
+  0x9e, 0xb9, 0xfb, 0x46, 0x6e, 0x4b, 0x3d, 0xf0, 0xd5, 0x6f, 0xae, 0x9e, 0x9f, 0x03, 0xaf, 0x72,
+  0x85, 0x86, 0x24, 0x92, 0xcd, 0x23, 0x20, 0xa1, 0xa2, 0x18, 0x5e, 0x8f, 0xb5, 0x62, 0x24, 0x83,
+  0x07, 0xf0, 0x93, 0xdb, 0x77, 0x29, 0x23, 0x5b, 0x32, 0xad, 0xe1, 0x02, 0x6a, 0xff, 0x01, 0x48,
+  0xc6, 0x87, 0xa1, 0x29, 0xa2, 0x6a, 0xa8, 0x19, 0x99, 0xe4, 0x9d, 0xc0, 0x27, 0xe6, 0x40, 0xf5,
+  0x98, 0x00, 0x62, 0x71, 0xe3, 0xa9, 0x30, 0x2b, 0xee, 0xaf, 0x33, 0x6b, 0x09, 0x1e, 0x90, 0x03,
+  0x57, 0x08, 0x7b, 0x07, 0x34, 0x9d, 0x82, 0x03, 0xa9, 0x9e, 0xa3, 0x25, 0x97, 0x4a, 0x75, 0x14,
+  0x6a, 0xb5, 0x74, 0x3b, 0xf5, 0x8e, 0x2b, 0xfe, 0x88, 0xc2, 0xb2, 0x52, 0xf2, 0xbe, 0x2b, 0x19,
+  0x25, 0x68, 0x45, 0xb5, 0x54, 0x3c, 0x10, 0xd7, 0x56, 0x2d, 0xf4, 0xf6, 0x75, 0xc2, 0xa6, 0x1a,
+  0x79, 0x83, 0x7e, 0xfa, 0x29, 0x9a, 0x04, 0x75, 0x74, 0x0d, 0x1f, 0x19, 0x68, 0x80, 0x9c, 0x7e,
+  0xc1, 0x20, 0x61, 0xcb, 0x04, 0xad, 0x8a, 0x1b, 0xec, 0x23, 0xb9, 0xb5, 0x0e, 0xd6, 0x95, 0x27,
+  0x30, 0xe4, 0x56, 0xa8, 0xff, 0x7e, 0x70, 0xaa, 0x26, 0x58, 0x72, 0xa3, 0x1d, 0x2a, 0x04, 0xee,
+  0x13, 0x99, 0xdf, 0x25, 0x92, 0xab, 0x6c, 0x93, 0xa6, 0x06, 0x78, 0x25, 0x80, 0x79, 0xc4, 0x1c,
+  0xe4, 0x0b, 0xc6, 0x81, 0x3f, 0x44, 0x36, 0x84, 0x6f, 0xa1, 0xf8, 0x20, 0xae, 0x2d, 0xc9, 0x63,
+  0xb0, 0x3a, 0xd0, 0x90, 0x3d, 0x27, 0x20, 0xa5, 0x52, 0xc7, 0x7e, 0x88, 0x4f, 0x6f, 0xd0, 0x97,
+  0xa2, 0x7c, 0x58, 0x5c, 0xd5, 0xc3, 0x3c, 0x51, 0xb8, 0x09, 0xaf, 0x3d, 0x21, 0x0e, 0x0e, 0x5c,
+  0xd1, 0xce, 0x45, 0x6a, 0x8c, 0x60, 0xf2, 0x5c, 0x00, 0x28, 0x15, 0x63, 0x3f, 0xac, 0xfc, 0xc0,
+  0x16, 0xb2, 0xf4, 0x6b, 0x75, 0x8b, 0xd8, 0xa0, 0xcc, 0xe6, 0x8f, 0x01, 0xe1, 0x5a, 0x8f, 0xc3,
+  0xef, 0xe8, 0xea, 0x57, 0x90, 0x1b, 0x5b, 0xf0, 0x8a, 0xd4, 0x65, 0x4f, 0xa9, 0x15, 0x6c, 0x57,
+  0x7c, 0x55, 0x6a, 0x79, 0x8c, 0x3c, 0x72, 0x83, 0x5e, 0xbd, 0x3c, 0xbf, 0x24, 0x98, 0x5b, 0xcb,
+  0x0b, 0x50, 0xd2, 0xca, 0x6f, 0xcb, 0x67, 0x52, 0xec, 0x27, 0x00, 0x59, 0xed, 0x38, 0xbd, 0x74,
+  0x00, 0x24, 0xd9, 0xa5, 0x90, 0xfa, 0x6d, 0x77, 0x72, 0xf0, 0x93, 0x87, 0x4f, 0x09, 0xb8, 0x60,
+  0x39, 0x15, 0xa9, 0x06, 0x27, 0x2e, 0xc3, 0x76, 0x08, 0xb9, 0x59, 0x9f, 0x88, 0x4e, 0x68, 0xa2,
+  0x0a, 0x12, 0x32, 0xb2, 0x3a, 0x9b, 0x99, 0xf4, 0xc2, 0xff, 0xb3, 0xf3, 0x5f, 0xb3, 0x89, 0xed,
+  0xc0, 0xc4, 0x33, 0x00, 0x00,
+};
+
+#endif
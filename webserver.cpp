@@ -1,397 +1,396 @@
 #include "webserver.h"
-#include <WiFiManager.h>
-#include <EEPROM.h>
 #include "config.h"
+#include "webassets.h"
+#include "formparser.h"
+#include "debuglog.h"
+#include <stdarg.h>
 
-WebServerManager::WebServerManager(ESP8266WebServer* srv, TimezoneManager* tzm, Settings* sett, DisplayManager* disp) {
+static_assert(8 + LOG_QUEUE_SIZE * sizeof(LogRecord) <= RESPONSE_BUFFER_SIZE, "/log dump must fit the response buffer");
+static_assert(TZ_JSON_MAX <= RESPONSE_BUFFER_SIZE, "/api/timezones must fit the response buffer");
+
+static const char* COLLECTED_HEADERS[] = { "If-None-Match" };
+
+static const char SSE_HEADERS[] PROGMEM =
+  "HTTP/1.1 200 OK\r\n"
+  "Content-Type: text/event-stream\r\n"
+  "Cache-Control: no-cache\r\n"
+  "Connection: keep-alive\r\n"
+  "\r\n";
+
+static const char HTML_WIFI_PORTAL[] PROGMEM =
+  "<html><body><h1>WiFi Configuration Portal Starting...</h1>"
+  "<p>Please connect to the '%s' network and open http://192.168.4.1:%u to configure WiFi.</p>"
+  "<p>This page will close automatically.</p>"
+  "<script>setTimeout(function(){window.location.href='/';}, 3000);</script></body></html>";
+
+// Stack buffer for the formatted portal page: the template, the AP name and a port
+static const size_t PORTAL_PAGE_SIZE = 384;
+static_assert(sizeof(HTML_WIFI_PORTAL) + sizeof(WIFI_CONFIG_AP_NAME) + 5 <= PORTAL_PAGE_SIZE, "portal page must fit its buffer");
+
+WebServerManager::WebServerManager(ESP8266WebServer* srv, TimezoneManager* tzm, Settings* sett, SettingsStore* store, SettingsExchange* exchange, DisplayManager* disp, WifiPortal* portal, NtpClock* clock, FleetSync* fleetSync, EventStream* evts, Scheduler* sched) {
   server = srv;
   tzManager = tzm;
   settings = sett;
+  settingsStore = store;
+  settingsExchange = exchange;
   displayManager = disp;
+  wifiPortal = portal;
+  ntpClock = clock;
+  fleet = fleetSync;
+  events = evts;
+  scheduler = sched;
+  metricsLength = 0;
+  requests = 0;
 }
 
 void WebServerManager::begin() {
-  server->on("/", [this]() { this->handleRoot(); });
-  server->on("/save", HTTP_POST, [this]() { this->handleSave(); });
-  server->on("/wifi", HTTP_POST, [this]() { this->handleWifiPortal(); });
+  on("/", HTTP_GET, &WebServerManager::handleRoot);
+  on("/api/state", HTTP_GET, &WebServerManager::handleState);
+  on("/api/settings", HTTP_GET, &WebServerManager::handleSettings);
+  on("/api/timezones", HTTP_GET, &WebServerManager::handleTimezones);
+  on("/events", HTTP_GET, &WebServerManager::handleEvents);
+  on("/log", HTTP_GET, &WebServerManager::handleLog);
+#if METRICS_ENABLED
+  on("/metrics", HTTP_GET, &WebServerManager::handleMetrics);
+#endif
+  on("/save", HTTP_POST, &WebServerManager::handleSave);
+  on("/wifi", HTTP_POST, &WebServerManager::handleWifiPortal);
+  server->collectHeaders(COLLECTED_HEADERS, 1);
   server->begin();
 }
 
-void WebServerManager::handleClient() {
+void WebServerManager::on(const char* uri, HTTPMethod method, void (WebServerManager::*handler)()) {
+  server->on(uri, method, [this, handler]() {
+    requests++;
+    (this->*handler)();
+  });
+}
+
+bool WebServerManager::handleClient() {
+  // ESP8266WebServer takes at most one request per call
+  unsigned long before = requests;
   server->handleClient();
+  return requests != before;
 }
 
-String WebServerManager::generateHTML() {
-  String html = R"(
-<!DOCTYPE html>
-<html lang="en">
-<head>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>Multi-Zone Matrix Clock</title>
-    <style>
-        * {
-            margin: 0;
-            padding: 0;
-            box-sizing: border-box;
-        }
-        
-        body {
-            font-family: 'Segoe UI', Tahoma, Geneva, Verdana, sans-serif;
-            background: linear-gradient(135deg, #667eea 0%, #764ba2 100%);
-            min-height: 100vh;
-            padding: 20px;
-            display: flex;
-            justify-content: center;
-            align-items: center;
-        }
-        
-        .container {
-            background: white;
-            border-radius: 20px;
-            box-shadow: 0 20px 60px rgba(0,0,0,0.3);
-            padding: 40px;
-            max-width: 600px;
-            width: 100%;
-            animation: slideIn 0.5s ease-out;
-        }
-        
-        @keyframes slideIn {
-            from {
-                opacity: 0;
-                transform: translateY(-20px);
-            }
-            to {
-                opacity: 1;
-                transform: translateY(0);
-            }
-        }
-        
-        h1 {
-            color: #667eea;
-            margin-bottom: 30px;
-            text-align: center;
-            font-size: 2em;
-            text-shadow: 2px 2px 4px rgba(0,0,0,0.1);
-        }
-        
-        .section {
-            margin-bottom: 30px;
-            padding: 20px;
-            background: #f8f9fa;
-            border-radius: 10px;
-            border-left: 4px solid #667eea;
-        }
-        
-        .section-title {
-            font-size: 1.2em;
-            font-weight: bold;
-            color: #333;
-            margin-bottom: 15px;
-            display: flex;
-            align-items: center;
-        }
-        
-        .section-title::before {
-            content: "⚙️";
-            margin-right: 10px;
-        }
-        
-        .checkbox-group {
-            display: grid;
-            grid-template-columns: repeat(auto-fit, minmax(150px, 1fr));
-            gap: 15px;
-            margin-top: 10px;
-        }
-        
-        .checkbox-item {
-            display: flex;
-            align-items: center;
-            padding: 10px;
-            background: white;
-            border-radius: 8px;
-            transition: all 0.3s ease;
-            cursor: pointer;
-        }
-        
-        .checkbox-item:hover {
-            background: #e9ecef;
-            transform: translateY(-2px);
-            box-shadow: 0 4px 8px rgba(0,0,0,0.1);
-        }
-        
-        .checkbox-item input[type="checkbox"] {
-            width: 20px;
-            height: 20px;
-            margin-right: 10px;
-            cursor: pointer;
-            accent-color: #667eea;
-        }
-        
-        .checkbox-item label {
-            cursor: pointer;
-            font-size: 1em;
-            color: #333;
-            flex: 1;
-        }
-        
-        .input-group {
-            margin-top: 15px;
-        }
-        
-        .input-group label {
-            display: block;
-            margin-bottom: 8px;
-            color: #555;
-            font-weight: 500;
-        }
-        
-        .input-group input[type="number"] {
-            width: 100%;
-            padding: 12px;
-            border: 2px solid #ddd;
-            border-radius: 8px;
-            font-size: 1em;
-            transition: border-color 0.3s;
-        }
-        
-        .input-group input[type="number"]:focus {
-            outline: none;
-            border-color: #667eea;
-        }
-        
-        .radio-group {
-            display: flex;
-            gap: 20px;
-            margin-top: 10px;
-        }
-        
-        .radio-item {
-            display: flex;
-            align-items: center;
-            padding: 12px 20px;
-            background: white;
-            border-radius: 8px;
-            cursor: pointer;
-            transition: all 0.3s ease;
-            border: 2px solid #ddd;
-        }
-        
-        .radio-item:hover {
-            background: #f0f0f0;
-            border-color: #667eea;
-        }
-        
-        .radio-item input[type="radio"] {
-            margin-right: 8px;
-            cursor: pointer;
-            accent-color: #667eea;
-        }
-        
-        .radio-item label {
-            cursor: pointer;
-            color: #333;
-        }
-        
-        .radio-item input[type="radio"]:checked + label {
-            color: #667eea;
-            font-weight: bold;
-        }
-        
-        .btn {
-            padding: 15px 30px;
-            border: none;
-            border-radius: 8px;
-            font-size: 1.1em;
-            font-weight: bold;
-            cursor: pointer;
-            transition: all 0.3s ease;
-            text-transform: uppercase;
-            letter-spacing: 1px;
-        }
-        
-        .btn-primary {
-            background: linear-gradient(135deg, #667eea 0%, #764ba2 100%);
-            color: white;
-            width: 100%;
-            box-shadow: 0 4px 15px rgba(102, 126, 234, 0.4);
-        }
-        
-        .btn-primary:hover {
-            transform: translateY(-2px);
-            box-shadow: 0 6px 20px rgba(102, 126, 234, 0.6);
-        }
-        
-        .btn-primary:active {
-            transform: translateY(0);
-        }
-        
-        .btn-secondary {
-            background: #6c757d;
-            color: white;
-            width: 100%;
-            margin-top: 15px;
-        }
-        
-        .btn-secondary:hover {
-            background: #5a6268;
-            transform: translateY(-2px);
-        }
-        
-        form {
-            margin-bottom: 20px;
-        }
-        
-        .status {
-            text-align: center;
-            padding: 15px;
-            margin-top: 20px;
-            border-radius: 8px;
-            background: #d4edda;
-            color: #155724;
-            display: none;
-        }
-        
-        @media (max-width: 600px) {
-            .container {
-                padding: 20px;
-            }
-            
-            .checkbox-group {
-                grid-template-columns: 1fr;
-            }
-            
-            .radio-group {
-                flex-direction: column;
-            }
-        }
-    </style>
-</head>
-<body>
-    <div class="container">
-        <h1>🌍 Multi-Zone Matrix Clock</h1>
-        
-        <form method="POST" action="/save">
-            <div class="section">
-                <div class="section-title">Timezones</div>
-                <div class="checkbox-group">
-)";
+bool WebServerManager::notModified(const char* etag) {
+  if (server->header("If-None-Match") != etag) return false;
+  server->sendHeader("ETag", etag);
+  server->send(304, "text/plain", "");
+  return true;
+}
 
-  // Add timezone checkboxes
-  for (int i = 0; i < TZ_COUNT; i++) {
-    const char* tzName = tzManager->getTimezoneName(i);
-    if (strlen(tzName) > 0) {
-      html += "                    <div class=\"checkbox-item\">\n";
-      html += "                        <input type=\"checkbox\" id=\"tz" + String(i) + "\" name=\"tz" + String(i) + "\"";
-      if (tzManager->tzEnabled[i]) html += " checked";
-      html += ">\n";
-      html += "                        <label for=\"tz" + String(i) + "\">" + String(tzName) + "</label>\n";
-      html += "                    </div>\n";
-    }
+void WebServerManager::handleRoot() {
+  // The page is static; settings are filled in by its script from the API,
+  // so browsers can keep it for a day and revalidate with a 304
+  if (notModified(INDEX_HTML_ETAG)) return;
+  server->sendHeader("ETag", INDEX_HTML_ETAG);
+  server->sendHeader("Cache-Control", "public, max-age=86400");
+  server->sendHeader("Content-Encoding", "gzip");
+  server->send_P(200, PSTR("text/html"), (PGM_P)INDEX_HTML_GZ, INDEX_HTML_GZ_SIZE);
+}
+
+void WebServerManager::sendJson(JsonWriter& json) {
+  if (json.overflowed()) {
+    server->send(500, "text/plain", "Response too large");
+    return;
+  }
+  
+  // FNV-1a over the body; unchanged state hashes to the same tag
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < json.length(); i++) {
+    hash = (hash ^ (uint8_t)json.c_str()[i]) * 16777619u;
+  }
+  char etag[11];
+  snprintf(etag, sizeof(etag), "\"%08x\"", hash);
+  
+  if (notModified(etag)) return;
+  server->sendHeader("ETag", etag);
+  server->sendHeader("Cache-Control", "no-cache");
+  server->send(200, "application/json", json.c_str(), json.length());
+}
+
+void WebServerManager::handleState() {
+  int tz = displayManager->getCurrentTZ();
+  
+  JsonWriter json(responseBuffer, sizeof(responseBuffer));
+  json.beginObject();
+  json.field("api", (long)API_VERSION);
+  json.field("state", displayStateName(displayManager->getState()));
+  json.field("tz", (long)tz);
+  json.field("tzName", tzManager->getTimezoneName(tz));
+  json.field("time", displayManager->getTimeString());
+  json.fieldBool("synced", ntpClock->isSynced());
+  json.fieldBool("following", fleet->isFollowing());
+  json.field("store", storeModeName(settingsStore->getMode()));
+  json.field("storeFailures", (long)settingsStore->getFailedSaves());
+  json.field("utc", (long)ntpClock->now());
+  json.field("events", (long)events->getPublished());
+  json.key("subscribers");
+  json.beginArray();
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    if (!events->isSubscribed(i)) continue;
+    json.beginObject();
+    json.field("slot", (long)i);
+    json.field("pending", (long)events->getPending(i));
+    json.field("dropped", (long)events->getDropped(i));
+    json.endObject();
   }
+  json.endArray();
+  json.endObject();
+  sendJson(json);
+}
 
-  html += R"(
-                </div>
-            </div>
-            
-            <div class="section">
-                <div class="section-title">Display Settings</div>
-                <div class="input-group">
-                    <label for="intensity">Display Intensity (0-15)</label>
-                    <input type="number" id="intensity" name="intensity" min="0" max="15" value=")";
-  html += String(settings->intensity);
-  html += R"(" required>
-                </div>
-                <div class="input-group">
-                    <label for="timeDisplayDuration">Time Display Duration (seconds, 1-60)</label>
-                    <input type="number" id="timeDisplayDuration" name="timeDisplayDuration" min="1" max="60" value=")";
-  html += String(settings->timeDisplayDuration);
-  html += R"(" required>
-                </div>
-            </div>
-            
-            <div class="section">
-                <div class="section-title">Debug Settings</div>
-                <div class="checkbox-item">
-                    <input type="checkbox" id="debug" name="debug")";
-  if (settings->debugEnabled) html += " checked";
-  html += R"(>
-                    <label for="debug">Enable Debug Logging</label>
-                </div>
-            </div>
-            
-            <div class="section">
-                <div class="section-title">Time Format</div>
-                <div class="radio-group">
-                    <div class="radio-item">
-                        <input type="radio" id="format24" name="format" value="24")";
-  if (!settings->use12Hour) html += " checked";
-  html += R"(>
-                        <label for="format24">24-Hour</label>
-                    </div>
-                    <div class="radio-item">
-                        <input type="radio" id="format12" name="format" value="12")";
-  if (settings->use12Hour) html += " checked";
-  html += R"(>
-                        <label for="format12">12-Hour (AM/PM)</label>
-                    </div>
-                </div>
-            </div>
-            
-            <button type="submit" class="btn btn-primary">💾 Save Settings</button>
-        </form>
-        
-        <form method="POST" action="/wifi">
-            <button type="submit" class="btn btn-secondary">📶 WiFi Configuration</button>
-        </form>
-    </div>
-</body>
-</html>
-)";
+void WebServerManager::writeSettings(JsonWriter& json) {
+  json.field("intensity", (long)settings->intensity);
+  json.field("timeDisplayDuration", (long)settings->timeDisplayDuration);
+  json.fieldBool("debug", settings->debugEnabled);
+  json.fieldBool("use12Hour", settings->use12Hour);
+  json.field("layout", settings->layout == LAYOUT_ZONED ? "zoned" : "rotate");
+  json.field("fleet", fleetRoleName(settings->fleetRole));
+}
 
-  return html;
+void WebServerManager::handleSettings() {
+  JsonWriter json(responseBuffer, sizeof(responseBuffer));
+  json.beginObject();
+  json.field("api", (long)API_VERSION);
+  writeSettings(json);
+  json.endObject();
+  sendJson(json);
 }
 
-void WebServerManager::handleRoot() {
-  server->send(200, "text/html", generateHTML());
+void WebServerManager::handleTimezones() {
+  time_t utc = ntpClock->now();
+  
+  JsonWriter json(responseBuffer, sizeof(responseBuffer));
+  json.beginObject();
+  json.field("api", (long)API_VERSION);
+  json.key("timezones");
+  json.beginArray();
+  // Listed in rotation order, which is how the page shows them
+  for (int slot = 0; slot < TZ_COUNT; slot++) {
+    int i = settings->order[slot];
+    json.beginObject();
+    json.field("id", (long)i);
+    json.field("name", tzManager->getTimezoneName(i));
+    json.field("offset", tzManager->getOffsetAt(i, utc));
+    json.fieldBool("enabled", settings->enabled[i]);
+    json.field("dwell", (long)settings->dwell[i]);
+    json.endObject();
+  }
+  json.endArray();
+  json.endObject();
+  sendJson(json);
 }
 
-void WebServerManager::handleSave() {
-  // Update timezone enabled states
-  for (int i = 0; i < TZ_COUNT; i++) {
-    tzManager->tzEnabled[i] = server->hasArg("tz" + String(i));
+void WebServerManager::handleEvents() {
+  if (!events->hasFreeSlot()) {
+    server->send(503, "text/plain", "Too many subscribers");
+    return;
   }
+  // Headers go out raw: the stream has no length and must not be chunked
+  server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server->sendContent_P(SSE_HEADERS);
+  events->subscribe(server->client());
+}
+
+#if METRICS_ENABLED
+// Longest single formatted metric, histogram bucket lines included
+static const size_t METRIC_LINE_MAX = 160;
+
+void WebServerManager::flushMetrics() {
+  if (metricsLength > 0) server->sendContent(responseBuffer, metricsLength);
+  metricsLength = 0;
+}
+
+void WebServerManager::appendMetric(PGM_P format, ...) {
+  if (metricsLength + METRIC_LINE_MAX > sizeof(responseBuffer)) flushMetrics();
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf_P(responseBuffer + metricsLength, sizeof(responseBuffer) - metricsLength, format, args);
+  va_end(args);
+  if (len <= 0) return;
+  size_t room = sizeof(responseBuffer) - metricsLength - 1;
+  metricsLength += (size_t)len < room ? (size_t)len : room;
+}
+
+void WebServerManager::appendHistogram(const char* name, const LatencyHistogram& histogram) {
+  appendMetric(PSTR("# TYPE %s histogram\n"), name);
+  uint32_t cumulative = 0;
+  for (uint8_t i = 0; i < METRICS_BUCKETS; i++) {
+    cumulative += histogram.buckets[i];
+    uint32_t bound = metricsBucketBound(i);
+    appendMetric(PSTR("%s_bucket{le=\"%lu.%06lu\"} %lu\n"), name,
+                 (unsigned long)(bound / 1000000), (unsigned long)(bound % 1000000), (unsigned long)cumulative);
+  }
+  appendMetric(PSTR("%s_bucket{le=\"+Inf\"} %lu\n"), name, (unsigned long)histogram.count);
+  appendMetric(PSTR("%s_sum %lu.%06lu\n%s_count %lu\n"), name,
+               (unsigned long)(histogram.sumMicros / 1000000), (unsigned long)(histogram.sumMicros % 1000000),
+               name, (unsigned long)histogram.count);
+}
+
+void WebServerManager::appendPushHistogram(const char* name, uint16_t bytesPerRow, uint64_t sum) {
+  // Bucket bounds are row counts times the bytes a row costs
+  const PushHistogram& histogram = metricsPushHistogram();
+  appendMetric(PSTR("# TYPE %s histogram\n"), name);
+  uint32_t cumulative = 0;
+  for (uint8_t rows = 0; rows <= MATRIX_ROWS; rows++) {
+    cumulative += histogram.rows[rows];
+    appendMetric(PSTR("%s_bucket{le=\"%u\"} %lu\n"), name, rows * bytesPerRow, (unsigned long)cumulative);
+  }
+  appendMetric(PSTR("%s_bucket{le=\"+Inf\"} %lu\n%s_sum %lu\n%s_count %lu\n"), name, (unsigned long)histogram.count,
+               name, (unsigned long)sum, name, (unsigned long)histogram.count);
+}
+
+void WebServerManager::appendSchedulerMetrics() {
+  appendMetric(PSTR("# TYPE clock_scheduler_wakeups_total counter\nclock_scheduler_wakeups_total %lu\n"), scheduler->getWakeups());
   
-  // Update intensity
-  if (server->hasArg("intensity")) {
-    settings->intensity = server->arg("intensity").toInt();
-    if (settings->intensity > 15) settings->intensity = 15;
-    if (settings->intensity < 0) settings->intensity = 0;
-    displayManager->setIntensity(settings->intensity);
+  // Lateness buckets are 0, 1, 2-3, ... 32-63 ms and 64+, so bucket n ends at 2^n - 1 ms
+  appendMetric(PSTR("# TYPE clock_scheduler_lateness_seconds histogram\n"));
+  for (uint8_t t = 0; t < TASK_COUNT; t++) {
+    TaskId task = (TaskId)t;
+    unsigned long cumulative = 0;
+    for (uint8_t bucket = 0; bucket < JITTER_BUCKETS - 1; bucket++) {
+      cumulative += scheduler->getJitterCount(task, bucket);
+      appendMetric(PSTR("clock_scheduler_lateness_seconds_bucket{task=\"%s\",le=\"0.%03u\"} %lu\n"),
+                   taskName(task), (1u << bucket) - 1, cumulative);
+    }
+    cumulative += scheduler->getJitterCount(task, JITTER_BUCKETS - 1);
+    unsigned long late = scheduler->getLateMillis(task);
+    appendMetric(PSTR("clock_scheduler_lateness_seconds_bucket{task=\"%s\",le=\"+Inf\"} %lu\n"), taskName(task), cumulative);
+    appendMetric(PSTR("clock_scheduler_lateness_seconds_sum{task=\"%s\"} %lu.%03lu\nclock_scheduler_lateness_seconds_count{task=\"%s\"} %lu\n"),
+                 taskName(task), late / 1000, late % 1000, taskName(task), cumulative);
   }
+}
+
+void WebServerManager::handleMetrics() {
+  // Prometheus text format, streamed in buffer-sized chunks
+  server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server->send(200, "text/plain; version=0.0.4", "");
+  metricsLength = 0;
   
-  // Update time format
-  settings->use12Hour = server->hasArg("format") && server->arg("format") == "12" ? 1 : 0;
+  appendMetric(PSTR("# TYPE clock_uptime_seconds counter\nclock_uptime_seconds %lu\n"), millis() / 1000);
+  unsigned long firstFrame = displayManager->getFrameBuffer().getFirstPushMillis();
+  appendMetric(PSTR("# TYPE clock_boot_first_frame_seconds gauge\nclock_boot_first_frame_seconds %lu.%03lu\n"), firstFrame / 1000, firstFrame % 1000);
+  appendMetric(PSTR("# TYPE clock_restored gauge\nclock_restored %d\n"), ntpClock->isRestored() ? 1 : 0);
   
-  // Update debug flag
-  settings->debugEnabled = server->hasArg("debug") ? 1 : 0;
+  appendMetric(PSTR("# TYPE clock_display_state_seconds_total counter\n"));
+  for (uint8_t i = 0; i < DISPLAY_STATE_COUNT; i++) {
+    uint64_t ms = metricsStateMillis((DisplayState)i);
+    appendMetric(PSTR("clock_display_state_seconds_total{state=\"%s\"} %lu.%03u\n"),
+                 displayStateName((DisplayState)i), (unsigned long)(ms / 1000), (unsigned)(ms % 1000));
+  }
+  
+  appendHistogram("clock_loop_duration_seconds", metricsLoopHistogram());
+  appendSchedulerMetrics();
+  appendHistogram("clock_http_handle_duration_seconds", metricsHttpHistogram());
+  appendHistogram("clock_animation_frame_lateness_seconds", metricsFrameHistogram());
+  
+  appendMetric(PSTR("# TYPE clock_animation_frames_total counter\nclock_animation_frames_total %lu\n"), displayManager->getAnimationFrames());
+  appendMetric(PSTR("# TYPE clock_animation_late_frames_total counter\nclock_animation_late_frames_total %lu\n"), displayManager->getLateFrames());
+  appendMetric(PSTR("# TYPE clock_animation_dropped_frames_total counter\nclock_animation_dropped_frames_total %lu\n"), displayManager->getDroppedFrames());
+  appendMetric(PSTR("# TYPE clock_animation_frame_max_seconds gauge\nclock_animation_frame_max_seconds %lu.%06lu\n"),
+               displayManager->getMaxFrameMicros() / 1000000, displayManager->getMaxFrameMicros() % 1000000);
+  appendMetric(PSTR("# TYPE clock_display_redraws_total counter\nclock_display_redraws_total %lu\n"), displayManager->getFrameBuffer().getChangedFrames());
+  appendMetric(PSTR("# TYPE clock_matrix_bytes_total counter\nclock_matrix_bytes_total %lu\n"), displayManager->getFrameBuffer().getTotalBytes());
+  appendPushHistogram("clock_matrix_push_rows", 1, metricsPushHistogram().rowSum);
+  appendPushHistogram("clock_matrix_push_bytes", MAX_DEVICES * 2, metricsPushHistogram().byteSum);
+  
+  appendMetric(PSTR("# TYPE clock_ntp_synced gauge\nclock_ntp_synced %d\n"), ntpClock->isSynced() ? 1 : 0);
+  appendMetric(PSTR("# TYPE clock_ntp_requests_total counter\nclock_ntp_requests_total %lu\n"), ntpClock->getRequestCount());
+  appendMetric(PSTR("# TYPE clock_ntp_syncs_total counter\nclock_ntp_syncs_total %lu\n"), ntpClock->getReplyCount());
+  appendMetric(PSTR("# TYPE clock_ntp_timeouts_total counter\nclock_ntp_timeouts_total %lu\n"), ntpClock->getTimeoutCount());
+  appendMetric(PSTR("# TYPE clock_ntp_steps_total counter\nclock_ntp_steps_total %lu\n"), ntpClock->getStepCount());
+  appendMetric(PSTR("# TYPE clock_ntp_round_trip_microseconds gauge\nclock_ntp_round_trip_microseconds %ld\n"), ntpClock->getLastDelay());
+  appendMetric(PSTR("# TYPE clock_ntp_offset_microseconds gauge\nclock_ntp_offset_microseconds %ld\n"), ntpClock->getLastOffset());
+  appendMetric(PSTR("# TYPE clock_ntp_drift_ppb gauge\nclock_ntp_drift_ppb %ld\n"), ntpClock->getDrift());
   
-  // Update time display duration
-  if (server->hasArg("timeDisplayDuration")) {
-    int duration = server->arg("timeDisplayDuration").toInt();
-    if (duration < 1) duration = 1;
-    if (duration > 60) duration = 60;
-    settings->timeDisplayDuration = duration;
-    displayManager->setTimeDisplayDuration(duration * 1000); // Convert to milliseconds
+  appendMetric(PSTR("# TYPE clock_fleet_following gauge\nclock_fleet_following %d\n"), fleet->isFollowing() ? 1 : 0);
+  appendMetric(PSTR("# TYPE clock_fleet_beacons_sent_total counter\nclock_fleet_beacons_sent_total %lu\n"), fleet->getSent());
+  appendMetric(PSTR("# TYPE clock_fleet_beacons_received_total counter\nclock_fleet_beacons_received_total %lu\n"), fleet->getReceived());
+  appendMetric(PSTR("# TYPE clock_fleet_leader_losses_total counter\nclock_fleet_leader_losses_total %lu\n"), fleet->getLeaderLosses());
+  appendMetric(PSTR("# TYPE clock_fleet_beacons_rejected_total counter\nclock_fleet_beacons_rejected_total %lu\n"), fleet->getRejected());
+  appendMetric(PSTR("# TYPE clock_fleet_beacons_late_total counter\nclock_fleet_beacons_late_total %lu\n"), fleet->getLate());
+  appendMetric(PSTR("# TYPE clock_fleet_offset_microseconds gauge\nclock_fleet_offset_microseconds %ld\n"), fleet->getLastOffset());
+  
+  appendMetric(PSTR("# TYPE clock_heap_free_bytes gauge\nclock_heap_free_bytes %lu\n"), (unsigned long)ESP.getFreeHeap());
+  appendMetric(PSTR("# TYPE clock_heap_max_block_bytes gauge\nclock_heap_max_block_bytes %lu\n"), (unsigned long)ESP.getMaxFreeBlockSize());
+  appendMetric(PSTR("# TYPE clock_heap_fragmentation_percent gauge\nclock_heap_fragmentation_percent %u\n"), ESP.getHeapFragmentation());
+  
+  appendMetric(PSTR("# TYPE clock_settings_records_total counter\nclock_settings_records_total %lu\n"), (unsigned long)settingsStore->getRecordCount());
+  appendMetric(PSTR("# TYPE clock_settings_flash_erases_total counter\nclock_settings_flash_erases_total %lu\n"), (unsigned long)settingsStore->getEraseCount());
+  
+  appendMetric(PSTR("# TYPE clock_events_published_total counter\nclock_events_published_total %lu\n"), (unsigned long)events->getPublished());
+  appendMetric(PSTR("# TYPE clock_events_dropped_total counter\n"));
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    if (!events->isSubscribed(i)) continue;
+    appendMetric(PSTR("clock_events_dropped_total{slot=\"%u\"} %lu\n"), i, (unsigned long)events->getDropped(i));
   }
   
-  // Save to EEPROM
-  settings->magic = EEPROM_MAGIC;
+  appendMetric(PSTR("# TYPE clock_log_records_total counter\nclock_log_records_total %lu\n"), (unsigned long)logGetRecorded());
+  appendMetric(PSTR("# TYPE clock_log_dropped_total counter\nclock_log_dropped_total %lu\n"), (unsigned long)logGetDropped());
+  
+  flushMetrics();
+  server->sendContent("");
+}
+#endif
+
+void WebServerManager::handleSave() {
+  SettingsForm form;
+  beginSettingsForm(form);
+  for (int i = 0; i < server->args(); i++) {
+    const String& name = server->argName(i);
+    const String& value = server->arg(i);
+    if (name == "plain") {
+      // The page posts the whole form as one text/plain body; decode it in
+      // the response buffer instead of having the server split it into Strings
+      if (value.length() >= sizeof(responseBuffer)) {
+        server->send(413, "text/plain", "Form too large");
+        return;
+      }
+      memcpy(responseBuffer, value.c_str(), value.length());
+      parseSettingsForm(form, responseBuffer, value.length());
+    } else {
+      // Regular form post, already split and decoded by the server
+      parseSettingsField(form, name.c_str(), name.length(), value.c_str(), value.length());
+    }
+  }
+  
+  // Only the saved copy is edited here; the display loop switches to it
+  // through the exchange once it is between rotation steps
   for (int i = 0; i < TZ_COUNT; i++) {
-    settings->enabled[i] = tzManager->tzEnabled[i] ? 1 : 0;
+    settings->enabled[i] = form.enabled[i];
+    settings->dwell[i] = form.dwell[i];
+  }
+  mergeRotationOrder(form, settings->order);
+  if (form.hasIntensity) {
+    settings->intensity = form.intensity;
+  }
+  settings->use12Hour = form.use12Hour;
+  settings->layout = form.layout;
+  settings->debugEnabled = form.debugEnabled;
+  settings->fleetRole = form.fleetRole;
+  if (form.hasDuration) {
+    settings->timeDisplayDuration = form.timeDisplayDuration;
   }
-  EEPROM.put(0, *settings);
-  EEPROM.commit();
+  
+  if (form.rejected > 0) {
+    logEvent(LOG_FORM_REJECTED, form.rejected);
+  }
+  
+  // Save to flash; only fields that changed are written
+  if (!settingsStore->save(*settings)) {
+    logEvent(LOG_STORE_SAVE_FAILED, settingsStore->getFailedSaves());
+  }
+  settingsExchange->publish(*settings);
+  
+  // Tell live subscribers; the payload matches /api/settings
+  char data[SSE_EVENT_SIZE];
+  JsonWriter json(data, sizeof(data));
+  json.beginObject();
+  writeSettings(json);
+  json.endObject();
+  if (!json.overflowed()) events->publish("settings", data);
   
   // Send response immediately to prevent hanging
   server->sendHeader("Location", "/");
@@ -399,15 +398,22 @@ void WebServerManager::handleSave() {
   server->client().stop(); // Close connection immediately
 }
 
+void WebServerManager::handleLog() {
+  // Raw ring contents; tools/decode_log.py turns them back into text
+  size_t length = logDump(responseBuffer, sizeof(responseBuffer));
+  server->sendHeader("Cache-Control", "no-cache");
+  server->send(200, "application/octet-stream", responseBuffer, length);
+}
+
 void WebServerManager::handleWifiPortal() {
   // Send response first to prevent hanging
-  server->send(200, "text/html", "<html><body><h1>WiFi Configuration Portal Starting...</h1><p>Please connect to the 'ESP8266-Config' network and configure WiFi.</p><p>This page will close automatically.</p><script>setTimeout(function(){window.location.href='/';}, 3000);</script></body></html>");
+  char page[PORTAL_PAGE_SIZE];
+  snprintf_P(page, sizeof(page), HTML_WIFI_PORTAL, WIFI_CONFIG_AP_NAME, WIFI_CONFIG_PORTAL_PORT);
+  server->send(200, "text/html", page);
   server->client().stop(); // Close connection immediately
   
-  // Start WiFi portal in a non-blocking way
-  // Note: This will still block, but at least we've sent the response
-  WiFiManager wm;
-  wm.setConfigPortalTimeout(180);
-  wm.startConfigPortal("ESP8266-Config");
+  // The portal runs from loop() next to this server and the display. The
+  // WiFi task was idling at WIFI_IDLE_POLL_INTERVAL; serve the portal now.
+  wifiPortal->startPortal(WIFI_CONFIG_AP_NAME, WIFI_CONFIG_PORTAL_PORT);
+  scheduler->setDeadline(TASK_WIFI, millis());
 }
-
@@ -5,23 +5,71 @@
 #include "config.h"
 #include "timezone.h"
 #include "display.h"
+#include "wifiportal.h"
+#include "ntpclock.h"
+#include "fleetsync.h"
+#include "scheduler.h"
+#include "jsonwriter.h"
+#include "eventstream.h"
+#include "settingsstore.h"
+#include "settingsexchange.h"
+#include "metrics.h"
+
+// Bumped when a field in the /api responses changes meaning
+#define API_VERSION 1
+
+// Longest /api/timezones entry and the wrapper around the list: ids and
+// dwell are bytes, offsets stay within +-14 h, labels are plain ASCII
+const size_t TZ_JSON_ENTRY_MAX = sizeof("{\"id\":255,\"name\":\"\",\"offset\":-50400,\"enabled\":false,\"dwell\":255},") - 1 + TZDB_LABEL_SIZE - 1;
+const size_t TZ_JSON_MAX = sizeof("{\"api\":65535,\"timezones\":[]}") + TZ_COUNT * TZ_JSON_ENTRY_MAX;
+
+// Largest JSON response (/api/timezones with every zone listed), also the
+// /log dump, the decoded settings form and the batch size /metrics is
+// streamed in. Grows with the zone catalog.
+const size_t RESPONSE_BUFFER_SIZE = TZ_JSON_MAX > 1536 ? TZ_JSON_MAX : 1536;
 
 class WebServerManager {
 public:
-  WebServerManager(ESP8266WebServer* srv, TimezoneManager* tzm, Settings* sett, DisplayManager* disp);
+  WebServerManager(ESP8266WebServer* srv, TimezoneManager* tzm, Settings* sett, SettingsStore* store, SettingsExchange* exchange, DisplayManager* disp, WifiPortal* portal, NtpClock* clock, FleetSync* fleetSync, EventStream* evts, Scheduler* sched);
   void begin();
-  void handleClient();
+  bool handleClient();  // True if a request was served
   
 private:
+  void on(const char* uri, HTTPMethod method, void (WebServerManager::*handler)());
   void handleRoot();
   void handleSave();
   void handleWifiPortal();
-  String generateHTML();
+  void handleState();
+  void handleSettings();
+  void handleTimezones();
+  void handleEvents();
+  void handleLog();
+  void writeSettings(JsonWriter& json);
+#if METRICS_ENABLED
+  void handleMetrics();
+  void appendMetric(PGM_P format, ...);
+  void appendHistogram(const char* name, const LatencyHistogram& histogram);
+  void appendPushHistogram(const char* name, uint16_t bytesPerRow, uint64_t sum);
+  void appendSchedulerMetrics();
+  void flushMetrics();
+#endif
+  bool notModified(const char* etag);
+  void sendJson(JsonWriter& json);
   
   ESP8266WebServer* server;
   TimezoneManager* tzManager;
   Settings* settings;
+  SettingsStore* settingsStore;
+  SettingsExchange* settingsExchange;
   DisplayManager* displayManager;
+  WifiPortal* wifiPortal;
+  NtpClock* ntpClock;
+  FleetSync* fleet;
+  EventStream* events;
+  Scheduler* scheduler;
+  char responseBuffer[RESPONSE_BUFFER_SIZE];
+  size_t metricsLength;
+  unsigned long requests;
 };
 
 #endif
@@ -0,0 +1,55 @@
+#include "wifiportal.h"
+#include <ESP8266WiFi.h>
+
+WifiPortal::WifiPortal() :
+  state(WIFI_CONNECTING),
+  connectStart(0) {
+}
+
+void WifiPortal::begin() {
+  // Join the saved network in the background; the portal only comes up
+  // if that hasn't worked within WIFI_CONNECT_TIMEOUT
+  WiFi.mode(WIFI_STA);
+  WiFi.begin();
+  wm.setConfigPortalBlocking(false);
+  wm.setConfigPortalTimeout(WIFI_PORTAL_TIMEOUT);
+  connectStart = millis();
+  state = WIFI_CONNECTING;
+}
+
+bool WifiPortal::isConnected() {
+  return WiFi.status() == WL_CONNECTED;
+}
+
+void WifiPortal::startPortal(const char* apName, uint16_t port) {
+  if (state == WIFI_PORTAL) return;
+  wm.setHttpPort(port);
+  wm.startConfigPortal(apName);
+  state = WIFI_PORTAL;
+}
+
+void WifiPortal::process() {
+  switch (state) {
+    case WIFI_CONNECTING:
+      if (isConnected()) {
+        state = WIFI_CONNECTED;
+      } else if (millis() - connectStart >= WIFI_CONNECT_TIMEOUT) {
+        // No usable saved network: captive portal on the standard port
+        startPortal(WIFI_SETUP_AP_NAME, 80);
+      }
+      break;
+      
+    case WIFI_CONNECTED:
+      break;
+      
+    case WIFI_PORTAL:
+      // Serves one step of the portal's DNS and HTTP servers
+      wm.process();
+      if (!wm.getConfigPortalActive()) {
+        // Saved new credentials or timed out; either way try to (re)join
+        state = isConnected() ? WIFI_CONNECTED : WIFI_CONNECTING;
+        connectStart = millis();
+      }
+      break;
+  }
+}
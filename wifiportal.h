@@ -0,0 +1,34 @@
+#ifndef WIFIPORTAL_H
+#define WIFIPORTAL_H
+
+#include <Arduino.h>
+#include <WiFiManager.h>
+#include "config.h"
+
+enum WifiState {
+  WIFI_CONNECTING,  // Joining the saved network
+  WIFI_CONNECTED,
+  WIFI_PORTAL       // Configuration portal is up
+};
+
+// Runs the WiFi connection and WiFiManager's configuration portal without
+// blocking: process() is called from loop() next to the display and the
+// web server instead of the firmware parking inside autoConnect() or
+// startConfigPortal().
+class WifiPortal {
+public:
+  WifiPortal();
+  void begin();
+  void process();
+  void startPortal(const char* apName, uint16_t port);
+  WifiState getState() { return state; }
+  bool isConnected();
+  bool isPortalActive() { return state == WIFI_PORTAL; }
+  
+private:
+  WiFiManager wm;
+  WifiState state;
+  unsigned long connectStart;
+};
+
+#endif